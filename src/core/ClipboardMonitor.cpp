@@ -11,6 +11,8 @@
 #include <QCryptographicHash>
 #include <QTimer>
 #include <QSettings>
+#include <QImageWriter>
+#include "ImageHashHelper.h"
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -25,9 +27,72 @@ ClipboardMonitor& ClipboardMonitor::instance() {
 ClipboardMonitor::ClipboardMonitor(QObject* parent) : QObject(parent) {
     connect(QGuiApplication::clipboard(), &QClipboard::dataChanged, this, &ClipboardMonitor::onClipboardChanged);
     reloadBlacklist();
+    m_encodePool.setMaxThreadCount(1);
     // qDebug() << "[ClipboardMonitor] 初始化完成，开始监听...";
 }
 
+ClipboardMonitor::~ClipboardMonitor() {
+    m_encodePool.waitForDone();
+}
+
+QByteArray ClipboardMonitor::encodeImage(const QImage& image, QString* format) {
+    // [PERF] 超过约 100 万像素的图片：有 WebP 插件时用无损 WebP (体积通常只有 PNG 的 2/3)，
+    // 否则 PNG 改用 zlib 级别 1 (quality 80)，编码耗时约为默认级别的 1/3，体积仅略增
+    static const bool s_hasWebp = QImageWriter::supportedImageFormats().contains("webp");
+    const bool large = qint64(image.width()) * image.height() > 1000 * 1000;
+    const QByteArray fmt = (large && s_hasWebp) ? QByteArray("webp") : QByteArray("png");
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, fmt);
+    if (fmt == "webp") writer.setQuality(100); // quality >= 100 即无损
+    else if (large) writer.setQuality(80);
+    if (!writer.write(image)) {
+        qDebug() << "[ClipboardMonitor] 图片编码失败:" << fmt << writer.errorString();
+        return QByteArray();
+    }
+    if (format) *format = QString::fromLatin1(fmt);
+    return data;
+}
+
+void ClipboardMonitor::processImageAsync(const QImage& image, const QString& type, const QString& sourceApp, const QString& sourceTitle) {
+    const QString lastHash = m_lastHash;
+    m_encodePool.start([=, this]() {
+        QElapsedTimer clock;
+        clock.start();
+
+        // 如果图片超过 20MB (约 5000x4000 32bpp)，则进行降采样处理，防止 OOM
+        QImage img = image;
+        qint64 estimatedSize = qint64(img.width()) * img.height() * 4;
+        if (estimatedSize > 20 * 1024 * 1024) {
+            img = img.scaled(2560, 2560, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        // [PERF] 先对原始像素求哈希：重复复制同一张图时直接跳过编码
+        const QString pixelHash = ImageHashHelper::pixelHash(img);
+        if (pixelHash == lastHash) {
+            qDebug() << "[ClipboardMonitor DIAG] 像素哈希去重命中，跳过编码 | 工作线程耗时 =" << clock.elapsed() << "ms";
+            return;
+        }
+
+        QString format;
+        const QByteArray dataBlob = encodeImage(img, &format);
+        if (dataBlob.isEmpty()) return;
+        qDebug() << "[ClipboardMonitor DIAG] 图片编码完成 | 格式 =" << format << "| 大小 =" << dataBlob.size()
+                 << "| 工作线程耗时 =" << clock.elapsed() << "ms";
+
+        QMetaObject::invokeMethod(this, [=, this]() {
+            // 回到主线程再比对一次：两次连续复制可能在前一张完成前就已派发
+            if (pixelHash == m_lastHash) return;
+            m_lastHash = pixelHash;
+            emit newContentDetected("[截图]", type, dataBlob, sourceApp, sourceTitle, pixelHash);
+            emit clipboardChanged();
+            qDebug() << "[ClipboardMonitor] 捕获新图片 (来自:" << sourceApp << "):" << type;
+        }, Qt::QueuedConnection);
+    });
+}
+
 void ClipboardMonitor::reloadBlacklist() {
     QSettings blacklistSettings("RapidNotes", "Security");
     QStringList rawList = blacklistSettings.value("avoidanceBlacklist").toStringList();
@@ -153,7 +218,6 @@ void ClipboardMonitor::onClipboardChanged() {
 
     QString type;
     QString content;
-    QByteArray dataBlob;
 
     // 优先级 1: 本地文件
     if (mimeData->hasUrls()) {
@@ -170,22 +234,13 @@ void ClipboardMonitor::onClipboardChanged() {
     }
 
     // 优先级 2: 截图 (仅当不是文件时)
+    // [PERF] 主线程只取出 QImage，降采样、哈希与编码全部交给工作线程
+    QImage image;
     if (type.isEmpty() && mimeData->hasImage()) {
-        // [OPTIMIZATION] 剪贴板大图捕获保护：
-        // 在进行昂贵的 PNG 编码前，先通过 imageData 变体尝试预判尺寸
-        QImage img = qvariant_cast<QImage>(mimeData->imageData());
-        if (!img.isNull()) {
-            // 如果图片超过 20MB (约 5000x4000 32bpp)，则进行降采样处理，防止主线程卡死和 OOM
-            qint64 estimatedSize = img.width() * img.height() * 4;
-            if (estimatedSize > 20 * 1024 * 1024) {
-                img = img.scaled(2560, 2560, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            }
-
+        image = qvariant_cast<QImage>(mimeData->imageData());
+        if (!image.isNull()) {
             type = "image";
             content = "[截图]";
-            QBuffer buffer(&dataBlob);
-            buffer.open(QIODevice::WriteOnly);
-            img.save(&buffer, "PNG");
         }
     }
 
@@ -208,9 +263,14 @@ void ClipboardMonitor::onClipboardChanged() {
         type = forcedType;
     }
 
+    if (!image.isNull()) {
+        qDebug() << "[ClipboardMonitor DIAG] 图片已派发至编码线程 | onClipboardChanged 耗时 =" << diagClock.elapsed() << "ms";
+        processImageAsync(image, type, sourceApp, sourceTitle);
+        return;
+    }
+
     // SHA256 去重
-    QByteArray hashData = dataBlob.isEmpty() ? content.toUtf8() : dataBlob;
-    QString currentHash = QCryptographicHash::hash(hashData, QCryptographicHash::Sha256).toHex();
+    QString currentHash = QCryptographicHash::hash(content.toUtf8(), QCryptographicHash::Sha256).toHex();
     
     if (currentHash == m_lastHash) {
         qDebug() << "[ClipboardMonitor DIAG] SHA256 去重命中，跳过 | 本次 onClipboardChanged 耗时 =" << diagClock.elapsed() << "ms";
@@ -222,7 +282,7 @@ void ClipboardMonitor::onClipboardChanged() {
     // 按照用户需求，必须【绝对优先】执行 ToolTipOverlay
     // 因此这里先发射 newContentDetected (它连接到 ToolTip 显示)
     qDebug() << "[ClipboardMonitor DIAG] 信号发射前 | onClipboardChanged 总耗时 =" << diagClock.elapsed() << "ms | type =" << type;
-    emit newContentDetected(content, type, dataBlob, sourceApp, sourceTitle);
+    emit newContentDetected(content, type, QByteArray(), sourceApp, sourceTitle, currentHash);
 
     // 然后再发射 clipboardChanged (它连接到烟花特效等其他非核心反馈)
     // 只有当内容确实发生变化（非重复，非程序内部回环）时，才允许触发
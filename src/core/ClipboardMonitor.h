@@ -5,7 +5,9 @@
 #include <QClipboard>
 #include <QGuiApplication>
 #include <QCryptographicHash>
+#include <QImage>
 #include <QStringList>
+#include <QThreadPool>
 
 class ClipboardMonitor : public QObject {
     Q_OBJECT
@@ -18,12 +20,16 @@ public:
     void forceNext(const QString& type = "") { m_forceNext = true; m_forcedType = type; }
     void clearLastHash() { m_lastHash = ""; }
 
+    // 按图片尺寸与可用编码器选择格式：大图优先无损 WebP，否则 PNG (大图使用快速压缩级别)
+    static QByteArray encodeImage(const QImage& image, QString* format = nullptr);
+
     // [NEW] 黑名单热加载
     void reloadBlacklist();
 
 signals:
     void newContentDetected(const QString& content, const QString& type, const QByteArray& data = QByteArray(),
-                            const QString& sourceApp = "", const QString& sourceTitle = "");
+                            const QString& sourceApp = "", const QString& sourceTitle = "",
+                            const QString& contentHash = "");
     void clipboardChanged();
 
 private slots:
@@ -31,6 +37,10 @@ private slots:
 
 private:
     ClipboardMonitor(QObject* parent = nullptr);
+    ~ClipboardMonitor();
+    // 图片的降采样、像素哈希与编码在工作线程执行，完成后回到主线程去重并发射信号
+    void processImageAsync(const QImage& image, const QString& type, const QString& sourceApp, const QString& sourceTitle);
+
     QString m_lastHash;
     bool m_skipNext = false;
     bool m_ignore = false;
@@ -40,6 +50,9 @@ private:
 
     // [NEW] 黑名单缓存，避免高频 I/O
     QStringList m_blacklistCache;
+
+    // [PERF] 单线程编码池：保证连续复制的多张图片按顺序入库
+    QThreadPool m_encodePool;
 };
 
 #endif // CLIPBOARDMONITOR_H
\ No newline at end of file
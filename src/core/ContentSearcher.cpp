@@ -0,0 +1,530 @@
+#include "ContentSearcher.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QStringConverter>
+#include <QThread>
+#include <cstring>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// SearchFileFilter 实现
+// ----------------------------------------------------------------------------
+SearchFileFilter::SearchFileFilter(const QString& wildcards, const QStringList& ignoreDirs)
+    : m_ignoreDirs(ignoreDirs) {
+    const QStringList parts = wildcards.split(QRegularExpression("[,\\s;]+"), Qt::SkipEmptyParts);
+    for (const QString& f : parts) {
+        QRegularExpression re(QRegularExpression::wildcardToRegularExpression(f));
+        re.optimize();
+        m_patterns << re;
+    }
+}
+
+bool SearchFileFilter::acceptsFileName(const QString& fileName) const {
+    if (m_patterns.isEmpty()) return true;
+    for (const auto& re : m_patterns) {
+        if (re.match(fileName).hasMatch()) return true;
+    }
+    return false;
+}
+
+void SearchFileFilter::forEachFile(const QString& root, const std::function<bool(const QString&)>& callback) const {
+    QStringList stack = {root};
+    while (!stack.isEmpty()) {
+        const QString dirPath = stack.takeLast();
+        QDirIterator it(dirPath, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo fi = it.fileInfo();
+            if (fi.isDir()) {
+                // 与 QDirIterator::Subdirectories 默认行为一致：不跟随目录链接
+                if (!fi.isSymLink() && acceptsDirName(fi.fileName())) stack << fi.filePath();
+                continue;
+            }
+            if (!acceptsFileName(fi.fileName())) continue;
+            if (!callback(fi.filePath())) return;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// ByteSearcher 实现
+// ----------------------------------------------------------------------------
+namespace {
+inline uchar foldAscii(uchar c) {
+    return (c >= 'A' && c <= 'Z') ? uchar(c + 32) : c;
+}
+
+// 粗略的字节出现频率排名 (越大越常见)，用于挑选 memchr 的跳跃字节
+int byteRank(uchar c) {
+    if (c == ' ' || c == '\n' || c == '\t' || c == '\r') return 255;
+    if (c >= 'a' && c <= 'z') return 200;
+    if (c == '_' || c == '.' || c == ',' || c == ';' || c == '(' || c == ')' || c == '=' || c == '"' || c == '/') return 180;
+    if (c >= 0x80 && c <= 0xBF) return 170; // UTF-8 续字节
+    if (c >= 0xE4 && c <= 0xE9) return 160; // 常用 CJK 的 UTF-8 首字节
+    if (c >= '0' && c <= '9') return 150;
+    if (c >= 'A' && c <= 'Z') return 120;
+    if (c < 0x80) return 100;
+    return 60;
+}
+}
+
+ByteSearcher::ByteSearcher(const QByteArray& needle, bool caseSensitive)
+    : m_needle(needle), m_caseSensitive(caseSensitive) {
+    const int n = m_needle.size();
+    if (n == 0) return;
+
+    if (m_caseSensitive) {
+        int best = 256;
+        for (int i = 0; i < n; ++i) {
+            int rank = byteRank(uchar(m_needle[i]));
+            if (rank < best) { best = rank; m_rareOffset = i; }
+        }
+    } else {
+        for (int i = 0; i < n; ++i) m_needle[i] = char(foldAscii(uchar(m_needle[i])));
+        m_skip.fill(n);
+        for (int i = 0; i < n - 1; ++i) {
+            const uchar c = uchar(m_needle[i]);
+            m_skip[c] = n - 1 - i;
+            if (c >= 'a' && c <= 'z') m_skip[c - 32] = n - 1 - i;
+        }
+    }
+}
+
+qsizetype ByteSearcher::indexIn(const char* data, qsizetype size, qsizetype from) const {
+    if (m_needle.isEmpty() || size - from < m_needle.size()) return -1;
+    return m_caseSensitive ? indexMemchr(data, size, from) : indexHorspool(data, size, from);
+}
+
+qsizetype ByteSearcher::indexMemchr(const char* data, qsizetype size, qsizetype from) const {
+    const qsizetype n = m_needle.size();
+    const char rare = m_needle[m_rareOffset];
+    const char* needle = m_needle.constData();
+    const char* p = data + from + m_rareOffset;
+    const char* limit = data + size - (n - m_rareOffset) + 1; // rare 字节可出现的最后位置之后
+    while (p < limit) {
+        const void* hit = std::memchr(p, rare, size_t(limit - p));
+        if (!hit) return -1;
+        const char* start = static_cast<const char*>(hit) - m_rareOffset;
+        if (std::memcmp(start, needle, size_t(n)) == 0) return start - data;
+        p = static_cast<const char*>(hit) + 1;
+    }
+    return -1;
+}
+
+qsizetype ByteSearcher::indexHorspool(const char* data, qsizetype size, qsizetype from) const {
+    const qsizetype n = m_needle.size();
+    const uchar* text = reinterpret_cast<const uchar*>(data);
+    const uchar* needle = reinterpret_cast<const uchar*>(m_needle.constData());
+    const uchar last = needle[n - 1];
+    qsizetype pos = from;
+    while (pos + n <= size) {
+        const uchar tail = text[pos + n - 1];
+        if (foldAscii(tail) == last) {
+            qsizetype i = n - 2;
+            while (i >= 0 && foldAscii(text[pos + i]) == needle[i]) --i;
+            if (i < 0) return pos;
+        }
+        pos += m_skip[tail];
+    }
+    return -1;
+}
+
+int ByteSearcher::countIn(const char* data, qsizetype size) const {
+    int count = 0;
+    qsizetype pos = indexIn(data, size, 0);
+    while (pos >= 0) {
+        ++count;
+        pos = indexIn(data, size, pos + 1);
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// 编码探测与行级扫描辅助
+// ----------------------------------------------------------------------------
+namespace {
+constexpr int kContextLines = 2;              // 命中行上下各带的上下文行数
+constexpr int kMaxMatchesPerFile = 200;       // 单文件最多回传的行级结果，计数仍为全部
+constexpr int kSnippetChars = 240;            // 结果中单行最多保留的字符数
+constexpr qsizetype kMaxLineBytes = 64 * 1024; // 超长行 (压缩脚本等) 只解码命中窗口
+constexpr qsizetype kWindowBytes = 256;       // 超长行命中窗口的前后字节数
+constexpr qsizetype kContextBytes = 1024;     // 上下文行最多解码的字节数
+constexpr qsizetype kSniffBytes = 64 * 1024;  // UTF-8 合法性采样长度
+
+bool isValidUtf8(const uchar* p, qsizetype size) {
+    qsizetype i = 0;
+    while (i < size) {
+        const uchar c = p[i];
+        if (c < 0x80) { ++i; continue; }
+        int extra;
+        if (c >= 0xC2 && c <= 0xDF) extra = 1;
+        else if (c >= 0xE0 && c <= 0xEF) extra = 2;
+        else if (c >= 0xF0 && c <= 0xF4) extra = 3;
+        else return false;
+        if (i + extra >= size) return true; // 采样恰好截断在多字节字符中间
+        for (int k = 1; k <= extra; ++k) {
+            if ((p[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += extra + 1;
+    }
+    return true;
+}
+
+// 按编码划分的只读文本视图：负责 UTF-16 对齐、行首/行尾定位与换行计数
+struct TextView {
+    const char* data;
+    qsizetype begin; // 跳过 BOM 后的起点
+    qsizetype size;
+    int unit;        // 码元字节数：1 或 2
+    bool bigEndian;
+
+    bool isNewline(qsizetype pos) const {
+        if (unit == 1) return data[pos] == '\n';
+        const uchar lo = uchar(data[pos + (bigEndian ? 1 : 0)]);
+        const uchar hi = uchar(data[pos + (bigEndian ? 0 : 1)]);
+        return lo == '\n' && hi == 0;
+    }
+    qsizetype align(qsizetype pos) const {
+        return unit == 1 ? pos : begin + ((pos - begin) & ~qsizetype(1));
+    }
+    qsizetype lineStart(qsizetype pos) const {
+        pos = align(pos);
+        while (pos > begin && !isNewline(pos - unit)) pos -= unit;
+        return pos;
+    }
+    // 返回换行符所在位置，无换行时返回文件末尾
+    qsizetype lineEnd(qsizetype pos) const {
+        pos = align(pos);
+        if (unit == 1) {
+            const void* nl = std::memchr(data + pos, '\n', size_t(size - pos));
+            return nl ? static_cast<const char*>(nl) - data : size;
+        }
+        while (pos + unit <= size && !isNewline(pos)) pos += unit;
+        return qMin(pos, size);
+    }
+    qsizetype nextLine(qsizetype end) const { return qMin(size, end + unit); }
+    int countNewlines(qsizetype from, qsizetype to) const {
+        int n = 0;
+        if (unit == 1) {
+            const char* p = data + from;
+            const char* e = data + to;
+            while (p < e) {
+                const void* nl = std::memchr(p, '\n', size_t(e - p));
+                if (!nl) break;
+                ++n;
+                p = static_cast<const char*>(nl) + 1;
+            }
+            return n;
+        }
+        for (qsizetype pos = align(from); pos + unit <= to; pos += unit) {
+            if (isNewline(pos)) ++n;
+        }
+        return n;
+    }
+};
+
+class LineDecoder {
+public:
+    explicit LineDecoder(TextEncoding encoding)
+        : m_encoding(encoding), m_decoder(ContentSearcher::decoderFor(encoding)) {}
+    QString decode(const char* p, qsizetype len) {
+        if (m_encoding == TextEncoding::Utf8) return QString::fromUtf8(p, len);
+        m_decoder.resetState();
+        QString s = m_decoder.decode(QByteArrayView(p, len));
+        return s;
+    }
+private:
+    TextEncoding m_encoding;
+    QStringDecoder m_decoder;
+};
+
+QString clipLine(QString line, qsizetype column = 0) {
+    if (line.endsWith('\r')) line.chop(1);
+    if (line.size() <= kSnippetChars) return line;
+    const qsizetype start = qMax<qsizetype>(0, column - kSnippetChars / 3);
+    return (start > 0 ? QStringLiteral("…") : QString()) + line.mid(start, kSnippetChars) + QStringLiteral("…");
+}
+}
+
+TextEncoding ContentSearcher::detectEncoding(const char* data, qsizetype size, int* bomLength) {
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    if (bomLength) *bomLength = 0;
+    if (size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF) {
+        if (bomLength) *bomLength = 3;
+        return TextEncoding::Utf8;
+    }
+    if (size >= 2 && p[0] == 0xFF && p[1] == 0xFE) {
+        if (bomLength) *bomLength = 2;
+        return TextEncoding::Utf16LE;
+    }
+    if (size >= 2 && p[0] == 0xFE && p[1] == 0xFF) {
+        if (bomLength) *bomLength = 2;
+        return TextEncoding::Utf16BE;
+    }
+
+    const qsizetype head = qMin<qsizetype>(size, 1024);
+    if (std::memchr(data, 0, size_t(head))) {
+        // 无 BOM 的 UTF-16：ASCII 字符的零字节集中在奇数位 (LE) 或偶数位 (BE)
+        qsizetype evenZeros = 0, oddZeros = 0;
+        for (qsizetype i = 0; i < head; ++i) {
+            if (p[i] == 0) ((i & 1) ? oddZeros : evenZeros)++;
+        }
+        const qsizetype units = head / 2;
+        if (oddZeros * 10 >= units * 3 && evenZeros * 20 < units) return TextEncoding::Utf16LE;
+        if (evenZeros * 10 >= units * 3 && oddZeros * 20 < units) return TextEncoding::Utf16BE;
+        return TextEncoding::Binary;
+    }
+
+    return isValidUtf8(p, qMin(size, kSniffBytes)) ? TextEncoding::Utf8 : TextEncoding::Gb18030;
+}
+
+QString ContentSearcher::encodingName(TextEncoding encoding) {
+    switch (encoding) {
+        case TextEncoding::Utf8: return "UTF-8";
+        case TextEncoding::Utf16LE: return "UTF-16LE";
+        case TextEncoding::Utf16BE: return "UTF-16BE";
+        case TextEncoding::Gb18030: return "GBK";
+        default: return "Binary";
+    }
+}
+
+QStringDecoder ContentSearcher::decoderFor(TextEncoding encoding) {
+    switch (encoding) {
+        case TextEncoding::Utf16LE: return QStringDecoder(QStringConverter::Utf16LE);
+        case TextEncoding::Utf16BE: return QStringDecoder(QStringConverter::Utf16BE);
+        case TextEncoding::Gb18030: {
+            QStringDecoder decoder("GB18030");
+            if (!decoder.isValid()) decoder = QStringDecoder(QStringConverter::System);
+            return decoder;
+        }
+        default: return QStringDecoder(QStringConverter::Utf8);
+    }
+}
+
+QStringEncoder ContentSearcher::encoderFor(TextEncoding encoding) {
+    switch (encoding) {
+        case TextEncoding::Utf16LE: return QStringEncoder(QStringConverter::Utf16LE);
+        case TextEncoding::Utf16BE: return QStringEncoder(QStringConverter::Utf16BE);
+        case TextEncoding::Gb18030: {
+            QStringEncoder encoder("GB18030");
+            if (!encoder.isValid()) encoder = QStringEncoder(QStringConverter::System);
+            return encoder;
+        }
+        default: return QStringEncoder(QStringConverter::Utf8);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// ContentSearcher 实现
+// ----------------------------------------------------------------------------
+struct ContentSearcher::RunState {
+    Options options;
+    SearchFileFilter filter;
+    // 按编码预先转换的关键字字节查找器，下标为 TextEncoding；为空表示该编码需逐行解码比较
+    std::array<ByteSearcher, 5> matchers;
+    bool decodeFallback = false; // 关键字含非 ASCII 的大小写字母且不区分大小写时，需解码后比较
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> pending{1};   // 初始 1 代表遍历任务本身
+    std::atomic<int> scanned{0};
+    std::atomic<int> found{0};
+};
+
+ContentSearcher::ContentSearcher(QObject* parent) : QObject(parent) {
+    // 额外 1 个线程留给目录遍历任务
+    m_pool.setMaxThreadCount(QThread::idealThreadCount() + 1);
+}
+
+ContentSearcher::~ContentSearcher() {
+    cancel();
+    m_pool.waitForDone();
+}
+
+void ContentSearcher::cancel() {
+    if (m_state) {
+        m_state->cancelled = true;
+        m_state.reset();
+    }
+}
+
+void ContentSearcher::start(const Options& options) {
+    cancel();
+
+    auto state = std::make_shared<RunState>();
+    state->options = options;
+    state->filter = SearchFileFilter(options.filter, options.ignoreDirs);
+    if (!options.caseSensitive) {
+        for (QChar ch : options.keyword) {
+            if (ch.unicode() >= 0x80 && ch.toLower() != ch.toUpper()) {
+                state->decodeFallback = true;
+                break;
+            }
+        }
+    }
+    if (!state->decodeFallback) {
+        const QString& kw = options.keyword;
+        const bool cs = options.caseSensitive;
+        state->matchers[int(TextEncoding::Utf8)] = ByteSearcher(kw.toUtf8(), cs);
+        QStringEncoder le(QStringConverter::Utf16LE);
+        state->matchers[int(TextEncoding::Utf16LE)] = ByteSearcher(le.encode(kw), cs);
+        QStringEncoder be(QStringConverter::Utf16BE);
+        state->matchers[int(TextEncoding::Utf16BE)] = ByteSearcher(be.encode(kw), cs);
+        QStringEncoder gb = encoderFor(TextEncoding::Gb18030);
+        QByteArray gbNeedle = gb.encode(kw);
+        if (!gb.hasError()) state->matchers[int(TextEncoding::Gb18030)] = ByteSearcher(gbNeedle, cs);
+    }
+    m_state = state;
+
+    m_pool.start([this, state]() {
+        state->filter.forEachFile(state->options.rootDir, [this, state](const QString& filePath) {
+            if (state->cancelled) return false;
+            ++state->pending;
+            m_pool.start([this, state, filePath]() { searchFile(state, filePath); });
+            return true;
+        });
+        finishTask(state);
+    });
+}
+
+void ContentSearcher::searchFile(const std::shared_ptr<RunState>& state, const QString& filePath) {
+    if (state->cancelled) {
+        finishTask(state);
+        return;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        finishTask(state);
+        return;
+    }
+
+    // [PERF] 通过内存映射按需换页，进程内只保留命中行与上下文，不持有整份解码后的文本
+    const qint64 size = file.size();
+    QByteArray buffer;
+    const char* data = nullptr;
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (mapped) {
+        data = reinterpret_cast<const char*>(mapped);
+    } else if (size > 0) {
+        buffer = file.readAll();
+        data = buffer.constData();
+    }
+
+    int bom = 0;
+    const TextEncoding encoding = size > 0 ? detectEncoding(data, size, &bom) : TextEncoding::Utf8;
+    if (encoding == TextEncoding::Binary) {
+        if (mapped) file.unmap(mapped);
+        finishTask(state);
+        return;
+    }
+    ++state->scanned;
+
+    const bool utf16 = encoding == TextEncoding::Utf16LE || encoding == TextEncoding::Utf16BE;
+    const TextView view{data, bom, size, utf16 ? 2 : 1, encoding == TextEncoding::Utf16BE};
+    const ByteSearcher& matcher = state->matchers[int(encoding)];
+    LineDecoder decoder(encoding);
+    const QString& keyword = state->options.keyword;
+    const Qt::CaseSensitivity cs = state->options.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    int count = 0;
+    int lineNo = 1;
+    qsizetype counted = view.begin;
+    QList<ContentMatch> matches;
+
+    auto collectContext = [&](qsizetype ls, qsizetype le, ContentMatch& m) {
+        qsizetype s = ls;
+        for (int i = 0; i < kContextLines && s > view.begin; ++i) {
+            const qsizetype prevEnd = s - view.unit;
+            const qsizetype prevStart = view.lineStart(prevEnd);
+            m.before.prepend(clipLine(decoder.decode(data + prevStart, qMin(prevEnd - prevStart, kContextBytes))));
+            s = prevStart;
+        }
+        qsizetype e = le;
+        for (int i = 0; i < kContextLines; ++i) {
+            const qsizetype nextStart = view.nextLine(e);
+            if (nextStart >= view.size) break;
+            const qsizetype nextEnd = view.lineEnd(nextStart);
+            m.after << clipLine(decoder.decode(data + nextStart, qMin(nextEnd - nextStart, kContextBytes)));
+            e = nextEnd;
+        }
+    };
+
+    // 处理命中所在行：解码验证 (剔除字节级假阳性)，并生成行级结果
+    auto processLine = [&](qsizetype ls, qsizetype le, qsizetype hit) {
+        lineNo += view.countNewlines(counted, ls);
+        counted = ls;
+
+        if (!matcher.isEmpty() && le - ls > kMaxLineBytes) {
+            for (qsizetype h = hit; h >= 0 && h < le; h = matcher.indexIn(data, le, h + 1)) {
+                const qsizetype a = view.align(qMax(ls, h - kWindowBytes));
+                const qsizetype b = qMin(le, h + kWindowBytes * 2);
+                const QString window = decoder.decode(data + a, b - a);
+                const qsizetype idx = window.indexOf(keyword, 0, cs);
+                if (idx < 0) continue;
+                ++count;
+                if (matches.size() < kMaxMatchesPerFile) {
+                    ContentMatch m;
+                    m.line = lineNo;
+                    m.column = int((h - ls) / view.unit) + 1;
+                    m.text = clipLine(window, idx);
+                    matches << m;
+                }
+            }
+            return;
+        }
+
+        const QString line = decoder.decode(data + ls, le - ls);
+        for (qsizetype idx = line.indexOf(keyword, 0, cs); idx >= 0; idx = line.indexOf(keyword, idx + 1, cs)) {
+            ++count;
+            if (matches.size() >= kMaxMatchesPerFile) continue;
+            ContentMatch m;
+            m.line = lineNo;
+            m.column = int(idx) + 1;
+            m.text = clipLine(line, idx);
+            collectContext(ls, le, m);
+            matches << m;
+        }
+    };
+
+    if (size > 0 && !matcher.isEmpty()) {
+        qsizetype pos = view.begin;
+        while (pos < view.size && !state->cancelled) {
+            const qsizetype hit = matcher.indexIn(data, size, pos);
+            if (hit < 0) break;
+            const qsizetype ls = qMax(pos, view.lineStart(hit));
+            const qsizetype le = view.lineEnd(hit);
+            processLine(ls, le, hit);
+            pos = view.nextLine(le);
+        }
+    } else if (size > 0) {
+        // 无法预编码关键字：逐行解码比较
+        for (qsizetype ls = view.begin; ls < view.size && !state->cancelled;) {
+            const qsizetype le = view.lineEnd(ls);
+            processLine(ls, le, ls);
+            ls = view.nextLine(le);
+        }
+    }
+
+    if (mapped) file.unmap(mapped);
+
+    if (count > 0) {
+        ++state->found;
+        const QString encodingLabel = encodingName(encoding);
+        QMetaObject::invokeMethod(this, [this, state, filePath, count, encodingLabel, matches]() {
+            if (state == m_state) emit fileMatched(filePath, count, encodingLabel, matches);
+        });
+    }
+    finishTask(state);
+}
+
+void ContentSearcher::finishTask(const std::shared_ptr<RunState>& state) {
+    if (--state->pending > 0) return;
+    QMetaObject::invokeMethod(this, [this, state]() {
+        if (state == m_state) {
+            m_state.reset();
+            emit finished(state->scanned, state->found);
+        }
+    });
+}
@@ -0,0 +1,133 @@
+#ifndef CONTENTSEARCHER_H
+#define CONTENTSEARCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QList>
+#include <QStringConverter>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief 预编译的文件过滤器
+ *
+ * 通配符只在构造时编译一次；忽略目录在遍历阶段直接剪枝，
+ * 不再对每个文件路径做字符串 contains 判断。
+ */
+class SearchFileFilter {
+public:
+    SearchFileFilter() = default;
+    SearchFileFilter(const QString& wildcards, const QStringList& ignoreDirs);
+
+    bool acceptsFileName(const QString& fileName) const;
+    bool acceptsDirName(const QString& dirName) const { return !m_ignoreDirs.contains(dirName); }
+
+    // 深度优先遍历 root，被忽略的目录整棵跳过；callback 返回 false 时终止
+    void forEachFile(const QString& root, const std::function<bool(const QString&)>& callback) const;
+
+private:
+    QList<QRegularExpression> m_patterns;
+    QStringList m_ignoreDirs;
+};
+
+/**
+ * @brief 字节级子串查找
+ *
+ * 区分大小写时以 needle 中最“罕见”的字节做 memchr 跳跃 (CRT 内部为 SIMD 实现)，
+ * 命中后再 memcmp 校验；不区分大小写时使用 ASCII 折叠的 Horspool 跳表。
+ * 计数语义与 QString::count 一致 (允许重叠)。
+ */
+class ByteSearcher {
+public:
+    ByteSearcher() = default;
+    ByteSearcher(const QByteArray& needle, bool caseSensitive);
+
+    bool isEmpty() const { return m_needle.isEmpty(); }
+    qsizetype indexIn(const char* data, qsizetype size, qsizetype from = 0) const;
+    int countIn(const char* data, qsizetype size) const;
+
+private:
+    qsizetype indexMemchr(const char* data, qsizetype size, qsizetype from) const;
+    qsizetype indexHorspool(const char* data, qsizetype size, qsizetype from) const;
+
+    QByteArray m_needle;     // 不区分大小写时已折叠为小写
+    bool m_caseSensitive = true;
+    int m_rareOffset = 0;
+    std::array<int, 256> m_skip{};
+};
+
+/**
+ * @brief 文本编码探测结果
+ */
+enum class TextEncoding {
+    Binary,
+    Utf8,
+    Utf16LE,
+    Utf16BE,
+    Gb18030 // 非法 UTF-8 时按 GBK/GB18030 处理
+};
+
+/**
+ * @brief 单条行级命中
+ */
+struct ContentMatch {
+    int line = 0;       // 从 1 开始
+    int column = 0;     // 从 1 开始，按字符计 (超长行为近似值)
+    QString text;       // 命中行；超长行只保留命中附近片段
+    QStringList before; // 上文若干行
+    QStringList after;  // 下文若干行
+};
+
+/**
+ * @brief 并行内容搜索
+ *
+ * 遍历线程负责枚举文件，每个文件作为独立任务投递到专用线程池；
+ * 文件通过 QFile::map 映射后按字节查找候选位置，只解码命中所在行及上下文，
+ * 不会把整个文件转换为 UTF-16。每个命中文件的行级结果回投到本对象所在线程并以信号发出。
+ */
+class ContentSearcher : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        QString rootDir;
+        QString keyword;
+        QString filter;
+        QStringList ignoreDirs;
+        bool caseSensitive = false;
+    };
+
+    explicit ContentSearcher(QObject* parent = nullptr);
+    ~ContentSearcher();
+
+    void start(const Options& options);
+    void cancel();
+    bool isRunning() const { return m_state != nullptr; }
+
+    // 编码探测：BOM > UTF-16 零字节分布 > UTF-8 合法性；bomLength 返回需跳过的 BOM 字节数
+    static TextEncoding detectEncoding(const char* data, qsizetype size, int* bomLength = nullptr);
+    static QString encodingName(TextEncoding encoding);
+    // 与探测结果对应的编解码器；GB18030 在无 ICU 时回退到系统 ANSI 代码页
+    static QStringDecoder decoderFor(TextEncoding encoding);
+    static QStringEncoder encoderFor(TextEncoding encoding);
+
+signals:
+    // matches 最多携带单文件前若干条结果，count 为该文件的全部命中次数
+    void fileMatched(const QString& path, int count, const QString& encoding, const QList<ContentMatch>& matches);
+    void finished(int scannedFiles, int foundFiles);
+
+private:
+    struct RunState;
+    void searchFile(const std::shared_ptr<RunState>& state, const QString& filePath);
+    void finishTask(const std::shared_ptr<RunState>& state);
+
+    QThreadPool m_pool;
+    std::shared_ptr<RunState> m_state;
+};
+
+#endif // CONTENTSEARCHER_H
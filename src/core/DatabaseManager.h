@@ -13,12 +13,23 @@
 #include <QSet>
 #include <QMutex>
 #include <QTimer>
+#include <QCache>
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QFuture>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
 
 class DatabaseManager : public QObject {
     Q_OBJECT
 public:
     enum MoveDirection { Up, Down, Top, Bottom };
     static constexpr int DEFAULT_PAGE_SIZE = 100;
+    // content_hash 算法版本 (notes.hash_version)：1 = 图片笔记使用像素哈希，低于此版本的行由后台回填
+    static constexpr int kContentHashVersion = 1;
     
     static DatabaseManager& instance();
 
@@ -32,12 +43,12 @@ public:
                 const QString& color = "", int categoryId = -1, 
                 const QString& itemType = "text", const QByteArray& dataBlob = QByteArray(),
                 const QString& sourceApp = "", const QString& sourceTitle = "",
-                const QString& remark = "");
+                const QString& remark = "", const QString& contentHash = "");
     bool updateNote(int id, const QString& title, const QString& content, const QStringList& tags, 
                     const QString& color = "", int categoryId = -1,
                     const QString& itemType = "text", const QByteArray& dataBlob = QByteArray(),
                     const QString& sourceApp = "", const QString& sourceTitle = "",
-                    const QString& remark = "");
+                    const QString& remark = "", const QString& contentHash = "");
     bool deleteNotesBatch(const QList<int>& ids);
     bool updateNoteState(int id, const QString& column, const QVariant& value);
     bool updateNoteStateBatch(const QList<int>& ids, const QString& column, const QVariant& value);
@@ -98,8 +109,26 @@ public:
     QStringList getAllTags();
     QList<QVariantMap> getRecentTagsWithCounts(int limit = 20);
     QVariantMap getNoteById(int id);
+
+    // OCR 结果缓存 (image_hash 为像素哈希，见 ImageHashHelper)
+    QString getOcrCache(const QString& imageHash, const QString& language, const QString& preprocess, bool* found = nullptr);
+    void saveOcrCacheAsync(const QString& imageHash, const QString& language, const QString& preprocess, const QString& text);
     int getLastCreatedNoteId();
 
+    // 内容寻址 blob 存储 (blobs 表，按内容 SHA256 去重、触发器维护引用计数)
+    QByteArray getBlob(const QString& blobHash);
+    // 旧数据/导入数据的 data_blob 非空时直接返回，否则按 blob_hash 延迟读取
+    QByteArray resolveBlob(const QVariantMap& note);
+    int collectGarbageBlobs();
+
+    // 预编译语句缓存统计 (hits / misses / size / hitRate)
+    QVariantMap statementCacheStats();
+
+    // 诊断钩子：列表筛选 / 计数 / 统计 / 待办按日查询在 prepare 前回调实际 SQL 与按序绑定的参数
+    // (用于检查查询计划)；回调在数据库锁内执行，不得再调用 DatabaseManager。传空函数即关闭
+    using SqlTraceHook = std::function<void(const QString& sql, const QVariantList& params)>;
+    void setSqlTraceHook(SqlTraceHook hook);
+
     // 统计
     QVariantMap getCounts();
     QVariantMap getFilterStats(const QString& keyword = "", const QString& filterType = "all", const QVariant& filterValue = -1, const QVariantMap& criteria = QVariantMap());
@@ -139,7 +168,7 @@ public:
                       const QString& color = "", int categoryId = -1,
                       const QString& itemType = "text", const QByteArray& dataBlob = QByteArray(),
                       const QString& sourceApp = "", const QString& sourceTitle = "",
-                      const QString& remark = "");
+                      const QString& remark = "", const QString& contentHash = "");
 
     // 批量导入模式优化
     void beginBatch();
@@ -179,6 +208,53 @@ private:
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
     bool createTables();
+    QString storeBlob(const QByteArray& data, const QString& format); // 调用方需持有 m_mutex
+
+    // 预编译语句缓存：固定 SQL 文本复用同一个 QSqlQuery (即同一个 sqlite3_stmt)，省去每次的解析与查询规划。
+    // 离开作用域时自动 finish (sqlite3_reset) 并解绑参数，避免长时间持有读快照或大块绑定数据。
+    // 仅用于不含拼接内容的固定 SQL；同一条语句不可在结果集未读完时被重入使用。调用方需持有 m_mutex。
+    class CachedStatement {
+    public:
+        explicit CachedStatement(QSqlQuery* query) : m_query(query) {}
+        CachedStatement(CachedStatement&& other) noexcept : m_query(std::exchange(other.m_query, nullptr)) {}
+        CachedStatement(const CachedStatement&) = delete;
+        CachedStatement& operator=(const CachedStatement&) = delete;
+        ~CachedStatement() {
+            if (!m_query) return;
+            m_query->finish();
+            const qsizetype count = m_query->boundValues().size();
+            for (qsizetype i = 0; i < count; ++i) m_query->bindValue(int(i), QVariant());
+        }
+        QSqlQuery* operator->() const { return m_query; }
+        QSqlQuery& operator*() const { return *m_query; }
+    private:
+        QSqlQuery* m_query;
+    };
+    CachedStatement cachedQuery(const QString& sql);
+    void invalidateStatementCache();
+    void migrateInlineBlobs();
+
+    // 分类快照：整表只读一次，供安全过滤、按名查找、祖先回溯等共用；分类写操作后失效、下次访问时重建。调用方需持有 m_mutex。
+    struct CategoryEntry {
+        int parentId = -1;       // 顶级分类统一为 -1
+        QString name;
+        bool hasPassword = false;
+        bool isDeleted = false;
+    };
+    struct CategorySnapshot {
+        QHash<int, CategoryEntry> byId;               // 含已删除分类
+        QHash<QPair<int, QString>, int> activeByName; // (父分类, 名称) -> id，仅未删除分类，重名取最小 id
+        QList<int> protectedIds;                      // 设置了密码的分类 (含已删除)
+    };
+    const CategorySnapshot& categorySnapshot();
+    const QList<int>& lockedCategoryIds(); // 设置了密码且本会话未解锁；解锁/上锁时失效
+    void invalidateCategorySnapshot();
+    // 旧数据 plain_text / word_count 等派生列的增量回填 (主线程分批读写，工作线程计算)
+    void scheduleTextMetricsBackfill(int delayMs);
+    void runTextMetricsBackfillBatch();
+    // 旧图片笔记 content_hash 升级为像素哈希 (与 ocr_cache 键一致)，同样主线程读写、工作线程解码
+    void schedulePixelHashBackfill(int delayMs);
+    void runPixelHashBackfillBatch();
     void applySecurityFilter(QString& whereClause, QVariantList& params, const QString& filterType);
     void applyCommonFilters(QString& whereClause, QVariantList& params, const QString& filterType, const QVariant& filterValue, const QVariantMap& criteria);
     void backupDatabase();
@@ -191,6 +267,8 @@ private slots:
 
 private:
     void markDirty();
+    // prepare 并按序绑定位置参数；设置了诊断钩子时先回调
+    void prepareBound(QSqlQuery& query, const QString& sql, const QVariantList& params);
     // 试用信息加密文件操作
     void saveTrialToFile(const QVariantMap& status);
     QVariantMap loadTrialFromFile();
@@ -204,12 +282,25 @@ private:
     QTimer* m_autoSaveTimer = nullptr;
     bool m_isDirty = false;
     QDateTime m_lastActivityTime;       // 最后一次数据变动的时间
+    bool m_blobGcPending = false;       // 有笔记被物理删除，待空闲落盘时回收零引用 blob
     
     bool m_isBatchMode = false;
     bool m_isInitialized = false;
     QVariantMap m_cachedTrialStatus;
 
     QSet<int> m_unlockedCategories; // 仅存储当前会话已解锁的分类 ID
+    std::optional<CategorySnapshot> m_categorySnapshot;
+    std::optional<QList<int>> m_lockedCategoryIds;
+
+    QCache<QString, QByteArray> m_blobCache; // 按字节数计费的 blob 读缓存
+
+    QHash<QString, std::shared_ptr<QSqlQuery>> m_stmtCache; // SQL 文本 -> 已 prepare 的语句
+    quint64 m_stmtHits = 0;
+    quint64 m_stmtMisses = 0;
+    SqlTraceHook m_sqlTrace;
+
+    QFuture<void> m_textMetricsJob; // 进行中的回填计算批次
+    QFuture<void> m_pixelHashJob;   // 进行中的像素哈希回填批次
     
     bool m_autoCategorizeEnabled = false;
     int m_activeCategoryId = -1;
@@ -52,7 +52,7 @@ static void exportNotesToDirectory(const QList<QVariantMap>& notes, const QStrin
         QString type = note.value("item_type").toString();
         QString title = note.value("title").toString();
         QString content = note.value("content").toString();
-        QByteArray blob = note.value("data_blob").toByteArray();
+        QByteArray blob = DatabaseManager::instance().resolveBlob(note);
 
         if (progress && processedCount) {
             progress->setValue((*processedCount)++);
@@ -64,7 +64,8 @@ static void exportNotesToDirectory(const QList<QVariantMap>& notes, const QStrin
             if (type == "image" && !QFileInfo(fileName).suffix().isEmpty()) {
                 // 保留原有后缀
             } else if (type == "image") {
-                fileName += ".png";
+                QString fmt = note.value("blob_format").toString();
+                fileName += "." + (fmt.isEmpty() ? QString("png") : fmt);
             }
             
             QString base = QFileInfo(fileName).completeBaseName();
@@ -567,7 +568,7 @@ void FileStorageHelper::exportToPackage(int catId, const QString& catName, QWidg
             nObj["remark"] = note.value("remark").toString();
             
             // 处理二进制数据
-            QByteArray blob = note.value("data_blob").toByteArray();
+            QByteArray blob = DatabaseManager::instance().resolveBlob(note);
             if (!blob.isEmpty()) {
                 nObj["data_blob"] = QString(blob.toBase64());
             }
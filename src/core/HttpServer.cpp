@@ -101,6 +101,8 @@ void HttpServer::incomingConnection(qintptr socketDescriptor) {
                     item["tags"] = note["tags"].toString();
                     item["item_type"] = note["item_type"].toString();
                     item["created_at"] = note["created_at"].toDateTime().toString(Qt::ISODate);
+                    // 二进制内容不随列表返回，客户端按 blob_hash 通过 /blob 接口按需拉取
+                    if (!note["blob_hash"].toString().isEmpty()) item["blob_hash"] = note["blob_hash"].toString();
                     arr.append(item);
                 }
                 
@@ -128,6 +130,7 @@ void HttpServer::incomingConnection(qintptr socketDescriptor) {
                     item["tags"] = note["tags"].toString();
                     item["item_type"] = note["item_type"].toString();
                     item["created_at"] = note["created_at"].toDateTime().toString(Qt::ISODate);
+                    if (!note["blob_hash"].toString().isEmpty()) item["blob_hash"] = note["blob_hash"].toString();
                     
                     QJsonObject resp;
                     resp["status"] = "success";
@@ -137,6 +140,30 @@ void HttpServer::incomingConnection(qintptr socketDescriptor) {
                 return;
             }
 
+            // 按内容哈希读取 blob 原始字节 (图片等)，哈希即内容，允许客户端长期缓存
+            if (reqStr.contains("GET /api/read/blob") || reqStr.contains("GET /api/full/blob")) {
+                QUrlQuery query(reqStr.split(' ')[1].split('?').value(1));
+                QString hash = query.queryItemValue("hash");
+                QByteArray blob = DatabaseManager::instance().getBlob(hash);
+                if (blob.isEmpty()) {
+                    QJsonObject err; err["status"] = "error"; err["message"] = "blob not found";
+                    sendJsonResponse(err, 404);
+                    return;
+                }
+                QString header = QString("HTTP/1.1 200 OK\r\n"
+                                         "Access-Control-Allow-Origin: *\r\n"
+                                         "Content-Type: application/octet-stream\r\n"
+                                         "Content-Length: %1\r\n"
+                                         "Cache-Control: public, max-age=31536000, immutable\r\n"
+                                         "Connection: close\r\n"
+                                         "\r\n").arg(blob.size());
+                socket->write(header.toUtf8() + blob);
+                socket->flush();
+                socket->disconnectFromHost();
+                dataBuffer.clear();
+                return;
+            }
+
             if (dataBuffer.contains("POST /api/full/add") || 
                 dataBuffer.contains("POST /api/full/update") || dataBuffer.contains("POST /api/full/delete")) {
                 
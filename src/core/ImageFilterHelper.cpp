@@ -0,0 +1,114 @@
+#include "ImageFilterHelper.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr int kBlurPasses = 3;
+
+inline QImage premultipliedCopy(const QImage& source, const QRect& rect) {
+    QImage sub = source.copy(rect);
+    if (sub.format() != QImage::Format_ARGB32_Premultiplied) sub = sub.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    return sub;
+}
+
+// 一维盒式模糊：stride 为相邻元素的间隔 (以像素计)，边缘钳位取样
+void boxBlurLine(const quint32* in, quint32* out, int n, qsizetype stride, int radius) {
+    const int window = radius * 2 + 1;
+    int sum[4] = {0, 0, 0, 0};
+    auto at = [&](int i) { return in[qsizetype(std::clamp(i, 0, n - 1)) * stride]; };
+    auto accumulate = [&sum](quint32 px, int sign) {
+        sum[0] += sign * int(px >> 24);
+        sum[1] += sign * int((px >> 16) & 0xff);
+        sum[2] += sign * int((px >> 8) & 0xff);
+        sum[3] += sign * int(px & 0xff);
+    };
+    for (int i = -radius; i <= radius; ++i) accumulate(at(i), 1);
+    for (int i = 0; i < n; ++i) {
+        const int half = window / 2;
+        out[qsizetype(i) * stride] = (quint32((sum[0] + half) / window) << 24)
+                                   | (quint32((sum[1] + half) / window) << 16)
+                                   | (quint32((sum[2] + half) / window) << 8)
+                                   |  quint32((sum[3] + half) / window);
+        accumulate(at(i + radius + 1), 1);
+        accumulate(at(i - radius), -1);
+    }
+}
+}
+
+int ImageFilterHelper::blockSize(int strength) {
+    return std::clamp(strength, kMinStrength, kMaxStrength) * 6;
+}
+
+int ImageFilterHelper::blurRadius(int strength) {
+    return std::clamp(strength, kMinStrength, kMaxStrength) * 3;
+}
+
+QImage ImageFilterHelper::apply(const QImage& source, const QRect& region, Effect effect, int strength) {
+    const QRect target = region.intersected(source.rect());
+    if (source.isNull() || target.isEmpty()) return QImage();
+    return effect == Effect::Blur ? blur(source, target, blurRadius(strength)) : pixelate(source, target, blockSize(strength));
+}
+
+QImage ImageFilterHelper::pixelate(const QImage& source, const QRect& region, int block) {
+    // 扩展到完整的块网格，保证边界块与相邻区域算出的平均值一致
+    const int left = (region.left() / block) * block;
+    const int top = (region.top() / block) * block;
+    const int right = ((region.right() / block) + 1) * block - 1;
+    const int bottom = ((region.bottom() / block) + 1) * block - 1;
+    const QRect padded = QRect(QPoint(left, top), QPoint(right, bottom)).intersected(source.rect());
+    const QImage sub = premultipliedCopy(source, padded);
+
+    QImage out(region.size(), QImage::Format_ARGB32_Premultiplied);
+    for (int by = top; by <= bottom; by += block) {
+        for (int bx = left; bx <= right; bx += block) {
+            const QRect cell = QRect(bx, by, block, block).intersected(padded);
+            if (cell.isEmpty()) continue;
+
+            quint64 sum[4] = {0, 0, 0, 0};
+            for (int y = cell.top(); y <= cell.bottom(); ++y) {
+                const quint32* line = reinterpret_cast<const quint32*>(sub.constScanLine(y - padded.top()));
+                for (int x = cell.left(); x <= cell.right(); ++x) {
+                    const quint32 px = line[x - padded.left()];
+                    sum[0] += px >> 24; sum[1] += (px >> 16) & 0xff; sum[2] += (px >> 8) & 0xff; sum[3] += px & 0xff;
+                }
+            }
+            const quint64 count = quint64(cell.width()) * cell.height();
+            const quint32 avg = (quint32(sum[0] / count) << 24) | (quint32(sum[1] / count) << 16)
+                              | (quint32(sum[2] / count) << 8) | quint32(sum[3] / count);
+
+            const QRect fill = cell.intersected(region).translated(-region.topLeft());
+            for (int y = fill.top(); y <= fill.bottom(); ++y) {
+                quint32* line = reinterpret_cast<quint32*>(out.scanLine(y));
+                std::fill(line + fill.left(), line + fill.right() + 1, avg);
+            }
+        }
+    }
+    return out;
+}
+
+QImage ImageFilterHelper::blur(const QImage& source, const QRect& region, int radius) {
+    // 每次盒式模糊向外传播 radius 像素，多取 3 倍半径后中心区域不受截断影响
+    const int pad = radius * kBlurPasses;
+    const QRect padded = region.adjusted(-pad, -pad, pad, pad).intersected(source.rect());
+    QImage a = premultipliedCopy(source, padded);
+    QImage b(a.size(), QImage::Format_ARGB32_Premultiplied);
+    const int w = a.width();
+    const int h = a.height();
+
+    // 可分离：先逐行水平模糊，再逐列垂直模糊，两缓冲交替
+    for (int pass = 0; pass < kBlurPasses; ++pass) {
+        for (int y = 0; y < h; ++y) {
+            boxBlurLine(reinterpret_cast<const quint32*>(a.constScanLine(y)), reinterpret_cast<quint32*>(b.scanLine(y)), w, 1, radius);
+        }
+        std::swap(a, b);
+    }
+    const qsizetype stride = a.bytesPerLine() / 4; // 两缓冲同尺寸同格式，行跨度一致
+    for (int pass = 0; pass < kBlurPasses; ++pass) {
+        const quint32* in = reinterpret_cast<const quint32*>(a.constBits());
+        quint32* out = reinterpret_cast<quint32*>(b.bits());
+        for (int x = 0; x < w; ++x) boxBlurLine(in + x, out + x, h, stride, radius);
+        std::swap(a, b);
+    }
+
+    return a.copy(region.translated(-padded.topLeft()));
+}
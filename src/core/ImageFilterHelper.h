@@ -0,0 +1,33 @@
+#ifndef IMAGEFILTERHELPER_H
+#define IMAGEFILTERHELPER_H
+
+#include <QImage>
+#include <QRect>
+
+/**
+ * @brief 局部马赛克 / 模糊滤镜
+ * 只处理调用方给出的区域 (像素坐标)，返回与该区域等大的 ARGB32_Premultiplied 图像：
+ *   - Pixelate：像素块按整图网格 (0,0) 对齐，跨区域边界的块按完整块求平均，相邻区域拼接无接缝；
+ *   - Blur：三次可分离盒式模糊 (水平 + 垂直) 近似高斯，向外多取 3 倍半径的源像素，同样无接缝。
+ * 纯函数、不依赖 GUI 线程，可在 QtConcurrent 工作线程中并行调用。
+ */
+class ImageFilterHelper {
+public:
+    enum class Effect { Pixelate, Blur };
+
+    static constexpr int kMinStrength = 1;
+    static constexpr int kMaxStrength = 10;
+    static constexpr int kDefaultStrength = 6;
+
+    // 强度 1~10 映射为像素块边长 / 模糊半径 (像素)
+    static int blockSize(int strength);
+    static int blurRadius(int strength);
+
+    static QImage apply(const QImage& source, const QRect& region, Effect effect, int strength);
+
+private:
+    static QImage pixelate(const QImage& source, const QRect& region, int block);
+    static QImage blur(const QImage& source, const QRect& region, int radius);
+};
+
+#endif // IMAGEFILTERHELPER_H
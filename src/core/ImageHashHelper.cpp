@@ -0,0 +1,24 @@
+#include "ImageHashHelper.h"
+#include <QByteArrayView>
+#include <QCryptographicHash>
+
+QString ImageHashHelper::pixelHash(const QImage& image) {
+    if (image.isNull()) return QString();
+
+    const QImage img = image.format() == QImage::Format_ARGB32 ? image : image.convertToFormat(QImage::Format_ARGB32);
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+
+    // 尺寸参与哈希，避免像素相同但宽高不同的图片冲突
+    const qint32 dims[2] = { img.width(), img.height() };
+    hash.addData(QByteArrayView(reinterpret_cast<const char*>(dims), sizeof(dims)));
+
+    const qsizetype rowBytes = qsizetype(img.width()) * 4;
+    if (img.bytesPerLine() == rowBytes) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(img.constBits()), rowBytes * img.height()));
+    } else {
+        for (int y = 0; y < img.height(); ++y) {
+            hash.addData(QByteArrayView(reinterpret_cast<const char*>(img.constScanLine(y)), rowBytes));
+        }
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
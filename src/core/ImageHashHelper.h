@@ -0,0 +1,17 @@
+#ifndef IMAGEHASHHELPER_H
+#define IMAGEHASHHELPER_H
+
+#include <QImage>
+#include <QString>
+
+class ImageHashHelper {
+public:
+    /**
+     * @brief 基于像素内容的 SHA256 (十六进制)
+     * 统一转换为 ARGB32 后逐行哈希 (不含行尾填充)，与编码格式、压缩级别无关；
+     * 同一张图片无论来自剪贴板、文件还是数据库，得到的哈希都相同。
+     */
+    static QString pixelHash(const QImage& image);
+};
+
+#endif // IMAGEHASHHELPER_H
@@ -0,0 +1,110 @@
+#include "ImageSaveService.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QImageWriter>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QtConcurrent>
+
+namespace {
+constexpr int kMaxEncodeThreads = 2;
+
+bool writeAtomically(const QString& path, const QByteArray& data) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    if (out.write(data) != data.size()) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+}
+
+ImageSaveService& ImageSaveService::instance() {
+    static ImageSaveService inst;
+    return inst;
+}
+
+ImageSaveService::ImageSaveService(QObject* parent) : QObject(parent) {
+    m_pool.setMaxThreadCount(kMaxEncodeThreads);
+}
+
+ImageSaveService::~ImageSaveService() {
+    m_pool.waitForDone();
+}
+
+ImageSaveService::Options ImageSaveService::screenshotOptions() {
+    QSettings settings("RapidNotes", "Screenshot");
+    Options options;
+    options.format = resolveFormat(settings.value("saveFormat", "png").toByteArray());
+    options.quality = settings.value("saveQuality", -1).toInt();
+    options.pngCompression = settings.value("pngCompression", -1).toInt();
+    return options;
+}
+
+QStringList ImageSaveService::availableFormats() {
+    static const QStringList formats = [] {
+        const QList<QByteArray> supported = QImageWriter::supportedImageFormats();
+        QStringList list;
+        for (const char* f : {"png", "jpg", "webp", "qoi"}) {
+            if (supported.contains(f)) list << QString::fromLatin1(f);
+        }
+        return list;
+    }();
+    return formats;
+}
+
+QByteArray ImageSaveService::resolveFormat(const QByteArray& requested) {
+    QByteArray format = requested.toLower();
+    if (format == "jpeg") format = "jpg";
+    return availableFormats().contains(QString::fromLatin1(format)) ? format : QByteArray("png");
+}
+
+QByteArray ImageSaveService::encode(const QImage& image, const QByteArray& format, const Options& options) {
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, format);
+    if (format == "png") {
+        // Qt 的 PNG 编码器把 quality [0,100] 映射为 zlib 级别 [9,0]，这里按级别反推
+        if (options.pngCompression >= 0) writer.setQuality(100 - (qBound(0, options.pngCompression, 9) * 91 + 8) / 9);
+    } else if (options.quality >= 0) {
+        writer.setQuality(qBound(0, options.quality, 100));
+    }
+    if (!writer.write(image)) {
+        qDebug() << "[ImageSaveService] 编码失败:" << format << writer.errorString();
+        return QByteArray();
+    }
+    return data;
+}
+
+void ImageSaveService::saveAsync(const QImage& image, const QStringList& paths, const Options& options, SavedCallback onSaved) {
+    if (image.isNull()) return;
+
+    (void)QtConcurrent::run(&m_pool, [this, image, paths, options, onSaved]() {
+        const QByteArray primaryFormat = resolveFormat(options.format);
+        QHash<QByteArray, QByteArray> encoded; // 每种格式只编码一次
+
+        auto encodedFor = [&](const QByteArray& format) -> const QByteArray& {
+            auto it = encoded.find(format);
+            if (it == encoded.end()) it = encoded.insert(format, encode(image, format, options));
+            return it.value();
+        };
+
+        for (const QString& path : paths) {
+            // 用户在保存对话框中指定了其他可编码的后缀时按后缀编码，否则沿用主格式
+            QByteArray format = QFileInfo(path).suffix().toLatin1().toLower();
+            if (format.isEmpty() || !QImageWriter::supportedImageFormats().contains(format)) format = primaryFormat;
+            const QByteArray& data = encodedFor(format);
+            const bool ok = !data.isEmpty() && writeAtomically(path, data);
+            if (onSaved) {
+                QMetaObject::invokeMethod(this, [onSaved, path, ok]() { onSaved(path, ok); }, Qt::QueuedConnection);
+            }
+        }
+    });
+}
@@ -0,0 +1,47 @@
+#ifndef IMAGESAVESERVICE_H
+#define IMAGESAVESERVICE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <functional>
+
+/**
+ * @brief 后台图片编码 / 保存
+ * 调用方交出一份不再修改的 QImage 后即可返回 (截图浮层可立即关闭)；编码在专用线程池中完成，
+ * 同一格式只编码一次，结果同时写入所有目标文件。
+ * 文件经 QSaveFile 先写临时文件再原子重命名，中途失败不会留下半截图片。
+ */
+class ImageSaveService : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        QByteArray format = "png"; // png / jpg / webp / qoi，当前 Qt 未提供对应插件时回退为 png
+        int quality = -1;          // JPEG / WebP 质量 0~100，-1 使用编码器默认值
+        int pngCompression = -1;   // PNG zlib 压缩级别 0~9，-1 使用默认值
+    };
+    using SavedCallback = std::function<void(const QString& path, bool ok)>;
+
+    static ImageSaveService& instance();
+
+    // 读取截图设置 (saveFormat / saveQuality / pngCompression)
+    static Options screenshotOptions();
+    // 规范化格式名并检查编码器是否可用
+    static QByteArray resolveFormat(const QByteArray& requested);
+    static QStringList availableFormats();
+
+    // 异步编码并保存；paths 按后缀决定格式 (无后缀时使用 options.format)，onSaved 在 GUI 线程逐个回调
+    void saveAsync(const QImage& image, const QStringList& paths, const Options& options, SavedCallback onSaved = {});
+
+private:
+    ImageSaveService(QObject* parent = nullptr);
+    ~ImageSaveService();
+    static QByteArray encode(const QImage& image, const QByteArray& format, const Options& options);
+
+    QThreadPool m_pool;
+};
+
+#endif // IMAGESAVESERVICE_H
@@ -1,14 +1,24 @@
 #include "OCRManager.h"
+#include "TesseractWorkerPool.h"
+#include "ImageHashHelper.h"
+#include "DatabaseManager.h"
 #include <QtConcurrent>
 #include <QThreadPool>
 #include <QStringList>
 #include <QTemporaryFile>
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QDir>
 #include <QDebug>
 #include <QLocale>
 #include <QCoreApplication>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <utility>
+#include <vector>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -20,9 +30,20 @@ OCRManager& OCRManager::instance() {
 }
 
 OCRManager::OCRManager(QObject* parent) : QObject(parent) {
+    // 2026-03-xx 按照用户要求：Tesseract 引擎常驻，探测结果缓存，不再每次请求重新扫描目录
+    const int workers = qBound(1, QThread::idealThreadCount() / 2, 4);
+    m_tesseract = std::make_unique<TesseractWorkerPool>(workers);
+    m_pool.setMaxThreadCount(workers);
+    m_tilePool.setMaxThreadCount(workers);
     detectAvailableEngine();
 }
 
+OCRManager::~OCRManager() {
+    cancelAll();
+    m_pool.waitForDone();
+    m_tilePool.waitForDone();
+}
+
 void OCRManager::setLanguage(const QString& lang) {
     m_language = lang;
 }
@@ -32,54 +53,388 @@ QString OCRManager::getLanguage() const {
 }
 
 void OCRManager::detectAvailableEngine() {
-    QString path = findTesseractPath();
-    if (!path.isEmpty()) {
+    if (m_tesseract->isAvailable()) {
         m_engineType = EngineType::Tesseract;
-        m_cachedTesseractPath = path;
-        qDebug() << "[OCRManager] 检测到 Tesseract 引擎，路径:" << path;
+        qDebug() << "[OCRManager] 检测到 Tesseract 引擎，路径:" << m_tesseract->environment().exePath
+                 << "tessdata:" << m_tesseract->environment().tessdataDir;
     } else {
         m_engineType = EngineType::WindowsOCR;
         qDebug() << "[OCRManager] 未找到 Tesseract，回退到 Windows 原生 OCR";
     }
 }
 
-QString OCRManager::findTesseractPath() {
-    QString appPath = QCoreApplication::applicationDirPath();
-    QStringList basePaths;
-    basePaths << appPath;
-    basePaths << QDir(appPath).absolutePath() + "/..";
-    basePaths << QDir(appPath).absolutePath() + "/../..";
-
-    for (const QString& base : std::as_const(basePaths)) {
-        QStringList exePotentials;
-        exePotentials << base + "/resources/Tesseract-OCR/tesseract.exe"
-                       << base + "/Tesseract-OCR/tesseract.exe"
-                       << base + "/resources/tesseract.exe"
-                       << base + "/tesseract.exe"
-                       << "C:/Program Files/Tesseract-OCR/tesseract.exe";
-        for (const QString& p : std::as_const(exePotentials)) {
-            if (QFile::exists(p)) {
-                return QDir::toNativeSeparators(p);
-            }
-        }
-    }
-    return "";
+QString OCRManager::cacheLanguage() const {
+    return m_engineType == EngineType::Tesseract ? m_tesseract->resolveLanguage(m_language) : QStringLiteral("windows");
+}
+
+QString OCRManager::preprocessTag(bool binarize) {
+    return QString("v%1%2").arg(kPreprocessVersion).arg(binarize ? "+sauvola" : "");
 }
 
 void OCRManager::recognizeAsync(const QImage& image, int contextId) {
     qDebug() << "[OCRManager] recognizeAsync: 接收任务 ID:" << contextId 
              << "图片大小:" << image.width() << "x" << image.height() 
              << "主线程:" << QThread::currentThread();
-    (void)QtConcurrent::run(QThreadPool::globalInstance(), [this, image, contextId]() {
-        qDebug() << "[OCRManager] 工作线程开始执行 ID:" << contextId 
-                 << "线程:" << QThread::currentThread();
-        this->recognizeSync(image, contextId);
-        qDebug() << "[OCRManager] 工作线程完成 ID:" << contextId;
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    {
+        QMutexLocker locker(&m_inflightMutex);
+        m_inflight.insert(contextId, cancelled);
+    }
+    const QString language = cacheLanguage();
+    const bool binarize = m_adaptiveBinarization;
+
+    // 2026-03-xx 按照用户要求：同一张图片重复识别直接读取缓存
+    // 1) 工作线程计算像素哈希 -> 2) 数据库线程查缓存 -> 3) 未命中才回到工作线程识别
+    (void)QtConcurrent::run(&m_pool, [this, image, contextId, cancelled, language, binarize]() {
+        if (*cancelled) {
+            finishRequest(contextId, cancelled, QString());
+            return;
+        }
+        const QString hash = ImageHashHelper::pixelHash(image);
+        const QString preprocess = preprocessTag(binarize);
+
+        QMetaObject::invokeMethod(&DatabaseManager::instance(), [=, this]() {
+            bool found = false;
+            const QString cached = DatabaseManager::instance().getOcrCache(hash, language, preprocess, &found);
+            if (found) {
+                qDebug() << "[OCRManager] 命中 OCR 缓存 ID:" << contextId;
+                finishRequest(contextId, cancelled, cached);
+                return;
+            }
+            (void)QtConcurrent::run(&m_pool, [=, this]() {
+                qDebug() << "[OCRManager] 工作线程开始执行 ID:" << contextId 
+                         << "线程:" << QThread::currentThread();
+                bool ok = false;
+                const QString text = recognizeSync(image, contextId, language, binarize, *cancelled, &ok);
+                if (ok && !*cancelled) DatabaseManager::instance().saveOcrCacheAsync(hash, language, preprocess, text);
+                finishRequest(contextId, cancelled, text);
+                qDebug() << "[OCRManager] 工作线程完成 ID:" << contextId;
+            });
+        });
+    });
+}
+
+void OCRManager::finishRequest(int contextId, const CancelFlag& cancelled, QString text) {
+    {
+        QMutexLocker locker(&m_inflightMutex);
+        m_inflight.remove(contextId, cancelled);
+    }
+    if (*cancelled) {
+        text = "识别已取消";
+    } else if (text.isEmpty()) {
+        text = "未能从图片中识别出任何文字";
+    }
+    emit recognitionFinished(text, contextId);
+}
+
+void OCRManager::cancel(int contextId) {
+    QMutexLocker locker(&m_inflightMutex);
+    for (auto it = m_inflight.find(contextId); it != m_inflight.end() && it.key() == contextId; ++it) {
+        it.value()->store(true);
+    }
+}
+
+void OCRManager::cancelAll() {
+    QMutexLocker locker(&m_inflightMutex);
+    for (const auto& flag : std::as_const(m_inflight)) flag->store(true);
+}
+
+void OCRManager::setAdaptiveBinarization(bool enabled) {
+    m_adaptiveBinarization = enabled;
+}
+
+bool OCRManager::adaptiveBinarization() const {
+    return m_adaptiveBinarization;
+}
+
+// ----------------------------------------------------------------------------
+// 预处理辅助：按行分段并行，所有像素访问都在连续的 8 位缓冲区上进行
+// ----------------------------------------------------------------------------
+namespace {
+constexpr int kMinRowsPerBand = 64;   // 行数过少时并行调度得不偿失
+constexpr int kSauvolaRadius = 15;    // 约等于放大后单行文字高度的一半
+constexpr double kSauvolaK = 0.34;
+constexpr double kSauvolaR = 128.0;
+
+struct RowBand {
+    int begin;
+    int end;
+    std::array<int, 256> histogram{};
+};
+
+QVector<RowBand> splitRows(int rows) {
+    const int threads = std::max(1, QThread::idealThreadCount());
+    const int bands = std::clamp(rows / kMinRowsPerBand, 1, threads);
+    const int step = (rows + bands - 1) / bands;
+    QVector<RowBand> result;
+    for (int b = 0; b < rows; b += step) result.append({b, std::min(rows, b + step)});
+    return result;
+}
+
+template <typename Fn>
+void runBands(QVector<RowBand>& bands, Fn fn) {
+    if (bands.size() == 1) fn(bands[0]);
+    else QtConcurrent::blockingMap(bands, fn);
+}
+
+// Sauvola 自适应二值化：T = m * (1 + k * (s / R - 1))
+// 每个行段维护自己的列累加和，窗口沿行滑动，内存占用只与图像宽度成正比
+QImage sauvolaBinarize(const QImage& gray) {
+    const int w = gray.width();
+    const int h = gray.height();
+    QImage out(w, h, QImage::Format_Grayscale8);
+    QVector<RowBand> bands = splitRows(h);
+
+    runBands(bands, [&](RowBand& band) {
+        std::vector<int> colSum(w, 0);
+        std::vector<qint64> colSq(w, 0);
+        auto addRow = [&](int y, int sign) {
+            const uchar* line = gray.constScanLine(y);
+            for (int x = 0; x < w; ++x) {
+                const int v = line[x];
+                colSum[x] += sign * v;
+                colSq[x] += sign * v * v;
+            }
+        };
+        const int firstRow = std::max(0, band.begin - kSauvolaRadius);
+        const int lastRow = std::min(h - 1, band.begin + kSauvolaRadius);
+        for (int y = firstRow; y <= lastRow; ++y) addRow(y, 1);
+
+        for (int y = band.begin; y < band.end; ++y) {
+            const int rowsInWindow = std::min(h - 1, y + kSauvolaRadius) - std::max(0, y - kSauvolaRadius) + 1;
+            const uchar* src = gray.constScanLine(y);
+            uchar* dst = out.scanLine(y);
+
+            qint64 sum = 0, sq = 0;
+            for (int x = 0; x <= std::min(w - 1, kSauvolaRadius); ++x) { sum += colSum[x]; sq += colSq[x]; }
+            for (int x = 0; x < w; ++x) {
+                const int colsInWindow = std::min(w - 1, x + kSauvolaRadius) - std::max(0, x - kSauvolaRadius) + 1;
+                const double n = double(rowsInWindow) * colsInWindow;
+                const double mean = sum / n;
+                const double stddev = std::sqrt(std::max(0.0, sq / n - mean * mean));
+                const double threshold = mean * (1.0 + kSauvolaK * (stddev / kSauvolaR - 1.0));
+                dst[x] = src[x] > threshold ? 255 : 0;
+
+                const int leaving = x - kSauvolaRadius;
+                const int entering = x + kSauvolaRadius + 1;
+                if (leaving >= 0) { sum -= colSum[leaving]; sq -= colSq[leaving]; }
+                if (entering < w) { sum += colSum[entering]; sq += colSq[entering]; }
+            }
+
+            if (y - kSauvolaRadius >= 0) addRow(y - kSauvolaRadius, -1);
+            if (y + kSauvolaRadius + 1 < h) addRow(y + kSauvolaRadius + 1, 1);
+        }
     });
+    return out;
+}
+}
+
+// ----------------------------------------------------------------------------
+// 大图分块：基于投影直方图的文字区域检测
+// ----------------------------------------------------------------------------
+namespace {
+constexpr int kTileTrigger = 2000;    // 长边超过该值才考虑分块
+constexpr int kTileMaxHeight = 1600;  // 单块最大高度 (原图像素)
+constexpr int kTileMaxWidth = 4000;   // 单块最大宽度，超出时在墨迹最少的列处切开
+constexpr int kTileOverlap = 96;      // 找不到行间空白时上下块的重叠高度 (约 2~3 行文字)
+constexpr int kMinColumnGap = 40;     // 纵向空白带至少这么宽才视为分栏
+constexpr int kEdgeThreshold = 32;    // 相邻像素灰度差超过该值记为墨迹
+constexpr int kTilePadding = 4;
+constexpr int kMaxOverlapLines = 8;
+
+struct OcrTile {
+    QRect rect;
+    int column = 0;                // 所属分栏，合并时栏与栏之间空一行
+    bool overlapsPrevious = false; // 与同栏上一块存在重叠，合并时需要去重
+};
+
+// 边缘图：文字笔画产生密集的灰度跳变，大面积纯色面板不会，比全局阈值更适合界面截图
+class InkMap {
+public:
+    explicit InkMap(const QImage& gray)
+        : m_w(gray.width()), m_h(gray.height()), m_ink(size_t(m_w) * m_h, 0) {
+        QVector<RowBand> bands = splitRows(m_h);
+        runBands(bands, [&](RowBand& band) {
+            for (int y = band.begin; y < band.end; ++y) {
+                const uchar* line = gray.constScanLine(y);
+                const uchar* below = gray.constScanLine(std::min(y + 1, m_h - 1));
+                uchar* dst = m_ink.data() + size_t(y) * m_w;
+                for (int x = 0; x < m_w - 1; ++x) {
+                    const int dx = std::abs(line[x + 1] - line[x]);
+                    const int dy = std::abs(below[x] - line[x]);
+                    dst[x] = (dx > kEdgeThreshold || dy > kEdgeThreshold) ? 1 : 0;
+                }
+            }
+        });
+    }
+
+    std::vector<int> rowProfile(const QRect& r) const {
+        std::vector<int> profile(r.height(), 0);
+        for (int y = 0; y < r.height(); ++y) {
+            const uchar* line = m_ink.data() + size_t(r.top() + y) * m_w + r.left();
+            int count = 0;
+            for (int x = 0; x < r.width(); ++x) count += line[x];
+            profile[y] = count;
+        }
+        return profile;
+    }
+
+    std::vector<int> columnProfile(const QRect& r) const {
+        std::vector<int> profile(r.width(), 0);
+        for (int y = r.top(); y <= r.bottom(); ++y) {
+            const uchar* line = m_ink.data() + size_t(y) * m_w + r.left();
+            for (int x = 0; x < r.width(); ++x) profile[x] += line[x];
+        }
+        return profile;
+    }
+
+private:
+    int m_w;
+    int m_h;
+    std::vector<uchar> m_ink;
+};
+
+// 按贯穿整个区域的纵向空白带切分分栏 (并排窗口、多显示器拼接)
+QList<QRect> splitColumns(const InkMap& ink, const QRect& area) {
+    const std::vector<int> cols = ink.columnProfile(area);
+    const int n = int(cols.size());
+    QList<QRect> result;
+    int start = -1;
+    int gap = 0;
+    for (int i = 0; i <= n; ++i) {
+        const bool blank = i == n || cols[i] == 0;
+        if (!blank) {
+            if (start < 0) start = i;
+            gap = 0;
+            continue;
+        }
+        if (start < 0) continue;
+        if (++gap >= kMinColumnGap || i == n) {
+            const int end = i - gap + 1; // 最后一列墨迹之后
+            result.append(QRect(area.left() + start, area.top(), end - start, area.height()));
+            start = -1;
+            gap = 0;
+        }
+    }
+    return result;
+}
+
+// 过宽的分栏在中间三分之一范围内墨迹最少的列处切开，尽量不切断文字
+void limitWidth(const InkMap& ink, const QRect& r, QList<QRect>& out) {
+    if (r.width() <= kTileMaxWidth) {
+        out.append(r);
+        return;
+    }
+    const std::vector<int> cols = ink.columnProfile(r);
+    const int from = r.width() / 3;
+    const int to = r.width() * 2 / 3;
+    int cut = from;
+    for (int i = from; i < to; ++i) {
+        if (cols[i] < cols[cut]) cut = i;
+    }
+    limitWidth(ink, QRect(r.left(), r.top(), cut, r.height()), out);
+    limitWidth(ink, QRect(r.left() + cut, r.top(), r.width() - cut, r.height()), out);
+}
+
+// 分栏内按行投影找出文字行段，贪心装入不超过 kTileMaxHeight 的块，块边界落在行间空白处
+void planColumnTiles(const InkMap& ink, const QRect& col, int column, const QRect& bounds, QList<OcrTile>& tiles) {
+    const std::vector<int> rows = ink.rowProfile(col);
+    const int n = int(rows.size());
+
+    struct Run { int begin; int end; };
+    QVector<Run> runs;
+    for (int y = 0; y < n;) {
+        if (rows[y] == 0) { ++y; continue; }
+        int e = y;
+        while (e < n && rows[e] > 0) ++e;
+        runs.append({y, e});
+        y = e;
+    }
+
+    auto addTile = [&](int top, int bottom, bool overlapsPrevious) {
+        QRect r(col.left(), col.top() + top - kTilePadding, col.width(), bottom - top + 2 * kTilePadding);
+        tiles.append({r.intersected(bounds), column, overlapsPrevious});
+    };
+
+    int i = 0;
+    while (i < runs.size()) {
+        const int top = runs[i].begin;
+        int bottom = runs[i].end;
+        int j = i + 1;
+        while (j < runs.size() && runs[j].end - top <= kTileMaxHeight) bottom = runs[j++].end;
+
+        if (bottom - top <= kTileMaxHeight) {
+            addTile(top, bottom, false);
+        } else {
+            // 单个连续墨迹段超高 (图片、无行距的密集内容)，按固定高度带重叠切开
+            for (int y = top;; y += kTileMaxHeight - kTileOverlap) {
+                const int e = std::min(bottom, y + kTileMaxHeight);
+                addTile(y, e, y != top);
+                if (e >= bottom) break;
+            }
+        }
+        i = j;
+    }
+}
+
+QList<OcrTile> planTiles(const QImage& gray) {
+    const QRect bounds = gray.rect();
+    const InkMap ink(gray);
+    QList<QRect> columns;
+    for (const QRect& c : splitColumns(ink, bounds)) limitWidth(ink, c, columns);
+
+    QList<OcrTile> tiles;
+    for (int i = 0; i < columns.size(); ++i) planColumnTiles(ink, columns[i], i, bounds, tiles);
+    return tiles;
+}
+
+QString normalizedLine(const QString& line) {
+    QString s;
+    s.reserve(line.size());
+    for (QChar ch : line) {
+        if (!ch.isSpace()) s.append(ch);
+    }
+    return s;
+}
+
+// 按阅读顺序合并：同栏逐块拼接并去掉重叠区重复识别的行，栏与栏之间空一行
+QString mergeTileTexts(const QList<OcrTile>& tiles, const QStringList& texts) {
+    QStringList columns;
+    QStringList current;
+    int column = -1;
+    for (int i = 0; i < tiles.size(); ++i) {
+        if (tiles[i].column != column) {
+            if (!current.isEmpty()) columns << current.join('\n');
+            current.clear();
+            column = tiles[i].column;
+        }
+        if (texts[i].isEmpty()) continue;
+
+        QStringList lines = texts[i].split('\n');
+        if (tiles[i].overlapsPrevious) {
+            const int maxCheck = std::min({int(current.size()), int(lines.size()), kMaxOverlapLines});
+            for (int k = maxCheck; k > 0; --k) {
+                bool same = true;
+                for (int t = 0; t < k && same; ++t) {
+                    same = normalizedLine(current[current.size() - k + t]) == normalizedLine(lines[t]);
+                }
+                if (same) {
+                    lines = lines.mid(k);
+                    break;
+                }
+            }
+        }
+        current << lines;
+    }
+    if (!current.isEmpty()) columns << current.join('\n');
+    return columns.join("\n\n").trimmed();
+}
 }
 
 // 图像预处理函数：提高 OCR 识别准确度
-QImage OCRManager::preprocessImage(const QImage& original) {
+// [PERF] 反色、对比度拉伸合并为一张 256 项查找表，与锐化卷积在同一遍中按行段并行完成；
+// 输出与逐步处理 (invertPixels -> 拉伸 -> 锐化) 的结果逐像素一致。
+QImage OCRManager::preprocessImage(const QImage& original, bool binarize, int fixedScale) {
     if (original.isNull()) {
         return original;
     }
@@ -96,6 +451,9 @@ QImage OCRManager::preprocessImage(const QImage& original) {
     } else if (processed.width() > 1000 || processed.height() > 1000) {
         scale = 2;
     }
+    if (fixedScale > 0) {
+        scale = fixedScale; // 分块识别时沿用整图的缩放倍率，保证各块文字尺寸一致
+    }
     
     if (scale > 1) {
         int targetW = processed.width() * scale;
@@ -109,36 +467,41 @@ QImage OCRManager::preprocessImage(const QImage& original) {
             targetH = sz.height();
         }
 
+        // 平滑缩放会把 Grayscale8 转为 32 位格式，下面的查表与卷积按 8 位灰度逐字节读取，必须转回
         processed = processed.scaled(
             targetW, 
             targetH, 
             Qt::KeepAspectRatio, 
             Qt::SmoothTransformation
-        );
+        ).convertToFormat(QImage::Format_Grayscale8);
     }
+
+    const int w = processed.width();
+    const int h = processed.height();
     
     // 3. 自动反色处理：Tesseract 在白底黑字下表现最好
-    // 简单判断：如果四个角的像素平均值较暗，则认为可能是深色背景
-    int cornerSum = 0;
-    cornerSum += qGray(processed.pixel(0, 0));
-    cornerSum += qGray(processed.pixel(processed.width()-1, 0));
-    cornerSum += qGray(processed.pixel(0, processed.height()-1));
-    cornerSum += qGray(processed.pixel(processed.width()-1, processed.height()-1));
-    if (cornerSum / 4 < 128) {
-        processed.invertPixels();
-    }
+    // 简单判断：如果四个角的像素平均值较暗，则认为可能是深色背景 (反色并入下方查找表)
+    const uchar* topLine = processed.constScanLine(0);
+    const uchar* bottomLine = processed.constScanLine(h - 1);
+    const int cornerSum = topLine[0] + topLine[w - 1] + bottomLine[0] + bottomLine[w - 1];
+    const bool invert = cornerSum / 4 < 128;
 
     // 4. 增强对比度（线性拉伸）
     // 泰语等细笔画文字对二值化和过度的对比度拉伸很敏感，因此我们收窄忽略范围（从 1% 降至 0.5%）
-    int histogram[256] = {0};
-    for (int y = 0; y < processed.height(); ++y) {
-        const uchar* line = processed.constScanLine(y);
-        for (int x = 0; x < processed.width(); ++x) {
-            histogram[line[x]]++;
+    QVector<RowBand> bands = splitRows(h);
+    runBands(bands, [&](RowBand& band) {
+        for (int y = band.begin; y < band.end; ++y) {
+            const uchar* line = processed.constScanLine(y);
+            for (int x = 0; x < w; ++x) band.histogram[line[x]]++;
         }
+    });
+
+    int histogram[256] = {0};
+    for (const RowBand& band : std::as_const(bands)) {
+        for (int i = 0; i < 256; ++i) histogram[invert ? 255 - i : i] += band.histogram[i];
     }
     
-    int totalPixels = processed.width() * processed.height();
+    int totalPixels = w * h;
     int minGray = 0, maxGray = 255;
     int count = 0;
     
@@ -158,131 +521,142 @@ QImage OCRManager::preprocessImage(const QImage& original) {
             break;
         }
     }
-    
-    if (maxGray > minGray) {
-        for (int y = 0; y < processed.height(); ++y) {
-            uchar* line = processed.scanLine(y);
-            for (int x = 0; x < processed.width(); ++x) {
-                int val = line[x];
-                val = (val - minGray) * 255 / (maxGray - minGray);
-                val = qBound(0, val, 255);
-                line[x] = static_cast<uchar>(val);
-            }
+
+    std::array<uchar, 256> lut;
+    for (int v = 0; v < 256; ++v) {
+        int val = invert ? 255 - v : v;
+        if (maxGray > minGray) {
+            val = (val - minGray) * 255 / (maxGray - minGray);
+            val = qBound(0, val, 255);
         }
+        lut[v] = static_cast<uchar>(val);
     }
 
-    // 5. 简单锐化处理 (卷积)
+    // 5. 简单锐化处理 (卷积核 {0,-1,0; -1,5,-1; 0,-1,0}，边缘像素保持不变)
     // 增加文字边缘对比度，有助于 Tesseract 识别彩色变灰度后的细微笔画
-    QImage sharpened = processed;
-    int kernel[3][3] = {
-        {0, -1, 0},
-        {-1, 5, -1},
-        {0, -1, 0}
-    };
-    for (int y = 1; y < processed.height() - 1; ++y) {
-        const uchar* prevLine = processed.constScanLine(y - 1);
-        const uchar* currLine = processed.constScanLine(y);
-        const uchar* nextLine = processed.constScanLine(y + 1);
-        uchar* destLine = sharpened.scanLine(y);
-        for (int x = 1; x < processed.width() - 1; ++x) {
-            int sum = currLine[x] * kernel[1][1]
-                    + prevLine[x] * kernel[0][1] + nextLine[x] * kernel[2][1]
-                    + currLine[x-1] * kernel[1][0] + currLine[x+1] * kernel[1][2];
-            destLine[x] = static_cast<uchar>(qBound(0, sum, 255));
+    // 每个行段只保留 3 行查表后的滚动缓冲，内层循环为纯整数运算，便于编译器向量化
+    QImage sharpened(w, h, QImage::Format_Grayscale8);
+    runBands(bands, [&](RowBand& band) {
+        std::vector<uchar> prev(w), curr(w), next(w);
+        auto mapRow = [&](int y, std::vector<uchar>& dst) {
+            const uchar* src = processed.constScanLine(y);
+            for (int x = 0; x < w; ++x) dst[x] = lut[src[x]];
+        };
+        if (band.begin > 0) mapRow(band.begin - 1, prev);
+        mapRow(band.begin, curr);
+
+        for (int y = band.begin; y < band.end; ++y) {
+            if (y + 1 < h) mapRow(y + 1, next);
+            uchar* dest = sharpened.scanLine(y);
+            if (y == 0 || y == h - 1) {
+                std::memcpy(dest, curr.data(), size_t(w));
+            } else {
+                const uchar* p = prev.data();
+                const uchar* c = curr.data();
+                const uchar* n = next.data();
+                dest[0] = c[0];
+                dest[w - 1] = c[w - 1];
+                for (int x = 1; x < w - 1; ++x) {
+                    const int sum = 5 * c[x] - p[x] - n[x] - c[x - 1] - c[x + 1];
+                    dest[x] = static_cast<uchar>(qBound(0, sum, 255));
+                }
+            }
+            std::swap(prev, curr);
+            std::swap(curr, next);
         }
-    }
+    });
     processed = sharpened;
     
-    // 注意：不再手动调用 Otsu 二值化。
-    // Tesseract 4.0+ 内部的二值化器（基于 Leptonica）在处理具有抗锯齿边缘的灰度图像时表现更好。
+    // 注意：默认不做二值化。
+    // Tesseract 4.0+ 内部的二值化器（基于 Leptonica）在处理具有抗锯齿边缘的灰度图像时表现更好；
+    // 光照不均、带底纹的截图可开启 Sauvola 局部阈值。
+    if (binarize) {
+        processed = sauvolaBinarize(processed);
+    }
     
     return processed;
 }
 
-void OCRManager::recognizeSync(const QImage& image, int contextId) {
+QString OCRManager::recognizeSync(const QImage& image, int contextId, const QString& language, bool binarize,
+                                  const std::atomic<bool>& cancelled, bool* ok) {
     qDebug() << "[OCRManager] recognizeSync: 开始识别 ID:" << contextId 
              << "线程:" << QThread::currentThread();
     
+    QElapsedTimer timer;
+    timer.start();
     QString result;
+    *ok = false;
 
+    if (!cancelled) {
 #ifdef Q_OS_WIN
-    // 优先采用 Tesseract (如果探测到可用)
-    if (m_engineType == EngineType::Tesseract) {
-        result = recognizeWithTesseract(image);
-    } else {
-        result = recognizeWithWindowsOCR(image);
-    }
+        // 优先采用 Tesseract (如果探测到可用)
+        if (m_engineType == EngineType::Tesseract) {
+            result = recognizeWithTesseract(image, language, binarize, cancelled, ok);
+        } else {
+            result = recognizeWithWindowsOCR(image, ok);
+        }
 #else
-    result = "当前平台不支持 OCR 功能";
+        Q_UNUSED(image);
+        Q_UNUSED(language);
+        Q_UNUSED(binarize);
+        result = "当前平台不支持 OCR 功能";
 #endif
-
-    if (result.isEmpty()) {
-        result = "未能从图片中识别出任何文字";
     }
     
     qDebug() << "[OCRManager] recognizeSync: 识别完成 ID:" << contextId 
+             << "耗时(ms):" << timer.elapsed()
              << "结果长度:" << result.length() << "线程:" << QThread::currentThread();
-    emit recognitionFinished(result, contextId);
+    return result;
 }
 
-QString OCRManager::recognizeWithTesseract(const QImage& image) {
-    QString result;
-    // 预处理图像以提高识别准确度
-    QImage processedImage = preprocessImage(image);
-    if (processedImage.isNull()) return "图像无效";
+QString OCRManager::recognizeWithTesseract(const QImage& image, const QString& language, bool binarize,
+                                           const std::atomic<bool>& cancelled, bool* ok) {
+    // 2026-03-xx 按照用户要求：超大图 (长截图、多屏拼接) 按文字区域分块并行识别，不再整体缩小到 4000 像素
+    if (std::max(image.width(), image.height()) > kTileTrigger) {
+        const QImage gray = image.convertToFormat(QImage::Format_Grayscale8);
+        const QList<OcrTile> tiles = planTiles(gray);
+        if (tiles.size() > 1) {
+            // [PERF] 分块按工作者数连续分组，每组一次 recognizeBatch：命令行模式下每组只启动一个 tesseract 进程
+            struct TileGroup {
+                QList<int> indices;
+                QStringList texts;
+                bool ok = false;
+            };
+            const int groupCount = std::min(int(tiles.size()), m_tesseract->maxWorkers());
+            QVector<TileGroup> groups(groupCount);
+            for (int i = 0; i < tiles.size(); ++i) groups[i * groupCount / int(tiles.size())].indices << i;
 
-    QTemporaryFile tempFile(QDir::tempPath() + "/ocr_XXXXXX.bmp");
-    tempFile.setAutoRemove(true);
-    if (!tempFile.open()) return "无法创建临时图像文件";
-    
-    QString filePath = QDir::toNativeSeparators(tempFile.fileName());
-    if (!processedImage.save(filePath, "BMP")) return "无法保存临时图像文件";
-    tempFile.close();
+            QtConcurrent::blockingMap(&m_tilePool, groups, [&](TileGroup& group) {
+                QList<QImage> processed;
+                for (int index : std::as_const(group.indices)) {
+                    if (cancelled) return;
+                    processed << preprocessImage(gray.copy(tiles[index].rect), binarize, 1);
+                }
+                group.texts = m_tesseract->recognizeBatch(processed, language, cancelled, &group.ok);
+            });
 
-    QString tesseractPath = m_cachedTesseractPath;
-    if (tesseractPath.isEmpty()) tesseractPath = findTesseractPath();
-    if (tesseractPath.isEmpty()) return "未找到 Tesseract 引擎";
-
-    QString tessDataPath;
-    QString appPath = QCoreApplication::applicationDirPath();
-    QStringList basePaths = { appPath, QDir(appPath).absolutePath() + "/..", QDir(appPath).absolutePath() + "/../.." };
-    for (const QString& base : basePaths) {
-        QStringList dataPotentials = { base + "/resources/Tesseract-OCR/tessdata", base + "/Tesseract-OCR/tessdata", base + "/tessdata" };
-        for (const QString& p : dataPotentials) { if (QDir(p).exists()) { tessDataPath = QDir(p).absolutePath(); break; } }
-        if (!tessDataPath.isEmpty()) break;
+            QStringList texts;
+            bool allOk = true;
+            for (const TileGroup& group : std::as_const(groups)) {
+                for (int i = 0; i < group.indices.size(); ++i) texts << group.texts.value(i);
+                allOk = allOk && group.ok;
+            }
+            *ok = allOk && !cancelled;
+            qDebug() << "[OCRManager] 分块识别完成，块数:" << tiles.size();
+            return mergeTileTexts(tiles, texts);
+        }
     }
 
-    QProcess tesseract;
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    if (!tessDataPath.isEmpty()) {
-        QDir prefixDir(tessDataPath); prefixDir.cdUp();
-        env.insert("TESSDATA_PREFIX", QDir::toNativeSeparators(prefixDir.absolutePath()));
-    }
-    tesseract.setProcessEnvironment(env);
-
-    QStringList foundLangs;
-    if (!tessDataPath.isEmpty()) {
-        QDir dir(tessDataPath);
-        QStringList files = dir.entryList({"*.traineddata"}, QDir::Files);
-        QStringList priority = QLocale::system().script() == QLocale::TraditionalChineseScript ? 
-            QStringList{"chi_tra", "tha", "eng", "chi_sim"} : QStringList{"chi_sim", "tha", "eng", "chi_tra"};
-        for (const QString& pLang : priority) { if (files.contains(pLang + ".traineddata")) foundLangs << pLang; }
-    }
-    QString currentLang = foundLangs.isEmpty() ? m_language : foundLangs.join('+');
+    // 预处理图像以提高识别准确度
+    QImage processedImage = preprocessImage(image, binarize);
+    if (processedImage.isNull()) return "图像无效";
+    if (cancelled) return QString();
 
-    QStringList args;
-    if (!tessDataPath.isEmpty()) args << "--tessdata-dir" << QDir::toNativeSeparators(tessDataPath);
-    args << filePath << "stdout" << "-l" << currentLang << "--oem" << "1" << "--psm" << "3";
-    
-    tesseract.start(tesseractPath, args);
-    if (tesseract.waitForFinished(20000)) {
-        result = QString::fromUtf8(tesseract.readAllStandardOutput()).trimmed();
-    }
-    return result;
+    return m_tesseract->recognize(processedImage, language, cancelled, ok);
 }
 
 // Windows 原生 OCR 实现 (PowerShell 桥接方案，零编译依赖)
-QString OCRManager::recognizeWithWindowsOCR(const QImage& image) {
+QString OCRManager::recognizeWithWindowsOCR(const QImage& image, bool* ok) {
     qDebug() << "[OCRManager] 正在通过 PowerShell 调用 Windows 原生 OCR 引擎...";
     
     // 1. 将图像保存为临时文件 (Windows OCR 支持多种格式，PNG 即可)
@@ -334,5 +708,6 @@ QString OCRManager::recognizeWithWindowsOCR(const QImage& image) {
         return "Windows OCR 未识别到文字";
     }
 
+    *ok = true;
     return output;
 }
\ No newline at end of file
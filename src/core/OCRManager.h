@@ -3,6 +3,13 @@
 #include <QObject>
 #include <QImage>
 #include <QString>
+#include <QThreadPool>
+#include <QMutex>
+#include <QMultiHash>
+#include <atomic>
+#include <memory>
+
+class TesseractWorkerPool;
 
 class OCRManager : public QObject {
     Q_OBJECT
@@ -15,6 +22,13 @@ public:
 
     static OCRManager& instance();
     void recognizeAsync(const QImage& image, int contextId = -1);
+
+    // 取消排队中或正在识别的请求；被取消的请求仍会发出 recognitionFinished，便于调用方推进队列
+    void cancel(int contextId);
+    void cancelAll();
+
+    // 可同时执行的识别请求数 (与常驻工作者数一致)，调用方据此限制在途请求以便自行安排优先级
+    int maxConcurrentRequests() const { return m_pool.maxThreadCount(); }
     
     // 设置 OCR 识别语言（默认: "chi_sim+eng"）
     // 可用语言见 traineddata 文件，多语言用 + 连接
@@ -22,28 +36,53 @@ public:
     void setLanguage(const QString& lang);
     QString getLanguage() const;
 
+    // 预处理末尾追加 Sauvola 自适应二值化 (默认关闭，适合光照不均或带底纹的图片)
+    void setAdaptiveBinarization(bool enabled);
+    bool adaptiveBinarization() const;
+
     EngineType currentEngine() const { return m_engineType; }
 
+    // 灰度化 + 缩放 + 反色/对比度拉伸 + 锐化 (+ 可选 Sauvola)，输出 Grayscale8；不依赖实例状态，可在任意线程调用
+    // fixedScale > 0 时跳过自动缩放策略，使用给定倍率
+    static QImage preprocessImage(const QImage& original, bool binarize, int fixedScale = 0);
+
 private:
-    void recognizeSync(const QImage& image, int contextId);
-    QImage preprocessImage(const QImage& original);
+    using CancelFlag = std::shared_ptr<std::atomic<bool>>;
+
+    // 预处理算法变化时递增，使旧的 OCR 缓存自然失效 (v4：修复缩放后按 32 位像素误读为灰度)
+    static constexpr int kPreprocessVersion = 4;
+    QString cacheLanguage() const;
+    static QString preprocessTag(bool binarize);
+
+    // 返回原始识别文本；ok 表示引擎正常完成 (可写入缓存)
+    QString recognizeSync(const QImage& image, int contextId, const QString& language, bool binarize,
+                          const std::atomic<bool>& cancelled, bool* ok);
+    void finishRequest(int contextId, const CancelFlag& cancelled, QString text);
     
     // 引擎特定实现
-    QString recognizeWithTesseract(const QImage& image);
-    QString recognizeWithWindowsOCR(const QImage& image);
+    QString recognizeWithTesseract(const QImage& image, const QString& language, bool binarize,
+                                   const std::atomic<bool>& cancelled, bool* ok);
+    QString recognizeWithWindowsOCR(const QImage& image, bool* ok);
     
     // 探测逻辑
     void detectAvailableEngine();
-    QString findTesseractPath();
 
 signals:
     void recognitionFinished(const QString& text, int contextId);
 
 private:
     OCRManager(QObject* parent = nullptr);
+    ~OCRManager();
     QString m_language = "chi_sim+eng"; // 默认中文简体+英文
     EngineType m_engineType = EngineType::Unknown;
-    QString m_cachedTesseractPath;
+    std::atomic<bool> m_adaptiveBinarization{false};
+
+    // [PERF] 常驻识别引擎 + 专用线程池 (线程数与工作者数一致，排队在池中而不是阻塞全局线程池)
+    std::unique_ptr<TesseractWorkerPool> m_tesseract;
+    QThreadPool m_pool;
+    QThreadPool m_tilePool; // 大图分块识别，与请求线程池分开，避免请求线程等待分块时占满线程池
+    QMutex m_inflightMutex;
+    QMultiHash<int, CancelFlag> m_inflight;
 };
 
 #endif // OCRMANAGER_H
\ No newline at end of file
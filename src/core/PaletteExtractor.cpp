@@ -0,0 +1,245 @@
+#include "PaletteExtractor.h"
+#include "ImageHashHelper.h"
+#include <QCache>
+#include <QColor>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+constexpr int kChannelBits = 5;
+constexpr int kBinCount = 1 << (kChannelBits * 3);
+constexpr int kMaxIterations = 16;
+constexpr double kMinDeltaE = 6.0;      // Lab 距离小于该值的簇视为同色，并入占比更大的簇
+constexpr quint32 kSeed = 0x9E3779B9u;  // 固定种子保证调色板可复现
+constexpr int kCacheEntries = 32;
+constexpr int kMinChunkPixels = 256 * 1024;    // 每块直方图约 0.9 MB，小图按像素量限制分块数，避免分配与合并开销超过统计本身
+
+struct Histogram {
+    std::vector<quint32> count;
+    std::vector<quint64> sumR, sumG, sumB;
+
+    Histogram() : count(kBinCount), sumR(kBinCount), sumG(kBinCount), sumB(kBinCount) {}
+
+    void merge(const Histogram& other) {
+        for (int i = 0; i < kBinCount; ++i) {
+            if (!other.count[i]) continue;
+            count[i] += other.count[i];
+            sumR[i] += other.sumR[i];
+            sumG[i] += other.sumG[i];
+            sumB[i] += other.sumB[i];
+        }
+    }
+};
+
+struct Sample {
+    float L, A, B;
+    double weight;
+    double r, g, b;     // 该格像素的平均 RGB，输出色取簇内加权平均，避免 Lab 反变换误差
+};
+
+struct Cluster {
+    double L = 0, A = 0, B = 0;
+    double weight = 0;
+    double r = 0, g = 0, b = 0;
+};
+
+inline float srgbToLinear(double c) {
+    const double v = c / 255.0;
+    return float(v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4));
+}
+
+inline float labF(float t) {
+    return t > 0.008856f ? std::cbrt(t) : 7.787f * t + 16.0f / 116.0f;
+}
+
+// sRGB (D65) -> CIE Lab
+void toLab(double r, double g, double b, float& L, float& A, float& B) {
+    const float lr = srgbToLinear(r), lg = srgbToLinear(g), lb = srgbToLinear(b);
+    const float x = (0.4124f * lr + 0.3576f * lg + 0.1805f * lb) / 0.95047f;
+    const float y =  0.2126f * lr + 0.7152f * lg + 0.0722f * lb;
+    const float z = (0.0193f * lr + 0.1192f * lg + 0.9505f * lb) / 1.08883f;
+    const float fx = labF(x), fy = labF(y), fz = labF(z);
+    L = 116.0f * fy - 16.0f;
+    A = 500.0f * (fx - fy);
+    B = 200.0f * (fy - fz);
+}
+
+inline double distance2(double L1, double A1, double B1, double L2, double A2, double B2) {
+    const double dl = L1 - L2, da = A1 - A2, db = B1 - B2;
+    return dl * dl + da * da + db * db;
+}
+
+Histogram buildHistogram(const QImage& image) {
+    struct Chunk {
+        int begin;
+        int end;
+        Histogram hist;
+    };
+    const int h = image.height();
+    const int minRows = std::max(1, kMinChunkPixels / std::max(1, image.width()));
+    const int chunkCount = std::clamp(std::min(QThread::idealThreadCount(), h / minRows), 1, h);
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        chunks.push_back({h * i / chunkCount, h * (i + 1) / chunkCount, Histogram()});
+    }
+
+    // 每块独立统计后再合并，线程间无共享写入
+    QtConcurrent::blockingMap(chunks, [&image](Chunk& chunk) {
+        const int w = image.width();
+        for (int y = chunk.begin; y < chunk.end; ++y) {
+            const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            for (int x = 0; x < w; ++x) {
+                const QRgb px = line[x];
+                const int r = qRed(px), g = qGreen(px), b = qBlue(px);
+                const int bin = ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+                ++chunk.hist.count[bin];
+                chunk.hist.sumR[bin] += r;
+                chunk.hist.sumG[bin] += g;
+                chunk.hist.sumB[bin] += b;
+            }
+        }
+    });
+
+    for (size_t i = 1; i < chunks.size(); ++i) chunks[0].hist.merge(chunks[i].hist);
+    return std::move(chunks[0].hist);
+}
+
+std::vector<Cluster> kMeans(const std::vector<Sample>& samples, int k) {
+    const int n = int(samples.size());
+    std::vector<Cluster> centers;
+    centers.reserve(k);
+
+    // k-means++ 播种：首个中心取占比最大的格，其余按 权重 * 距离² 的概率选取
+    const auto heaviest = std::max_element(samples.begin(), samples.end(),
+                                           [](const Sample& a, const Sample& b) { return a.weight < b.weight; });
+    centers.push_back({heaviest->L, heaviest->A, heaviest->B});
+    std::vector<double> nearest(n, std::numeric_limits<double>::max());
+    QRandomGenerator rng(kSeed);
+    while (int(centers.size()) < k) {
+        const Cluster& last = centers.back();
+        double total = 0;
+        for (int i = 0; i < n; ++i) {
+            nearest[i] = std::min(nearest[i], distance2(samples[i].L, samples[i].A, samples[i].B, last.L, last.A, last.B));
+            total += samples[i].weight * nearest[i];
+        }
+        if (total <= 0) break;
+        double target = rng.generateDouble() * total;
+        int pick = n - 1;
+        for (int i = 0; i < n; ++i) {
+            target -= samples[i].weight * nearest[i];
+            if (target <= 0) { pick = i; break; }
+        }
+        centers.push_back({samples[pick].L, samples[pick].A, samples[pick].B});
+    }
+
+    std::vector<int> assignment(n, -1);
+    std::vector<Cluster> sums(centers.size());
+    for (int iter = 0; iter < kMaxIterations; ++iter) {
+        bool changed = false;
+        std::fill(sums.begin(), sums.end(), Cluster());
+        for (int i = 0; i < n; ++i) {
+            const Sample& s = samples[i];
+            int best = 0;
+            double bestDist = std::numeric_limits<double>::max();
+            for (int c = 0; c < int(centers.size()); ++c) {
+                const double d = distance2(s.L, s.A, s.B, centers[c].L, centers[c].A, centers[c].B);
+                if (d < bestDist) { bestDist = d; best = c; }
+            }
+            if (assignment[i] != best) { assignment[i] = best; changed = true; }
+            Cluster& acc = sums[best];
+            acc.L += s.L * s.weight; acc.A += s.A * s.weight; acc.B += s.B * s.weight;
+            acc.r += s.r * s.weight; acc.g += s.g * s.weight; acc.b += s.b * s.weight;
+            acc.weight += s.weight;
+        }
+        for (size_t c = 0; c < centers.size(); ++c) {
+            const Cluster& acc = sums[c];
+            if (acc.weight <= 0) continue;
+            centers[c] = {acc.L / acc.weight, acc.A / acc.weight, acc.B / acc.weight,
+                          acc.weight, acc.r / acc.weight, acc.g / acc.weight, acc.b / acc.weight};
+        }
+        if (!changed) break;
+    }
+
+    for (size_t c = 0; c < centers.size(); ++c) {
+        if (sums[c].weight <= 0) centers[c].weight = 0;
+    }
+    return centers;
+}
+
+}
+
+QStringList PaletteExtractor::compute(const QImage& image, int count) {
+    if (image.isNull() || count <= 0) return QStringList();
+
+    const QImage rgb = image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+    const Histogram hist = buildHistogram(rgb);
+
+    std::vector<Sample> samples;
+    for (int i = 0; i < kBinCount; ++i) {
+        const quint32 c = hist.count[i];
+        if (!c) continue;
+        Sample s;
+        s.weight = c;
+        s.r = double(hist.sumR[i]) / c;
+        s.g = double(hist.sumG[i]) / c;
+        s.b = double(hist.sumB[i]) / c;
+        toLab(s.r, s.g, s.b, s.L, s.A, s.B);
+        samples.push_back(s);
+    }
+    if (samples.empty()) return QStringList();
+
+    std::vector<Cluster> clusters;
+    if (int(samples.size()) <= count) {
+        for (const Sample& s : samples) clusters.push_back({s.L, s.A, s.B, s.weight, s.r, s.g, s.b});
+    } else {
+        clusters = kMeans(samples, count);
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.weight > b.weight; });
+
+    // 相近色并入占比更大的簇并累加占比，再按合并后的总占比排序；
+    // 否则被 k-means 拆成几簇的大面积颜色会排在面积更小的单簇颜色之后
+    std::vector<Cluster> kept;
+    for (const Cluster& c : clusters) {
+        if (c.weight <= 0) break;
+        const auto same = std::find_if(kept.begin(), kept.end(), [&c](const Cluster& k) {
+            return distance2(c.L, c.A, c.B, k.L, k.A, k.B) < kMinDeltaE * kMinDeltaE;
+        });
+        if (same == kept.end()) { kept.push_back(c); continue; }
+        // 输出色取合并后的加权平均 RGB；Lab 中心保留大簇的，后续比较仍以它为准
+        const double total = same->weight + c.weight;
+        same->r = (same->r * same->weight + c.r * c.weight) / total;
+        same->g = (same->g * same->weight + c.g * c.weight) / total;
+        same->b = (same->b * same->weight + c.b * c.weight) / total;
+        same->weight = total;
+    }
+    std::stable_sort(kept.begin(), kept.end(), [](const Cluster& a, const Cluster& b) { return a.weight > b.weight; });
+
+    QStringList result;
+    for (const Cluster& c : kept) result << QColor(qRound(c.r), qRound(c.g), qRound(c.b)).name().toUpper();
+    return result;
+}
+
+QStringList PaletteExtractor::extract(const QImage& image, int count) {
+    if (image.isNull() || count <= 0) return QStringList();
+
+    static QMutex cacheMutex;
+    static QCache<QString, QStringList> cache(kCacheEntries);
+    const QString key = ImageHashHelper::pixelHash(image) + QLatin1Char(':') + QString::number(count);
+    {
+        QMutexLocker locker(&cacheMutex);
+        if (const QStringList* cached = cache.object(key)) return *cached;
+    }
+
+    const QStringList palette = compute(image, count);
+    QMutexLocker locker(&cacheMutex);
+    cache.insert(key, new QStringList(palette));
+    return palette;
+}
@@ -0,0 +1,23 @@
+#ifndef PALETTEEXTRACTOR_H
+#define PALETTEEXTRACTOR_H
+
+#include <QImage>
+#include <QStringList>
+
+/**
+ * @brief 图片主色调色板提取
+ * 全分辨率像素先按每通道 5 bit 量化进 32768 格的平坦直方图 (按行分块并行统计，每块至少 256K 像素)，
+ * 再在 Lab 空间对非空格做加权 k-means++ 聚类，相近色自然归入同一簇。
+ * 种子固定，同一张图片结果确定；结果按像素哈希缓存，再次打开同一图片直接返回。
+ * 不依赖 GUI，可在 QtConcurrent 工作线程中调用。
+ */
+class PaletteExtractor {
+public:
+    // 返回 #RRGGBB 大写色值，按像素占比降序
+    static QStringList extract(const QImage& image, int count);
+
+    // 不经缓存直接计算 (extract 的缓存未命中路径，也供测试与基准测试调用)
+    static QStringList compute(const QImage& image, int count);
+};
+
+#endif // PALETTEEXTRACTOR_H
@@ -0,0 +1,111 @@
+#include "PixelRunTable.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+inline bool sameColor(QRgb a, QRgb b) {
+    return ((a ^ b) & 0x00ffffff) == 0;
+}
+
+inline int colorDiff(QRgb a, QRgb b) {
+    return std::abs(qRed(a) - qRed(b)) + std::abs(qGreen(a) - qGreen(b)) + std::abs(qBlue(a) - qBlue(b));
+}
+}
+
+PixelRunTable PixelRunTable::build(const QImage& image, Qt::Orientation orientation) {
+    PixelRunTable table;
+    if (image.isNull() || image.width() > 0xffff || image.height() > 0xffff) return table;
+
+    table.m_image = image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+    table.m_orientation = orientation;
+    const QImage& img = table.m_image;
+    const int w = img.width();
+    const int h = img.height();
+
+    if (orientation == Qt::Horizontal) {
+        table.m_offsets.reserve(size_t(h) + 1);
+        table.m_offsets.push_back(0);
+        for (int y = 0; y < h; ++y) {
+            const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+            table.m_starts.push_back(0);
+            for (int x = 1; x < w; ++x) {
+                if (!sameColor(line[x], line[x - 1])) table.m_starts.push_back(quint16(x));
+            }
+            table.m_offsets.push_back(quint32(table.m_starts.size()));
+        }
+        return table;
+    }
+
+    // 列方向按行主序两遍扫描以保持缓存友好：先统计每列游程数，再按列游标回填
+    std::vector<quint32> counts(size_t(w), 1);
+    for (int y = 1; y < h; ++y) {
+        const QRgb* prev = reinterpret_cast<const QRgb*>(img.constScanLine(y - 1));
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < w; ++x) {
+            if (!sameColor(line[x], prev[x])) ++counts[x];
+        }
+    }
+    table.m_offsets.resize(size_t(w) + 1);
+    table.m_offsets[0] = 0;
+    for (int x = 0; x < w; ++x) table.m_offsets[x + 1] = table.m_offsets[x] + counts[x];
+    table.m_starts.resize(table.m_offsets[w]);
+
+    std::vector<quint32> cursor(table.m_offsets.begin(), table.m_offsets.end() - 1);
+    for (int x = 0; x < w; ++x) table.m_starts[cursor[x]++] = 0;
+    for (int y = 1; y < h; ++y) {
+        const QRgb* prev = reinterpret_cast<const QRgb*>(img.constScanLine(y - 1));
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < w; ++x) {
+            if (!sameColor(line[x], prev[x])) table.m_starts[cursor[x]++] = quint16(y);
+        }
+    }
+    return table;
+}
+
+QRgb PixelRunTable::pixelAt(int line, int pos) const {
+    return m_orientation == Qt::Horizontal
+        ? reinterpret_cast<const QRgb*>(m_image.constScanLine(line))[pos]
+        : reinterpret_cast<const QRgb*>(m_image.constScanLine(pos))[line];
+}
+
+int PixelRunTable::scan(const QImage& image, int x, int y, int dx, int dy, int tolerance) {
+    if (!image.rect().contains(x, y)) return 0;
+    const QRgb origin = image.pixel(x, y);
+    int dist = 0;
+    int curX = x + dx, curY = y + dy;
+    while (image.rect().contains(curX, curY)) {
+        if (colorDiff(image.pixel(curX, curY), origin) > tolerance) break;
+        dist++;
+        curX += dx;
+        curY += dy;
+    }
+    return dist;
+}
+
+int PixelRunTable::distance(int x, int y, int step, int tolerance) const {
+    if (isNull() || !m_image.rect().contains(x, y)) return 0;
+
+    const bool horizontal = m_orientation == Qt::Horizontal;
+    const int line = horizontal ? y : x;
+    const int pos = horizontal ? x : y;
+    const int length = horizontal ? m_image.width() : m_image.height();
+
+    const quint16* begin = m_starts.data() + m_offsets[line];
+    const quint16* end = m_starts.data() + m_offsets[line + 1];
+    // 光标所在游程：最后一个起点 <= pos 的游程
+    const quint16* run = std::upper_bound(begin, end, quint16(pos)) - 1;
+    const QRgb origin = pixelAt(line, pos);
+
+    if (step > 0) {
+        // 当前游程剩余部分与起点同色，直接计入；此后每个游程只需比较一次颜色
+        for (const quint16* next = run + 1; next != end; ++next) {
+            if (colorDiff(pixelAt(line, *next), origin) > tolerance) return *next - pos - 1;
+        }
+        return length - pos - 1;
+    }
+
+    for (const quint16* cur = run; cur != begin; --cur) {
+        if (colorDiff(pixelAt(line, *(cur - 1)), origin) > tolerance) return pos - *cur;
+    }
+    return pos;
+}
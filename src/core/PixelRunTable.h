@@ -0,0 +1,39 @@
+#ifndef PIXELRUNTABLE_H
+#define PIXELRUNTABLE_H
+
+#include <QImage>
+#include <Qt>
+#include <vector>
+
+/**
+ * @brief 截图的行 / 列游程边界表
+ * 每行 (或每列) 记录颜色发生变化的位置，同一游程内像素完全相同。
+ * distance() 先二分定位光标所在游程，再逐游程比较颜色，整段同色区域一步跨过；
+ * 颜色差异以起点颜色为基准，结果与逐像素扫描完全一致。表与容差无关，调整容差无需重建。
+ * 构建只读取像素，可在工作线程中完成。
+ */
+class PixelRunTable {
+public:
+    PixelRunTable() = default;
+
+    static PixelRunTable build(const QImage& image, Qt::Orientation orientation);
+
+    bool isNull() const { return m_image.isNull(); }
+
+    // 从 (x, y) 沿 step (-1 / +1) 方向，与起点 RGB 总差异不超过 tolerance 的连续像素数
+    int distance(int x, int y, int step, int tolerance) const;
+
+    // 逐像素扫描的参考实现 (表尚未建好时的回退路径，也是 distance() 的正确性基准)
+    // 从 (x, y) 沿 (dx, dy) 方向，与起点 RGB 总差异不超过 tolerance 的连续像素数
+    static int scan(const QImage& image, int x, int y, int dx, int dy, int tolerance);
+
+private:
+    QRgb pixelAt(int line, int pos) const;
+
+    QImage m_image;                     // Format_RGB32，与源图隐式共享
+    Qt::Orientation m_orientation = Qt::Horizontal;
+    std::vector<quint32> m_offsets;     // 第 i 行 (列) 的游程起点位于 m_starts[m_offsets[i] .. m_offsets[i + 1])
+    std::vector<quint16> m_starts;      // 游程起点坐标，每行 (列) 升序且首项为 0
+};
+
+#endif // PIXELRUNTABLE_H
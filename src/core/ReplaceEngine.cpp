@@ -0,0 +1,286 @@
+#include "ReplaceEngine.h"
+#include "ContentSearcher.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+namespace {
+constexpr int kMaxIoThreads = 4;
+const char* const kBackupPrefix = "_backup_";
+
+QByteArray sha256Hex(const QByteArray& data) {
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+}
+
+bool writeAtomically(const QString& path, const QByteArray& data) {
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    if (out.write(data) != data.size()) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+
+// 追加式日志：每行一个 JSON 对象，写完立即 flush，崩溃后最多丢失最后一行
+class Journal {
+public:
+    explicit Journal(const QString& path) : m_file(path) {}
+    bool open() { return m_file.open(QIODevice::WriteOnly | QIODevice::Append); }
+
+    bool append(const QJsonObject& entry) {
+        QMutexLocker locker(&m_mutex);
+        QByteArray line = QJsonDocument(entry).toJson(QJsonDocument::Compact);
+        line.append('\n');
+        if (m_file.write(line) != line.size()) return false;
+        return m_file.flush();
+    }
+
+private:
+    QFile m_file;
+    QMutex m_mutex;
+};
+
+// 按哈希寻址的备份目录：同一次替换中内容相同的文件只写一份 blob。
+// 首个线程负责写入，其余线程等待其结果，不会有多个 QSaveFile 同时写同一路径
+class BlobStore {
+public:
+    explicit BlobStore(const QString& dir) : m_dir(dir) {}
+
+    bool store(const QByteArray& hash, const QByteArray& data) {
+        std::promise<bool> promise;
+        std::shared_future<bool> result;
+        bool isWriter = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            auto it = m_writes.constFind(hash);
+            if (it != m_writes.constEnd()) {
+                result = it.value();
+            } else {
+                result = promise.get_future().share();
+                m_writes.insert(hash, result);
+                isWriter = true;
+            }
+        }
+        if (isWriter) {
+            const QString path = m_dir + "/" + QString::fromLatin1(hash);
+            promise.set_value(QFileInfo::exists(path) || writeAtomically(path, data));
+        }
+        return result.get();
+    }
+
+private:
+    QString m_dir;
+    QMutex m_mutex;
+    QHash<QByteArray, std::shared_future<bool>> m_writes;
+};
+
+enum class ReplaceOutcome { Unchanged, Modified, Failed };
+
+struct ReplaceJob {
+    ReplaceEngine::Options options;
+    BlobStore* blobs = nullptr;
+    Journal* journal = nullptr;
+    QRegularExpression pattern; // 仅不区分大小写时使用
+};
+
+ReplaceOutcome replaceFile(const ReplaceJob& job, const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return ReplaceOutcome::Failed;
+    const QByteArray original = file.readAll();
+    file.close();
+    if (original.isEmpty()) return ReplaceOutcome::Unchanged;
+
+    int bomLength = 0;
+    const TextEncoding encoding = ContentSearcher::detectEncoding(original.constData(), original.size(), &bomLength);
+    if (encoding == TextEncoding::Binary) return ReplaceOutcome::Unchanged;
+
+    // 按原始字节解码 (不使用 QIODevice::Text)，保留原有换行符
+    const QByteArray body = original.mid(bomLength);
+    QStringDecoder decoder = ContentSearcher::decoderFor(encoding);
+    QString content = decoder.decode(body);
+    if (decoder.hasError()) return ReplaceOutcome::Unchanged;
+
+    const Qt::CaseSensitivity cs = job.options.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    if (!content.contains(job.options.keyword, cs)) return ReplaceOutcome::Unchanged;
+
+    // 编码往返不一致的文件 (如代码页无法表示的字节) 不做改写，避免静默损坏
+    QStringEncoder encoder = ContentSearcher::encoderFor(encoding);
+    if (QByteArray(encoder.encode(content)) != body) return ReplaceOutcome::Failed;
+
+    if (job.options.caseSensitive) content.replace(job.options.keyword, job.options.replaceText);
+    else content.replace(job.pattern, job.options.replaceText);
+
+    QStringEncoder outEncoder = ContentSearcher::encoderFor(encoding);
+    QByteArray updated = QByteArray(outEncoder.encode(content));
+    if (outEncoder.hasError()) return ReplaceOutcome::Failed;
+    updated.prepend(original.left(bomLength));
+    if (updated == original) return ReplaceOutcome::Unchanged;
+
+    // 1. 原内容写入按哈希寻址的备份
+    const QByteArray oldHash = sha256Hex(original);
+    if (!job.blobs->store(oldHash, original)) return ReplaceOutcome::Failed;
+
+    // 2. 预写日志：先落盘 write 记录，再动目标文件
+    const QString absPath = QFileInfo(filePath).absoluteFilePath();
+    QJsonObject entry{
+        {"op", "write"},
+        {"path", absPath},
+        {"old", QString::fromLatin1(oldHash)},
+        {"new", QString::fromLatin1(sha256Hex(updated))}
+    };
+    if (!job.journal->append(entry)) return ReplaceOutcome::Failed;
+
+    // 3. 临时文件 + 原子重命名
+    if (!writeAtomically(filePath, updated)) return ReplaceOutcome::Failed;
+    job.journal->append(QJsonObject{{"op", "commit"}, {"path", absPath}});
+    return ReplaceOutcome::Modified;
+}
+}
+
+ReplaceEngine::ReplaceEngine(QObject* parent) : QObject(parent) {
+    m_ioPool.setMaxThreadCount(std::min(kMaxIoThreads, std::max(1, QThread::idealThreadCount())));
+}
+
+ReplaceEngine::~ReplaceEngine() {
+    m_job.waitForFinished();
+}
+
+QString ReplaceEngine::journalPath(const QString& backupDir) {
+    return backupDir + "/journal.jsonl";
+}
+
+void ReplaceEngine::start(const Options& options) {
+    if (m_running) return;
+    m_running = true;
+
+    m_job = QtConcurrent::run([this, options]() {
+        const QString backupDirName = kBackupPrefix + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+        QDir root(options.rootDir);
+        const QString backupDir = root.absoluteFilePath(backupDirName);
+        const QString blobDir = backupDir + "/blobs";
+
+        Journal journal(journalPath(backupDir));
+        if (!QDir().mkpath(blobDir) || !journal.open()) {
+            QMetaObject::invokeMethod(this, [this]() {
+                m_running = false;
+                emit replaceFinished(0, 0, QString());
+            });
+            return;
+        }
+        journal.append(QJsonObject{
+            {"op", "begin"},
+            {"root", root.absolutePath()},
+            {"keyword", options.keyword},
+            {"replace", options.replaceText},
+            {"caseSensitive", options.caseSensitive}
+        });
+
+        // 先枚举文件；根目录下所有 _backup_* 目录 (含本次) 都不参与替换，避免改写备份内容
+        QStringList files;
+        SearchFileFilter filter(options.filter, options.ignoreDirs);
+        filter.forEachFile(options.rootDir, [&](const QString& filePath) {
+            if (!root.relativeFilePath(filePath).startsWith(kBackupPrefix)) files << filePath;
+            return true;
+        });
+
+        BlobStore blobs(blobDir);
+        ReplaceJob job;
+        job.options = options;
+        job.blobs = &blobs;
+        job.journal = &journal;
+        if (!options.caseSensitive) {
+            job.pattern = QRegularExpression(QRegularExpression::escape(options.keyword), QRegularExpression::CaseInsensitiveOption);
+        }
+
+        std::atomic<int> modified{0};
+        std::atomic<int> failed{0};
+        QtConcurrent::blockingMap(&m_ioPool, files, [&](const QString& filePath) {
+            switch (replaceFile(job, filePath)) {
+                case ReplaceOutcome::Modified: ++modified; break;
+                case ReplaceOutcome::Failed: ++failed; break;
+                default: break;
+            }
+        });
+
+        journal.append(QJsonObject{{"op", "end"}, {"modified", modified.load()}, {"failed", failed.load()}});
+
+        const int modifiedFiles = modified;
+        const int failedFiles = failed;
+        QMetaObject::invokeMethod(this, [this, modifiedFiles, failedFiles, backupDir]() {
+            m_running = false;
+            emit replaceFinished(modifiedFiles, failedFiles, backupDir);
+        });
+    });
+}
+
+void ReplaceEngine::undo(const QString& backupDir) {
+    if (m_running) return;
+    m_running = true;
+
+    m_job = QtConcurrent::run([this, backupDir]() {
+        struct WriteEntry {
+            QString path;
+            QByteArray oldHash;
+            QByteArray newHash;
+        };
+        QList<WriteEntry> entries;
+
+        // 只依赖 write 记录：即使 commit 未落盘 (崩溃于重命名之后)，哈希比对也能判断实际状态
+        QFile journal(journalPath(backupDir));
+        if (journal.open(QIODevice::ReadOnly)) {
+            QSet<QString> seen;
+            while (!journal.atEnd()) {
+                const QJsonObject obj = QJsonDocument::fromJson(journal.readLine()).object();
+                if (obj.value("op").toString() != "write") continue;
+                const QString path = obj.value("path").toString();
+                if (path.isEmpty() || seen.contains(path)) continue;
+                seen.insert(path);
+                entries.append({path, obj.value("old").toString().toLatin1(), obj.value("new").toString().toLatin1()});
+            }
+        }
+
+        std::atomic<int> restored{0};
+        std::atomic<int> skipped{0};
+        std::atomic<int> conflicts{0};
+        const QString blobDir = backupDir + "/blobs";
+        QtConcurrent::blockingMap(&m_ioPool, entries, [&](const WriteEntry& e) {
+            QFile current(e.path);
+            if (!current.open(QIODevice::ReadOnly)) { ++conflicts; return; }
+            const QByteArray currentHash = sha256Hex(current.readAll());
+            current.close();
+
+            if (currentHash == e.oldHash) { ++skipped; return; }  // 已是原内容 (重复撤销或替换未生效)
+            if (currentHash != e.newHash) { ++conflicts; return; } // 替换后又被修改过，不覆盖
+
+            QFile blob(blobDir + "/" + QString::fromLatin1(e.oldHash));
+            if (!blob.open(QIODevice::ReadOnly)) { ++conflicts; return; }
+            const QByteArray original = blob.readAll();
+            if (sha256Hex(original) != e.oldHash || !writeAtomically(e.path, original)) { ++conflicts; return; }
+            ++restored;
+        });
+
+        const int restoredFiles = restored;
+        const int skippedFiles = skipped;
+        const int conflictFiles = conflicts;
+        QMetaObject::invokeMethod(this, [this, restoredFiles, skippedFiles, conflictFiles]() {
+            m_running = false;
+            emit undoFinished(restoredFiles, skippedFiles, conflictFiles);
+        });
+    });
+}
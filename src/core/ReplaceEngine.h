@@ -0,0 +1,51 @@
+#ifndef REPLACEENGINE_H
+#define REPLACEENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QFuture>
+
+/**
+ * @brief 事务化的批量替换 / 撤销
+ *
+ * 每次替换在根目录下生成 _backup_<时间戳>/：
+ *   - blobs/<sha256>   原文件内容，按哈希寻址 (相同内容只存一份)
+ *   - journal.jsonl    预写日志，每个文件一条 write (path, old, new) 与一条 commit
+ * 目标文件先写临时文件再原子替换 (QSaveFile)，进程中途崩溃也不会留下半截文件。
+ * 撤销按日志中的绝对路径逐个比对当前哈希：等于 new 才恢复，等于 old 视为已恢复，
+ * 其余视为被外部修改而跳过，因此撤销可以重复执行、中断后可继续。
+ */
+class ReplaceEngine : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        QString rootDir;
+        QString keyword;
+        QString replaceText;
+        QString filter;
+        QStringList ignoreDirs;
+        bool caseSensitive = false;
+    };
+
+    explicit ReplaceEngine(QObject* parent = nullptr);
+    ~ReplaceEngine();
+
+    void start(const Options& options);
+    void undo(const QString& backupDir);
+    bool isRunning() const { return m_running; }
+
+    static QString journalPath(const QString& backupDir);
+
+signals:
+    void replaceFinished(int modifiedFiles, int failedFiles, const QString& backupDir);
+    void undoFinished(int restoredFiles, int skippedFiles, int conflictFiles);
+
+private:
+    QThreadPool m_ioPool; // 限制同时读写的文件数，避免机械盘/网络盘上随机 I/O 抖动
+    QFuture<void> m_job;
+    bool m_running = false;
+};
+
+#endif // REPLACEENGINE_H
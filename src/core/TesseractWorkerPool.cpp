@@ -0,0 +1,267 @@
+#include "TesseractWorkerPool.h"
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLocale>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <utility>
+
+#ifdef USE_LIBTESSERACT
+#include <tesseract/baseapi.h>
+#include <tesseract/ocrclass.h>
+#endif
+
+namespace {
+constexpr int kTimeoutMs = 20000;
+constexpr int kPollMs = 50;
+
+#ifndef USE_LIBTESSERACT
+// 运行一次 tesseract 命令行：input 为 "stdin" 时 payload 经管道写入，否则为图像或列表文件路径。
+// 分段等待以便及时响应取消；超时或取消时结束进程并返回空，finished 表示进程正常退出且返回 0
+QByteArray runCli(const TesseractWorkerPool::Environment& env, const QString& input, const QByteArray& payload,
+                  const QString& language, const std::atomic<bool>& cancelled, int timeoutMs, bool* finished) {
+    *finished = false;
+    QProcess tesseract;
+    if (!env.tessdataDir.isEmpty()) {
+        QProcessEnvironment procEnv = QProcessEnvironment::systemEnvironment();
+        QDir prefixDir(env.tessdataDir);
+        prefixDir.cdUp();
+        procEnv.insert("TESSDATA_PREFIX", QDir::toNativeSeparators(prefixDir.absolutePath()));
+        tesseract.setProcessEnvironment(procEnv);
+    }
+
+    QStringList args;
+    args << input << "stdout";
+    if (!env.tessdataDir.isEmpty()) args << "--tessdata-dir" << QDir::toNativeSeparators(env.tessdataDir);
+    args << "-l" << language << "--oem" << "1" << "--psm" << "3";
+
+    tesseract.start(env.exePath, args);
+    if (!tesseract.waitForStarted()) return QByteArray();
+    if (!payload.isEmpty()) tesseract.write(payload);
+    tesseract.closeWriteChannel();
+
+    QElapsedTimer timer;
+    timer.start();
+    bool exited = false;
+    while (!cancelled && timer.elapsed() < timeoutMs) {
+        if (tesseract.waitForFinished(kPollMs) || tesseract.state() == QProcess::NotRunning) {
+            exited = true;
+            break;
+        }
+    }
+    if (!exited || cancelled) {
+        tesseract.kill();
+        tesseract.waitForFinished();
+        return QByteArray();
+    }
+    *finished = tesseract.exitStatus() == QProcess::NormalExit && tesseract.exitCode() == 0;
+    return tesseract.readAllStandardOutput();
+}
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// 工作者
+// ----------------------------------------------------------------------------
+struct TesseractWorkerPool::Worker {
+#ifdef USE_LIBTESSERACT
+    tesseract::TessBaseAPI api;
+    QString loadedLanguage;
+
+    bool ensureLanguage(const Environment& env, const QString& language) {
+        if (loadedLanguage == language) return true;
+        if (!loadedLanguage.isEmpty()) api.End();
+        loadedLanguage.clear();
+        const QByteArray dataDir = QDir::toNativeSeparators(env.tessdataDir).toLocal8Bit();
+        if (api.Init(dataDir.constData(), language.toUtf8().constData(), tesseract::OEM_LSTM_ONLY) != 0) {
+            qDebug() << "[TesseractWorkerPool] 语言模型加载失败:" << language;
+            return false;
+        }
+        api.SetPageSegMode(tesseract::PSM_AUTO);
+        loadedLanguage = language;
+        return true;
+    }
+
+    ~Worker() {
+        if (!loadedLanguage.isEmpty()) api.End();
+    }
+#endif
+};
+
+// ----------------------------------------------------------------------------
+// TesseractWorkerPool 实现
+// ----------------------------------------------------------------------------
+TesseractWorkerPool::TesseractWorkerPool(int maxWorkers)
+    : m_env(discoverEnvironment()), m_maxWorkers(qMax(1, maxWorkers)) {}
+
+TesseractWorkerPool::~TesseractWorkerPool() = default;
+
+bool TesseractWorkerPool::isAvailable() const {
+#ifdef USE_LIBTESSERACT
+    return !m_env.tessdataDir.isEmpty();
+#else
+    return !m_env.exePath.isEmpty();
+#endif
+}
+
+TesseractWorkerPool::Environment TesseractWorkerPool::discoverEnvironment() {
+    Environment env;
+    const QString appPath = QCoreApplication::applicationDirPath();
+    const QStringList basePaths = { appPath, QDir(appPath).absolutePath() + "/..", QDir(appPath).absolutePath() + "/../.." };
+
+    for (const QString& base : basePaths) {
+        const QStringList exePotentials = {
+            base + "/resources/Tesseract-OCR/tesseract.exe",
+            base + "/Tesseract-OCR/tesseract.exe",
+            base + "/resources/tesseract.exe",
+            base + "/tesseract.exe",
+            "C:/Program Files/Tesseract-OCR/tesseract.exe"
+        };
+        for (const QString& p : exePotentials) {
+            if (QFile::exists(p)) { env.exePath = QDir::toNativeSeparators(p); break; }
+        }
+        if (!env.exePath.isEmpty()) break;
+    }
+
+    for (const QString& base : basePaths) {
+        const QStringList dataPotentials = { base + "/resources/Tesseract-OCR/tessdata", base + "/Tesseract-OCR/tessdata", base + "/tessdata" };
+        for (const QString& p : dataPotentials) {
+            if (QDir(p).exists()) { env.tessdataDir = QDir(p).absolutePath(); break; }
+        }
+        if (!env.tessdataDir.isEmpty()) break;
+    }
+
+    if (!env.tessdataDir.isEmpty()) {
+        const QStringList files = QDir(env.tessdataDir).entryList({"*.traineddata"}, QDir::Files);
+        const QStringList priority = QLocale::system().script() == QLocale::TraditionalChineseScript ?
+            QStringList{"chi_tra", "tha", "eng", "chi_sim"} : QStringList{"chi_sim", "tha", "eng", "chi_tra"};
+        for (const QString& lang : priority) {
+            if (files.contains(lang + ".traineddata")) env.languages << lang;
+        }
+    }
+
+    qDebug() << "[TesseractWorkerPool] 环境探测完成 exe:" << env.exePath
+             << "tessdata:" << env.tessdataDir << "语言:" << env.languages;
+    return env;
+}
+
+QString TesseractWorkerPool::resolveLanguage(const QString& requested) const {
+    return m_env.languages.isEmpty() ? requested : m_env.languages.join('+');
+}
+
+TesseractWorkerPool::Worker* TesseractWorkerPool::acquire() {
+    QMutexLocker locker(&m_mutex);
+    while (m_idle.isEmpty() && int(m_workers.size()) >= m_maxWorkers) {
+        m_idleChanged.wait(&m_mutex);
+    }
+    if (!m_idle.isEmpty()) return m_idle.takeLast();
+    m_workers.push_back(std::make_unique<Worker>());
+    return m_workers.back().get();
+}
+
+void TesseractWorkerPool::release(Worker* worker) {
+    QMutexLocker locker(&m_mutex);
+    m_idle.append(worker);
+    m_idleChanged.wakeOne();
+}
+
+QString TesseractWorkerPool::recognize(const QImage& image, const QString& language, const std::atomic<bool>& cancelled, bool* ok) {
+    if (ok) *ok = false;
+    if (image.isNull() || cancelled) return QString();
+
+    Worker* worker = acquire();
+    QString result;
+
+#ifdef USE_LIBTESSERACT
+    const QImage gray = image.format() == QImage::Format_Grayscale8 ? image : image.convertToFormat(QImage::Format_Grayscale8);
+    if (!cancelled && worker->ensureLanguage(m_env, language)) {
+        worker->api.SetImage(gray.constBits(), gray.width(), gray.height(), 1, int(gray.bytesPerLine()));
+
+        ETEXT_DESC monitor;
+        monitor.cancel = [](void* flag, int) { return static_cast<const std::atomic<bool>*>(flag)->load(); };
+        monitor.cancel_this = const_cast<std::atomic<bool>*>(&cancelled);
+        monitor.set_deadline_msecs(kTimeoutMs);
+
+        if (worker->api.Recognize(&monitor) == 0 && !cancelled) {
+            std::unique_ptr<char[]> text(worker->api.GetUTF8Text());
+            if (text) result = QString::fromUtf8(text.get()).trimmed();
+            if (ok) *ok = true;
+        }
+        worker->api.Clear();
+    }
+#else
+    Q_UNUSED(worker);
+    // 图像经 stdin 传入，BMP 无需压缩编码，Leptonica 可直接从内存读取
+    QByteArray payload;
+    QBuffer buffer(&payload);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "BMP");
+    buffer.close();
+
+    bool finished = false;
+    const QByteArray output = runCli(m_env, "stdin", payload, language, cancelled, kTimeoutMs, &finished);
+    result = QString::fromUtf8(output).trimmed();
+    if (ok) *ok = finished;
+#endif
+
+    release(worker);
+    return result;
+}
+
+QStringList TesseractWorkerPool::recognizeBatch(const QList<QImage>& images, const QString& language,
+                                                const std::atomic<bool>& cancelled, bool* ok) {
+    if (ok) *ok = false;
+    QStringList results;
+    if (images.isEmpty() || cancelled) return results;
+
+#ifndef USE_LIBTESSERACT
+    // [PERF] 命令行模式：整批图像写入临时目录并生成列表文件，一个 tesseract 进程依次识别，
+    // 进程启动与语言模型加载只发生一次。输出按页以换页符 \f 分隔
+    if (images.size() > 1) {
+        QTemporaryDir dir;
+        QByteArray list;
+        bool written = dir.isValid();
+        for (int i = 0; written && i < images.size(); ++i) {
+            const QString path = dir.filePath(QString("page_%1.bmp").arg(i));
+            written = images[i].save(path, "BMP");
+            list += QDir::toNativeSeparators(path).toUtf8() + '\n';
+        }
+        QFile listFile(dir.filePath("pages.txt"));
+        written = written && listFile.open(QIODevice::WriteOnly) && listFile.write(list) == list.size();
+        listFile.close();
+
+        if (written) {
+            Worker* worker = acquire();
+            bool finished = false;
+            const QByteArray output = runCli(m_env, QDir::toNativeSeparators(listFile.fileName()), QByteArray(), language,
+                                             cancelled, kTimeoutMs * int(images.size()), &finished);
+            release(worker);
+            if (cancelled) return results;
+
+            // 部分版本在每页之后追加分隔符，末尾会多出一段空白
+            QStringList pages = QString::fromUtf8(output).split(QChar('\f'));
+            if (pages.size() == images.size() + 1 && pages.last().trimmed().isEmpty()) pages.removeLast();
+            if (finished && pages.size() == images.size()) {
+                for (const QString& page : std::as_const(pages)) results << page.trimmed();
+                if (ok) *ok = true;
+                return results;
+            }
+            qDebug() << "[TesseractWorkerPool] 批量识别输出无法按页拆分，逐张重试 页数:" << images.size();
+        }
+    }
+#endif
+
+    // 进程内引擎常驻，逐张识别即可；命令行模式下批量失败时也在这里逐张回退
+    bool allOk = true;
+    for (const QImage& image : images) {
+        bool imageOk = false;
+        results << recognize(image, language, cancelled, &imageOk);
+        allOk = allOk && imageOk;
+    }
+    if (ok) *ok = allOk && !cancelled;
+    return results;
+}
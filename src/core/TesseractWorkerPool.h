@@ -0,0 +1,62 @@
+#ifndef TESSERACTWORKERPOOL_H
+#define TESSERACTWORKERPOOL_H
+
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 常驻 Tesseract 工作者池
+ *
+ * 定义 USE_LIBTESSERACT 时，每个工作者持有一个进程内 TessBaseAPI，语言模型只在首次使用
+ * (或语言变化) 时加载一次，之后的识别直接复用；取消通过 ETEXT_DESC 回调在识别过程中生效。
+ * 未启用时回退为命令行模式：图像经 stdin 管道传入 (不再落临时文件)，取消时直接结束进程。
+ * 命令行模式下每次 recognize() 仍会启动一个进程并重新加载语言模型，只有 recognizeBatch()
+ * 能把多张图合并到一个进程；“引擎常驻”的收益只属于 RAPIDNOTES_USE_LIBTESSERACT 构建。
+ * 两种模式下 exe / tessdata / 可用语言的探测都只做一次。
+ */
+class TesseractWorkerPool {
+public:
+    struct Environment {
+        QString exePath;         // 命令行模式下的 tesseract 可执行文件
+        QString tessdataDir;     // 找到的 tessdata 目录 (绝对路径)
+        QStringList languages;   // 按系统区域优先级排序的已安装语言
+    };
+
+    explicit TesseractWorkerPool(int maxWorkers);
+    ~TesseractWorkerPool();
+
+    const Environment& environment() const { return m_env; }
+    bool isAvailable() const;
+    int maxWorkers() const { return m_maxWorkers; }
+
+    // tessdata 中找到的语言优先，否则使用调用方给出的语言
+    QString resolveLanguage(const QString& requested) const;
+
+    // 阻塞识别，应在工作线程调用；cancelled 置位后尽快返回空串；ok 表示引擎正常跑完 (超时/失败为 false)
+    QString recognize(const QImage& image, const QString& language, const std::atomic<bool>& cancelled, bool* ok = nullptr);
+    // 批量识别，结果与 images 一一对应；命令行模式下整批只启动一个进程，无法按页拆分时逐张回退
+    QStringList recognizeBatch(const QList<QImage>& images, const QString& language, const std::atomic<bool>& cancelled,
+                               bool* ok = nullptr);
+
+private:
+    struct Worker;
+    static Environment discoverEnvironment();
+    Worker* acquire();
+    void release(Worker* worker);
+
+    Environment m_env;
+    int m_maxWorkers;
+    QMutex m_mutex;
+    QWaitCondition m_idleChanged;
+    QList<Worker*> m_idle;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+};
+
+#endif // TESSERACTWORKERPOOL_H
@@ -0,0 +1,58 @@
+#include "TextMetricsHelper.h"
+#include "../ui/StringUtils.h"
+
+namespace {
+bool isCjk(char32_t ucs4) {
+    switch (QChar::script(ucs4)) {
+        case QChar::Script_Han:
+        case QChar::Script_Hiragana:
+        case QChar::Script_Katakana:
+        case QChar::Script_Hangul:
+        case QChar::Script_Bopomofo:
+            return true;
+        default:
+            return false;
+    }
+}
+}
+
+TextMetrics TextMetricsHelper::compute(const QString& content) {
+    TextMetrics metrics;
+    metrics.plainText = StringUtils::htmlToPlainText(content);
+    // QTextDocument 以 U+2029 表示段落分隔，统一为换行便于显示与导出
+    metrics.plainText.replace(QChar::ParagraphSeparator, u'\n').replace(QChar::LineSeparator, u'\n');
+    metrics.preview = metrics.plainText.left(kPreviewLength * 2).simplified().left(kPreviewLength);
+    countText(metrics.plainText, &metrics.wordCount, &metrics.charCount);
+    return metrics;
+}
+
+void TextMetricsHelper::countText(const QString& plainText, int* wordCount, int* charCount) {
+    int words = 0;
+    int chars = 0;
+    bool inWord = false;
+    const qsizetype len = plainText.size();
+    for (qsizetype i = 0; i < len; ++i) {
+        char32_t ucs4 = plainText.at(i).unicode();
+        if (QChar::isHighSurrogate(ucs4) && i + 1 < len && plainText.at(i + 1).isLowSurrogate()) {
+            ucs4 = QChar::surrogateToUcs4(plainText.at(i), plainText.at(i + 1));
+            ++i;
+        }
+        if (QChar::isSpace(ucs4)) {
+            inWord = false;
+            continue;
+        }
+        ++chars;
+        if (isCjk(ucs4)) {
+            ++words;
+            inWord = false;
+        } else if (QChar::isLetterOrNumber(ucs4) || ucs4 == U'_' || (inWord && (ucs4 == U'\'' || ucs4 == U'-'))) {
+            // 词内的撇号/连字符 (don't、e-mail) 不拆词
+            if (!inWord) ++words;
+            inWord = true;
+        } else {
+            inWord = false;
+        }
+    }
+    if (wordCount) *wordCount = words;
+    if (charCount) *charCount = chars;
+}
@@ -0,0 +1,32 @@
+#ifndef TEXTMETRICSHELPER_H
+#define TEXTMETRICSHELPER_H
+
+#include <QString>
+
+/**
+ * @brief 笔记正文的纯文本与字数统计
+ *
+ * 写入时在 C++ 侧计算一次并落库 (plain_text / preview / word_count / char_count)，
+ * 列表渲染、字数筛选与统计直接读取，不再在查询期用 REPLACE/length 或在渲染期解析 HTML。
+ * 字数口径与常见中文编辑器一致：每个中日韩字符计 1，连续的字母/数字串计 1 个词；
+ * 字符数为去除空白后的码点数。
+ */
+struct TextMetrics {
+    QString plainText;
+    QString preview;     // 空白折叠后的前 kPreviewLength 个字符，供列表/卡片展示
+    int wordCount = 0;
+    int charCount = 0;
+};
+
+class TextMetricsHelper {
+public:
+    // 统计口径变化时递增，后台回填会重新计算 text_version 较低的行
+    static constexpr int kVersion = 1;
+    static constexpr int kPreviewLength = 300;
+
+    // 可在任意线程调用 (QTextDocument 为可重入类)
+    static TextMetrics compute(const QString& content);
+    static void countText(const QString& plainText, int* wordCount, int* charCount);
+};
+
+#endif // TEXTMETRICSHELPER_H
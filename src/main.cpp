@@ -522,7 +522,7 @@ int main(int argc, char *argv[]) {
     // 导致计时器信号无法准时派发。我们将重处理逻辑推入 singleShot(0)，确保事件循环立刻回转。
     QObject::connect(&ClipboardMonitor::instance(), &ClipboardMonitor::newContentDetected, 
         [quickWin](const QString& content, const QString& type, const QByteArray& data,
-            const QString& sourceApp, const QString& sourceTitle){
+            const QString& sourceApp, const QString& sourceTitle, const QString& contentHash){
         
         static bool s_isShowingCopyTip = false;
         if (s_isShowingCopyTip) return;
@@ -592,7 +592,7 @@ int main(int argc, char *argv[]) {
         // 旧方案 singleShot(0) 仍在主线程执行，文件检测/正则/DB写入等耗时操作会阻塞事件循环，
         // 导致 m_hideTimer 的 timeout 信号无法准时派发，表现为 ToolTip 显示 2-3 秒。
         // 新方案使用 QThreadPool 后台线程，主线程仅负责 ToolTip 显示/隐藏。
-        (void)QThreadPool::globalInstance()->start([content, type, data, sourceApp, sourceTitle]() {
+        (void)QThreadPool::globalInstance()->start([content, type, data, sourceApp, sourceTitle, contentHash]() {
             QElapsedTimer heavyClock;
             heavyClock.start();
             qDebug() << "[Clipboard->ToolTip DIAG] 后台线程开始执行";
@@ -725,7 +725,7 @@ int main(int argc, char *argv[]) {
             
             if (!finalType.isEmpty()) {
                 qDebug() << "[Clipboard->ToolTip DIAG] addNoteAsync 准备调用 | 后台线程已耗时 =" << heavyClock.elapsed() << "ms";
-                DatabaseManager::instance().addNoteAsync(title, finalContent, tags, "", catId, finalType, data, sourceApp, sourceTitle);
+                DatabaseManager::instance().addNoteAsync(title, finalContent, tags, "", catId, finalType, data, sourceApp, sourceTitle, "", contentHash);
                 qDebug() << "[Clipboard->ToolTip DIAG] addNoteAsync 返回 | 后台线程总耗时 =" << heavyClock.elapsed() << "ms";
             }
         });
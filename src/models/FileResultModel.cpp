@@ -0,0 +1,338 @@
+#include "FileResultModel.h"
+#include <QRegularExpression>
+#include <QSet>
+#include <QThread>
+#include <QUrl>
+#include <QtConcurrent>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+// FileNameIndex 实现
+// ----------------------------------------------------------------------------
+void FileNameIndex::reserve(int count, int textChars) {
+    m_entries.reserve(count);
+    m_text.reserve(textChars);
+}
+
+void FileNameIndex::append(const QString& name, const QString& path, bool isHidden) {
+    Entry e;
+    e.textOffset = m_text.size();
+    e.nameLength = name.size();
+    e.pathLength = path.size();
+    e.lowerOffset = m_lower.size();
+    e.flags = isHidden ? Hidden : 0;
+
+    m_text.append(name);
+    m_text.append(path);
+    m_lower.append(name.toLower());
+    e.signature = signatureOf(QStringView(m_lower).mid(e.lowerOffset, e.nameLength));
+    m_entries.append(e);
+}
+
+QString FileNameIndex::name(int id) const {
+    const Entry& e = m_entries[id];
+    return m_text.mid(e.textOffset, e.nameLength);
+}
+
+QString FileNameIndex::path(int id) const {
+    const Entry& e = m_entries[id];
+    return m_text.mid(e.textOffset + e.nameLength, e.pathLength);
+}
+
+QStringView FileNameIndex::lowerName(int id) const {
+    const Entry& e = m_entries[id];
+    return QStringView(m_lower).mid(e.lowerOffset, e.nameLength);
+}
+
+quint64 FileNameIndex::signatureOf(QStringView lowerText) {
+    quint64 sig = 0;
+    for (QChar ch : lowerText) {
+        const char16_t c = ch.unicode();
+        int bit;
+        if (c >= u'a' && c <= u'z') bit = c - u'a';
+        else if (c >= u'0' && c <= u'9') bit = 26 + (c - u'0');
+        else bit = 36 + (c % 28); // 其余字符 (含中文) 哈希到高位，只会产生假阳性
+        sig |= (quint64(1) << bit);
+    }
+    return sig;
+}
+
+// ----------------------------------------------------------------------------
+// fzf 风格打分 (v1 算法：正向定位终点 -> 反向收紧起点 -> 区间内打分)
+// ----------------------------------------------------------------------------
+namespace {
+constexpr int kScoreMatch = 16;
+constexpr int kScoreGapStart = -3;
+constexpr int kScoreGapExtension = -1;
+constexpr int kBonusBoundary = kScoreMatch / 2;
+constexpr int kBonusNonWord = kScoreMatch / 2;
+constexpr int kBonusConsecutive = -(kScoreGapStart + kScoreGapExtension);
+constexpr int kBonusFirstCharMultiplier = 2;
+constexpr int kParallelThreshold = 8192; // 候选集小于该值时单线程更快
+
+inline bool isWordChar(char16_t c) {
+    return QChar(c).isLetterOrNumber();
+}
+
+inline int bonusAt(QStringView text, int i) {
+    const char16_t cur = text[i].unicode();
+    if (!isWordChar(cur)) return kBonusNonWord;
+    if (i == 0) return kBonusBoundary;
+    const char16_t prev = text[i - 1].unicode();
+    if (!isWordChar(prev)) return kBonusBoundary;
+    // 字母->数字 切换视为半个边界 (如 v2、log2026)
+    if (QChar(cur).isDigit() && !QChar(prev).isDigit()) return kBonusBoundary / 2;
+    return 0;
+}
+
+struct Hit {
+    int id;
+    int score;
+    int length;
+};
+}
+
+int FileResultModel::fuzzyScore(QStringView text, QStringView pattern) {
+    const int n = text.size();
+    const int m = pattern.size();
+    if (m == 0) return 0;
+    if (m > n) return -1;
+
+    // 1. 正向：找到能完成匹配的最早终点
+    int pidx = 0, end = -1;
+    for (int i = 0; i < n; ++i) {
+        if (text[i] == pattern[pidx]) {
+            if (++pidx == m) { end = i + 1; break; }
+        }
+    }
+    if (end < 0) return -1;
+
+    // 2. 反向：从终点回溯，得到最短的起点
+    pidx = m - 1;
+    int start = 0;
+    for (int i = end - 1; i >= 0; --i) {
+        if (text[i] == pattern[pidx]) {
+            if (--pidx < 0) { start = i; break; }
+        }
+    }
+
+    // 3. 打分：连续命中与单词边界加分，间隙扣分
+    int score = 0;
+    int firstBonus = 0;
+    int consecutive = 0;
+    bool inGap = false;
+    pidx = 0;
+    for (int i = start; i < end; ++i) {
+        if (pidx < m && text[i] == pattern[pidx]) {
+            int bonus = bonusAt(text, i);
+            if (consecutive == 0) {
+                firstBonus = bonus;
+            } else {
+                if (bonus >= kBonusBoundary && bonus > firstBonus) firstBonus = bonus;
+                bonus = std::max({bonus, firstBonus, kBonusConsecutive});
+            }
+            score += kScoreMatch + (pidx == 0 ? bonus * kBonusFirstCharMultiplier : bonus);
+            inGap = false;
+            ++consecutive;
+            ++pidx;
+        } else {
+            score += inGap ? kScoreGapExtension : kScoreGapStart;
+            inGap = true;
+            consecutive = 0;
+            firstBonus = 0;
+        }
+    }
+    return score;
+}
+
+// ----------------------------------------------------------------------------
+// FileResultModel 实现
+// ----------------------------------------------------------------------------
+FileResultModel::FileResultModel(QObject* parent) : QAbstractListModel(parent) {}
+
+int FileResultModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return m_rows.size();
+}
+
+QVariant FileResultModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || !m_index || index.row() >= m_rows.size()) return QVariant();
+    const int id = m_rows[index.row()];
+    switch (role) {
+        case Qt::DisplayRole:
+            return m_index->name(id);
+        case PathRole:
+            return m_index->path(id);
+        default:
+            return QVariant();
+    }
+}
+
+Qt::ItemFlags FileResultModel::flags(const QModelIndex& index) const {
+    Qt::ItemFlags f = QAbstractListModel::flags(index);
+    if (index.isValid()) f |= Qt::ItemIsDragEnabled;
+    return f;
+}
+
+QStringList FileResultModel::mimeTypes() const {
+    return {"text/uri-list", "text/plain"};
+}
+
+QMimeData* FileResultModel::mimeData(const QModelIndexList& indexes) const {
+    auto* mime = new QMimeData();
+    QList<QUrl> urls;
+    QStringList paths;
+    for (const auto& index : indexes) {
+        QString p = index.data(PathRole).toString();
+        if (!p.isEmpty()) {
+            urls << QUrl::fromLocalFile(p);
+            paths << p;
+        }
+    }
+    mime->setUrls(urls);
+    mime->setText(paths.join("\n"));
+    return mime;
+}
+
+void FileResultModel::setIndex(std::shared_ptr<const FileNameIndex> index) {
+    beginResetModel();
+    m_index = std::move(index);
+    m_removed = QVector<bool>(m_index ? m_index->size() : 0, false);
+    m_rows.clear();
+    m_lastQuery = Query();
+    endResetModel();
+}
+
+void FileResultModel::clear() {
+    setIndex(nullptr);
+}
+
+void FileResultModel::setFilter(const QString& text, const QString& ext, bool showHidden) {
+    if (!m_index) return;
+
+    Query q;
+    for (const QString& kw : text.toLower().split(QRegularExpression("[,，]+"), Qt::SkipEmptyParts)) {
+        QString t = kw.trimmed();
+        if (!t.isEmpty()) q.keywords << t;
+    }
+    q.ext = ext;
+    q.showHidden = showHidden;
+    q.isValid = true;
+
+    // [PERF] 增量收窄：查询在上一次基础上追加字符时，只在上一次的命中集合里继续匹配
+    QVector<int> rows = canNarrow(q) ? match(q, &m_rows) : match(q, nullptr);
+
+    beginResetModel();
+    m_rows = std::move(rows);
+    m_lastQuery = q;
+    endResetModel();
+}
+
+bool FileResultModel::canNarrow(const Query& q) const {
+    if (!m_lastQuery.isValid || m_lastQuery.keywords.isEmpty()) return false;
+    if (m_lastQuery.showHidden != q.showHidden || m_lastQuery.ext != q.ext) return false;
+    if (m_lastQuery.keywords.size() != q.keywords.size()) return false;
+    // 多关键字为“或”关系：每个关键字都只能变长，才能保证新结果是旧结果的子集
+    for (int i = 0; i < q.keywords.size(); ++i) {
+        if (!q.keywords[i].startsWith(m_lastQuery.keywords[i])) return false;
+    }
+    return true;
+}
+
+QVector<int> FileResultModel::match(const Query& q, const QVector<int>* candidates) const {
+    const FileNameIndex& index = *m_index;
+    const int total = candidates ? candidates->size() : index.size();
+    const QString extSuffix = q.ext.isEmpty() ? QString() : "." + q.ext;
+
+    QVector<quint64> kwSignatures;
+    kwSignatures.reserve(q.keywords.size());
+    for (const QString& kw : q.keywords) kwSignatures << FileNameIndex::signatureOf(kw);
+
+    // 分片处理 [begin, end)，每个分片各自输出命中，最后合并排序
+    auto processRange = [&](int begin, int end, QVector<Hit>& out) {
+        for (int i = begin; i < end; ++i) {
+            const int id = candidates ? candidates->at(i) : i;
+            if (m_removed[id]) continue;
+            if (!q.showHidden && index.isHidden(id)) continue;
+
+            const QStringView lower = index.lowerName(id);
+            if (!extSuffix.isEmpty() && !lower.endsWith(extSuffix)) continue;
+
+            if (q.keywords.isEmpty()) {
+                out.append({id, 0, int(lower.size())});
+                continue;
+            }
+
+            const quint64 sig = index.signature(id);
+            int best = -1;
+            for (int k = 0; k < q.keywords.size(); ++k) {
+                if ((kwSignatures[k] & sig) != kwSignatures[k]) continue;
+                best = std::max(best, fuzzyScore(lower, q.keywords[k]));
+            }
+            if (best >= 0) out.append({id, best, int(lower.size())});
+        }
+    };
+
+    QVector<Hit> hits;
+    const int threads = std::max(1, QThread::idealThreadCount());
+    if (total < kParallelThreshold || threads == 1) {
+        processRange(0, total, hits);
+    } else {
+        struct Shard {
+            int begin;
+            int end;
+            QVector<Hit> hits;
+        };
+        QVector<Shard> shards;
+        const int shardSize = (total + threads - 1) / threads;
+        for (int b = 0; b < total; b += shardSize) {
+            shards.append({b, std::min(total, b + shardSize), {}});
+        }
+        QtConcurrent::blockingMap(shards, [&](Shard& s) { processRange(s.begin, s.end, s.hits); });
+
+        int count = 0;
+        for (const auto& s : std::as_const(shards)) count += s.hits.size();
+        hits.reserve(count);
+        for (const auto& s : std::as_const(shards)) hits.append(s.hits);
+    }
+
+    // 无关键字时保持扫描阶段的名称排序 (id 顺序)；否则按分数降序、短名优先
+    if (!q.keywords.isEmpty()) {
+        std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+            if (a.score != b.score) return a.score > b.score;
+            if (a.length != b.length) return a.length < b.length;
+            return a.id < b.id;
+        });
+    }
+
+    QVector<int> rows;
+    rows.reserve(hits.size());
+    for (const auto& h : std::as_const(hits)) rows.append(h.id);
+    return rows;
+}
+
+void FileResultModel::removePaths(const QStringList& paths) {
+    if (!m_index || paths.isEmpty()) return;
+    QSet<QString> targets(paths.begin(), paths.end());
+    for (int row = m_rows.size() - 1; row >= 0; --row) {
+        const int id = m_rows[row];
+        if (!targets.contains(m_index->path(id))) continue;
+        m_removed[id] = true;
+        beginRemoveRows(QModelIndex(), row, row);
+        m_rows.removeAt(row);
+        endRemoveRows();
+    }
+}
+
+QString FileResultModel::pathAt(int row) const {
+    if (!m_index || row < 0 || row >= m_rows.size()) return QString();
+    return m_index->path(m_rows[row]);
+}
+
+QStringList FileResultModel::allPaths() const {
+    QStringList paths;
+    if (!m_index) return paths;
+    paths.reserve(m_rows.size());
+    for (int id : m_rows) paths << m_index->path(id);
+    return paths;
+}
@@ -0,0 +1,102 @@
+#ifndef FILERESULTMODEL_H
+#define FILERESULTMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMimeData>
+#include <memory>
+
+/**
+ * @brief 文件名索引：扫描结束后一次性构建的只读快照
+ *
+ * [PERF] 所有文件名/路径连续存放在同一块字符串 Arena 中，小写化名称单独一块，
+ * 每条记录只保存偏移量与 64 位字符签名，避免每次按键对每个文件调用 toLower()。
+ * 构建完成后不再修改，可被多个分片线程无锁并发读取。
+ */
+class FileNameIndex {
+public:
+    enum Flag : quint8 { Hidden = 0x1 };
+
+    void reserve(int count, int textChars);
+    void append(const QString& name, const QString& path, bool isHidden);
+
+    int size() const { return m_entries.size(); }
+    QString name(int id) const;
+    QString path(int id) const;
+    bool isHidden(int id) const { return m_entries[id].flags & Hidden; }
+    QStringView lowerName(int id) const;
+    quint64 signature(int id) const { return m_entries[id].signature; }
+
+    // 字符签名：每种字符(类)占一位，查询签名必须是名称签名的子集才可能匹配
+    static quint64 signatureOf(QStringView lowerText);
+
+private:
+    struct Entry {
+        int textOffset;   // m_text 中 name 起点，path 紧随其后
+        int nameLength;
+        int pathLength;
+        int lowerOffset;  // m_lower 中小写 name 起点 (长度同 nameLength)
+        quint64 signature;
+        quint8 flags;
+    };
+    QVector<Entry> m_entries;
+    QString m_text;
+    QString m_lower;
+};
+
+/**
+ * @brief 文件查找结果模型 (虚拟化列表)
+ *
+ * 只保存命中的索引 id，视图按需取数据，结果数量不再设上限。
+ * 过滤采用 fzf 风格的子序列模糊匹配并打分排序，候选集按 CPU 核数分片并行计算；
+ * 当新查询是上一次查询的延伸时，仅在上一次的命中集合中继续收窄。
+ */
+class FileResultModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles {
+        PathRole = Qt::UserRole // 与旧 QListWidgetItem 的 UserRole 保持一致
+    };
+
+    explicit FileResultModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+
+    // 替换索引快照 (扫描完成/重新扫描时)，同时清空增量缓存
+    void setIndex(std::shared_ptr<const FileNameIndex> index);
+    // keywords 以逗号分隔 (任一命中即可)，ext 为不带点的小写后缀
+    void setFilter(const QString& text, const QString& ext, bool showHidden);
+    void clear();
+
+    // 标记已删除的文件 (不重建索引)，并移除对应行
+    void removePaths(const QStringList& paths);
+
+    QString pathAt(int row) const;
+    QStringList allPaths() const;
+
+    // 供 fuzzy 匹配复用：未命中返回 -1
+    static int fuzzyScore(QStringView text, QStringView pattern);
+
+private:
+    struct Query {
+        QStringList keywords;
+        QString ext;
+        bool showHidden = false;
+        bool isValid = false;
+    };
+    bool canNarrow(const Query& q) const;
+    QVector<int> match(const Query& q, const QVector<int>* candidates) const;
+
+    std::shared_ptr<const FileNameIndex> m_index;
+    QVector<bool> m_removed;
+    QVector<int> m_rows;
+    Query m_lastQuery;
+};
+
+#endif // FILERESULTMODEL_H
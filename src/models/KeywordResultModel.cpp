@@ -0,0 +1,119 @@
+#include "KeywordResultModel.h"
+#include "../ui/IconHelper.h"
+#include <QColor>
+#include <QFileInfo>
+#include <QSet>
+#include <QUrl>
+
+KeywordResultModel::KeywordResultModel(QObject* parent) : QAbstractListModel(parent) {}
+
+int KeywordResultModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return m_rows.size();
+}
+
+QVariant KeywordResultModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_rows.size()) return QVariant();
+
+    const RowRef& ref = m_rows.at(index.row());
+    const FileEntry& file = m_files.at(ref.file);
+    const bool isFile = ref.match < 0;
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            if (isFile) {
+                QString text = QString("%1 (匹配 %2 次)").arg(QFileInfo(file.path).fileName()).arg(file.count);
+                if (file.encoding != "UTF-8") text += QString("  [%1]").arg(file.encoding);
+                return text;
+            }
+            const ContentMatch& m = file.matches.at(ref.match);
+            return QString("    %1: %2").arg(m.line).arg(m.text.trimmed());
+        }
+        case Qt::DecorationRole:
+            return isFile ? IconHelper::getIcon("file", "#E1523D") : QVariant();
+        case Qt::ForegroundRole:
+            return isFile ? QVariant() : QVariant(QColor("#9CDCFE"));
+        case PathRole:
+            return file.path;
+        case IsFileRole:
+            return isFile;
+        case LineRole:
+            return isFile ? 0 : file.matches.at(ref.match).line;
+        case ColumnRole:
+            return isFile ? 0 : file.matches.at(ref.match).column;
+        case ContextRole: {
+            if (isFile) return file.path;
+            const ContentMatch& m = file.matches.at(ref.match);
+            QStringList lines;
+            int lineNo = m.line - m.before.size();
+            for (const QString& l : m.before) lines << QString("  %1  %2").arg(lineNo++, 5).arg(l);
+            lines << QString("> %1  %2").arg(m.line, 5).arg(m.text);
+            lineNo = m.line + 1;
+            for (const QString& l : m.after) lines << QString("  %1  %2").arg(lineNo++, 5).arg(l);
+            return lines.join("\n");
+        }
+        default:
+            return QVariant();
+    }
+}
+
+Qt::ItemFlags KeywordResultModel::flags(const QModelIndex& index) const {
+    Qt::ItemFlags f = QAbstractListModel::flags(index);
+    if (index.isValid()) f |= Qt::ItemIsDragEnabled;
+    return f;
+}
+
+QStringList KeywordResultModel::mimeTypes() const {
+    return {"text/uri-list", "text/plain"};
+}
+
+QMimeData* KeywordResultModel::mimeData(const QModelIndexList& indexes) const {
+    auto* mime = new QMimeData();
+    QList<QUrl> urls;
+    QStringList paths;
+    for (const auto& index : indexes) {
+        QString p = index.data(PathRole).toString();
+        if (!p.isEmpty() && !paths.contains(p)) {
+            urls << QUrl::fromLocalFile(p);
+            paths << p;
+        }
+    }
+    mime->setUrls(urls);
+    mime->setText(paths.join("\n"));
+    return mime;
+}
+
+void KeywordResultModel::appendFile(const QString& path, int count, const QString& encoding, const QList<ContentMatch>& matches) {
+    const int fileIdx = m_files.size();
+    const int first = m_rows.size();
+    beginInsertRows(QModelIndex(), first, first + int(matches.size()));
+    m_files.append({path, encoding, count, matches});
+    m_rows.append({fileIdx, -1});
+    for (int i = 0; i < matches.size(); ++i) m_rows.append({fileIdx, i});
+    endInsertRows();
+}
+
+void KeywordResultModel::removePaths(const QStringList& paths) {
+    if (paths.isEmpty()) return;
+    QSet<QString> targets(paths.begin(), paths.end());
+    // 同一文件的行连续存放，从后往前按区间移除
+    int row = m_rows.size() - 1;
+    while (row >= 0) {
+        const int file = m_rows[row].file;
+        int start = row;
+        while (start > 0 && m_rows[start - 1].file == file) --start;
+        if (targets.contains(m_files[file].path)) {
+            beginRemoveRows(QModelIndex(), start, row);
+            m_rows.remove(start, row - start + 1);
+            endRemoveRows();
+        }
+        row = start - 1;
+    }
+}
+
+void KeywordResultModel::clear() {
+    beginResetModel();
+    m_files.clear();
+    m_rows.clear();
+    endResetModel();
+}
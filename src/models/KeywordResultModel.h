@@ -0,0 +1,57 @@
+#ifndef KEYWORDRESULTMODEL_H
+#define KEYWORDRESULTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QMimeData>
+#include <QVector>
+#include "../core/ContentSearcher.h"
+
+/**
+ * @brief 关键字搜索结果模型 (虚拟化列表)
+ *
+ * 每个命中文件占一行“文件头”，其下紧跟该文件的行级命中。
+ * 结果按文件整块追加，只保存行号/列号与命中片段，视图按可见行取数据。
+ */
+class KeywordResultModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles {
+        PathRole = Qt::UserRole, // 与旧 QListWidgetItem 的 UserRole 保持一致
+        IsFileRole,
+        LineRole,
+        ColumnRole,
+        ContextRole              // 带上下文的多行文本，命中行以 ">" 标记
+    };
+
+    explicit KeywordResultModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+
+    void appendFile(const QString& path, int count, const QString& encoding, const QList<ContentMatch>& matches);
+    void removePaths(const QStringList& paths);
+    void clear();
+
+    int fileCount() const { return m_files.size(); }
+
+private:
+    struct FileEntry {
+        QString path;
+        QString encoding;
+        int count = 0;
+        QList<ContentMatch> matches;
+    };
+    struct RowRef {
+        int file;
+        int match; // -1 表示文件头
+    };
+
+    QList<FileEntry> m_files;
+    QVector<RowRef> m_rows;
+};
+
+#endif // KEYWORDRESULTMODEL_H
@@ -1,10 +1,12 @@
 #include "NoteModel.h"
 #include <QDateTime>
+#include <QSet>
 #include <QRegularExpression>
 #include <QIcon>
 #include "../ui/IconHelper.h"
 #include "../ui/StringUtils.h"
 #include "../core/DatabaseManager.h"
+#include "../core/TextMetricsHelper.h"
 #include <QFileInfo>
 #include <QBuffer>
 #include <QPixmap>
@@ -24,6 +26,16 @@ static QString getIconHtml(const QString& name, const QString& color) {
            .arg(QString(ba.toBase64()));
 }
 
+// [PERF] 纯文本与摘要在写入时已落库 (plain_text / preview)；尚未被后台回填的旧数据退回即时解析
+static bool hasStoredText(const QVariantMap& note) {
+    return note.value("text_version").toInt() >= TextMetricsHelper::kVersion;
+}
+
+static QString storedPlainText(const QVariantMap& note) {
+    if (hasStoredText(note)) return note.value("plain_text").toString();
+    return StringUtils::htmlToPlainText(note.value("content").toString());
+}
+
 NoteModel::NoteModel(QObject* parent) : QAbstractListModel(parent) {
     updateCategoryMap();
 }
@@ -67,7 +79,7 @@ QVariant NoteModel::data(const QModelIndex& index, int role) const {
                 if (m_thumbnailCache.contains(id)) return m_thumbnailCache[id];
                 
                 QImage img;
-                img.loadFromData(note.value("data_blob").toByteArray());
+                img.loadFromData(DatabaseManager::instance().resolveBlob(note));
                 if (!img.isNull()) {
                     // [OPTIMIZATION] 缩略图缓存硬上限 (LRU 近似实现)
                     if (m_thumbnailCache.size() > 100) m_thumbnailCache.clear();
@@ -118,7 +130,7 @@ QVariant NoteModel::data(const QModelIndex& index, int role) const {
                     cleanPath = cleanPath.mid(1, cleanPath.length() - 2);
                 }
 
-                QString plain = StringUtils::htmlToPlainText(content).trimmed();
+                QString plain = storedPlainText(note).trimmed();
                 if (stripped.startsWith("http://") || stripped.startsWith("https://") || stripped.startsWith("www.")) {
                     iconName = "link";
                     iconColor = "#17B345"; // 链接：绿色 (2026-03-xx 用户修改)
@@ -185,11 +197,14 @@ QVariant NoteModel::data(const QModelIndex& index, int role) const {
 
             QString preview;
             if (note.value("item_type").toString() == "image") {
-                QByteArray ba = note.value("data_blob").toByteArray();
-                preview = QString("<img src='data:image/png;base64,%1' width='300'>").arg(QString(ba.toBase64()));
+                QByteArray ba = DatabaseManager::instance().resolveBlob(note);
+                // 旧数据 blob_format 为空，一律按 png 处理
+                QString fmt = note.value("blob_format").toString();
+                if (fmt.isEmpty()) fmt = "png";
+                preview = QString("<img src='data:image/%1;base64,%2' width='300'>").arg(fmt, QString(ba.toBase64()));
             } else {
                 // 2026-03-15 按照用户意图：如果内容与标题重复，则不显示预览区，保持干练
-                QString plainText = StringUtils::htmlToPlainText(content).trimmed();
+                QString plainText = storedPlainText(note).trimmed();
                 if (plainText != title.trimmed()) {
                     preview = plainText.left(400).toHtmlEscaped().replace("\n", "<br>").trimmed();
                     if (plainText.length() > 400) preview += "...";
@@ -251,8 +266,9 @@ QVariant NoteModel::data(const QModelIndex& index, int role) const {
             QString content = note.value("content").toString();
             if (type == "text" || type.isEmpty() || type == "ocr_text" || type == "captured_message" || 
                 type == "file" || type == "folder" || type == "files" || type == "folders") {
-                QString plain = StringUtils::htmlToPlainText(content);
-                QString display = plain.replace('\n', ' ').replace('\r', ' ').trimmed().left(150);
+                QString display = hasStoredText(note)
+                    ? note.value("preview").toString().left(150)
+                    : StringUtils::htmlToPlainText(content).replace('\n', ' ').replace('\r', ' ').trimmed().left(150);
                 if (!display.isEmpty()) return display;
             }
             if (type == "image") return QString("[图片]");
@@ -287,11 +303,14 @@ QVariant NoteModel::data(const QModelIndex& index, int role) const {
         case SourceTitleRole:
             return note.value("source_title");
         case BlobRole:
-            return note.value("data_blob");
+            // 列表查询不再携带图片数据，按 blob_hash 延迟读取 (带缓存)
+            return DatabaseManager::instance().resolveBlob(note);
         case RemarkRole:
             return note.value("remark");
         case PlainContentRole: {
             // [PERF] 极致性能优化：优先使用预处理缓存，彻底消除 Delegate 渲染时的 HTML 解析开销。
+            // 已落库的摘要即为折叠空白后的纯文本开头，足够 Delegate 两行省略显示
+            if (hasStoredText(note)) return note.value("preview");
             int id = note.value("id").toInt();
             if (m_plainContentCache.contains(id)) return m_plainContentCache[id];
             
@@ -364,7 +383,7 @@ QMimeData* NoteModel::mimeData(const QModelIndexList& indexes) const {
             } else {
                 // 文本相关类型
                 if (StringUtils::isHtml(content)) {
-                    plainTexts << StringUtils::htmlToPlainText(content);
+                    plainTexts << storedPlainText(m_notes.at(index.row()));
                     htmlTexts << content;
                 } else {
                     plainTexts << content;
@@ -416,7 +435,76 @@ QMimeData* NoteModel::mimeData(const QModelIndexList& indexes) const {
 }
 
 void NoteModel::setNotes(const QList<QVariantMap>& notes) {
-    updateCategoryMap();
+    // [PERF] 刷新时按 id 增量比对：剪贴板采集触发的刷新通常只有首行插入、末行挤出，
+    // 不再 beginResetModel 丢弃选中项、滚动位置与全部角色缓存，视图也只重排受影响的行
+    QSet<int> newIds;
+    newIds.reserve(notes.size());
+    for (const auto& note : notes) newIds.insert(note.value("id").toInt());
+    if (newIds.size() != notes.size() || notes.size() > kMaxDiffRows || m_notes.size() > kMaxDiffRows) {
+        resetNotes(notes);
+        return;
+    }
+
+    auto idAt = [this](int row) { return m_notes.at(row).value("id").toInt(); };
+
+    // 1. 删除新列表中已不存在的行 (自后向前，连续区间一次删除)
+    for (int row = m_notes.size() - 1; row >= 0;) {
+        if (newIds.contains(idAt(row))) { --row; continue; }
+        const int last = row;
+        while (row >= 0 && !newIds.contains(idAt(row))) invalidateRowCaches(idAt(row--));
+        beginRemoveRows(QModelIndex(), row + 1, last);
+        m_notes.erase(m_notes.begin() + row + 1, m_notes.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    // 2. 按新顺序逐位对齐：已有行移动到位，新行按连续区间插入，内容变化的行只发 dataChanged
+    QSet<int> currentIds;
+    currentIds.reserve(m_notes.size());
+    for (const auto& note : std::as_const(m_notes)) currentIds.insert(note.value("id").toInt());
+
+    int changedFirst = -1;
+    int changedLast = -1;
+    auto flushChanged = [&]() {
+        if (changedFirst < 0) return;
+        emit dataChanged(index(changedFirst, 0), index(changedLast, 0));
+        changedFirst = changedLast = -1;
+    };
+
+    for (int i = 0; i < notes.size(); ++i) {
+        const int id = notes.at(i).value("id").toInt();
+        if (!currentIds.contains(id)) {
+            flushChanged();
+            int end = i;
+            while (end + 1 < notes.size() && !currentIds.contains(notes.at(end + 1).value("id").toInt())) ++end;
+            beginInsertRows(QModelIndex(), i, end);
+            for (int k = i; k <= end; ++k) {
+                m_notes.insert(k, notes.at(k));
+                currentIds.insert(notes.at(k).value("id").toInt());
+            }
+            endInsertRows();
+            i = end;
+            continue;
+        }
+        if (idAt(i) != id) {
+            flushChanged();
+            int from = i + 1;
+            while (idAt(from) != id) ++from;
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+            m_notes.move(from, i);
+            endMoveRows();
+        }
+        if (m_notes.at(i) != notes.at(i)) {
+            m_notes[i] = notes.at(i);
+            invalidateRowCaches(id);
+            if (changedFirst < 0) changedFirst = i;
+            else if (changedLast != i - 1) { flushChanged(); changedFirst = i; }
+            changedLast = i;
+        }
+    }
+    flushChanged();
+}
+
+void NoteModel::resetNotes(const QList<QVariantMap>& notes) {
     m_thumbnailCache.clear();
     m_tooltipCache.clear();
     m_plainContentCache.clear(); // 列表重置时清理缓存，确保数据一致性
@@ -425,12 +513,23 @@ void NoteModel::setNotes(const QList<QVariantMap>& notes) {
     endResetModel();
 }
 
+void NoteModel::invalidateRowCaches(int id) const {
+    m_thumbnailCache.remove(id);
+    m_tooltipCache.remove(id);
+    m_plainContentCache.remove(id);
+}
+
 void NoteModel::updateCategoryMap() {
+    // 仅在分类变更 (categoriesChanged) 时调用，不再随每次列表刷新查询分类表
     auto categories = DatabaseManager::instance().getAllCategories();
     m_categoryMap.clear();
     for (const auto& cat : categories) {
         m_categoryMap[cat["id"].toInt()] = cat["name"].toString();
     }
+    m_tooltipCache.clear();
+    if (!m_notes.isEmpty()) {
+        emit dataChanged(index(0, 0), index(m_notes.size() - 1, 0), {CategoryNameRole, Qt::ToolTipRole});
+    }
 }
 
 // 【新增】函数的具体实现
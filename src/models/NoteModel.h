@@ -38,7 +38,7 @@ public:
     QStringList mimeTypes() const override;
     QMimeData* mimeData(const QModelIndexList& indexes) const override;
 
-    // 全量重置
+    // 按笔记 id 增量比对后更新 (插入/删除/移动/dataChanged)，保留选中项、滚动位置与未变化行的缓存
     void setNotes(const QList<QVariantMap>& notes);
     
     // 【新增】增量插入 (这就是报错缺失的函数！)
@@ -46,6 +46,11 @@ public:
     void updateCategoryMap();
 
 private:
+    // 超过该行数 (或出现重复 id) 时退回全量重置，避免逐行比对的平方级开销
+    static constexpr int kMaxDiffRows = 2000;
+    void resetNotes(const QList<QVariantMap>& notes);
+    void invalidateRowCaches(int id) const;
+
     QList<QVariantMap> m_notes;
     QMap<int, QString> m_categoryMap;
     mutable QMap<int, QIcon> m_thumbnailCache;
@@ -9,6 +9,7 @@
 #include <QScrollArea>
 #include <QTimer>
 #include <QRegularExpression>
+#include <QSet>
 
 AdvancedTagSelector::AdvancedTagSelector(QWidget* parent) 
     : QWidget(parent, Qt::Popup | Qt::FramelessWindowHint | Qt::NoDropShadowWindowHint) 
@@ -104,7 +105,29 @@ AdvancedTagSelector::AdvancedTagSelector(QWidget* parent)
     );
 
     m_tagContainer = new QWidget();
-    m_tagContainer->setStyleSheet("background: transparent;");
+    // 芯片样式统一挂在容器上按 :checked 区分，切换选中状态时无需逐个按钮重设样式表
+    m_tagContainer->setStyleSheet(
+        "QWidget { background: transparent; }"
+        "QPushButton {"
+        "  background-color: #2D2D2D;"
+        "  color: #BBB;"
+        "  border: 1px solid #444;"
+        "  border-radius: 14px;"
+        "  padding: 6px 12px;"
+        "  font-size: 12px;"
+        "  font-family: 'Segoe UI', 'Microsoft YaHei';"
+        "}"
+        "QPushButton:!checked:hover {"
+        "  background-color: #383838;"
+        "  border-color: #666;"
+        "  color: white;"
+        "}"
+        "QPushButton:checked {"
+        "  background-color: #4a90e2;"
+        "  color: white;"
+        "  border: 1px solid #4a90e2;"
+        "}"
+    );
     
     m_flow = new FlowLayout(m_tagContainer, 0, 8, 8);
     scroll->setWidget(m_tagContainer);
@@ -115,6 +138,7 @@ void AdvancedTagSelector::setup(const QList<QVariantMap>& recentTags, const QStr
     m_recentTags = recentTags;
     m_allTags = allTags;
     m_selected = selectedTags;
+    rebuildCountIndex();
     updateList();
 }
 
@@ -128,96 +152,99 @@ void AdvancedTagSelector::setTags(const QStringList& allTags, const QStringList&
         m_recentTags.append(m);
     }
     m_selected = selectedTags;
+    rebuildCountIndex();
     updateList();
 }
 
-void AdvancedTagSelector::updateList() {
-    // 清空现有项
-    QLayoutItem* child;
-    while ((child = m_flow->takeAt(0)) != nullptr) {
-        if (child->widget()) {
-            child->widget()->deleteLater();
-        }
-        delete child;
+void AdvancedTagSelector::rebuildCountIndex() {
+    m_tagCounts.clear();
+    m_tagCounts.reserve(m_recentTags.size());
+    for (const auto& rm : std::as_const(m_recentTags)) {
+        // 与原线性查找一致：同名取第一次出现的计数
+        const QString name = rm["name"].toString();
+        if (!m_tagCounts.contains(name)) m_tagCounts.insert(name, rm["count"].toInt());
     }
+}
+
+QPushButton* AdvancedTagSelector::chipFor(const QString& tag) {
+    if (QPushButton* btn = m_chips.value(tag)) return btn;
+
+    auto* btn = new QPushButton(m_tagContainer);
+    btn->setCheckable(true);
+    btn->setCursor(Qt::PointingHandCursor);
+    btn->setIconSize(QSize(14, 14));
+    btn->setProperty("tag_name", tag);
+    btn->hide();
+    connect(btn, &QPushButton::clicked, this, [this, tag](){ 
+        toggleTag(tag); 
+    });
+    m_flow->addWidget(btn);
+    m_chips.insert(tag, btn);
+    return btn;
+}
 
+void AdvancedTagSelector::updateList() {
     QString filter = m_search->text().trimmed();
-    QString filterLower = filter.toLower();
     
-    QList<QVariantMap> displayList;
+    QStringList displayList;
 
     if (filter.isEmpty()) {
         m_tipsLabel->setText(QString("最近使用 (%1)").arg(m_recentTags.count()));
         
         // 整理显示列表：优先显示已选中的标签（新操作的排在最前）
-        QStringList seen;
+        QSet<QString> seen;
         
         // 1. 已选中的标签（按最后添加顺序逆序，最新添加的在第一位）
         for (int i = m_selected.size() - 1; i >= 0; --i) {
-            QString name = m_selected[i];
+            const QString& name = m_selected[i];
             if (!seen.contains(name)) {
-                QVariantMap m;
-                m["name"] = name;
-                int count = 0;
-                for (const auto& rm : m_recentTags) {
-                    if (rm["name"].toString() == name) {
-                        count = rm["count"].toInt();
-                        break;
-                    }
-                }
-                m["count"] = count;
-                displayList.append(m);
-                seen << name;
+                displayList.append(name);
+                seen.insert(name);
             }
         }
 
         // 2. 数据库返回的其他最近标签
-        for (const auto& rm : m_recentTags) {
+        for (const auto& rm : std::as_const(m_recentTags)) {
             QString name = rm["name"].toString();
             if (!seen.contains(name)) {
-                displayList.append(rm);
-                seen << name;
+                displayList.append(name);
+                seen.insert(name);
             }
         }
     } else {
         // 搜索模式
-        for (const QString& tag : m_allTags) {
-            if (tag.toLower().contains(filterLower)) {
-                QVariantMap m;
-                m["name"] = tag;
-                int count = 0;
-                for (const auto& rm : m_recentTags) {
-                    if (rm["name"].toString() == tag) {
-                        count = rm["count"].toInt();
-                        break;
-                    }
-                }
-                m["count"] = count;
-                displayList.append(m);
+        for (const QString& tag : std::as_const(m_allTags)) {
+            if (tag.contains(filter, Qt::CaseInsensitive)) {
+                displayList.append(tag);
             }
         }
         m_tipsLabel->setText(QString("搜索结果 (%1)").arg(displayList.count()));
     }
 
-    for (const auto& tagData : displayList) {
-        QString tag = tagData["name"].toString();
-        int count = tagData["count"].toInt();
+    // [PERF] 复用芯片：按显示顺序排到布局前部，只对状态变化的芯片更新文本 / 图标，其余隐藏
+    const QSet<QString> selected(m_selected.cbegin(), m_selected.cend());
+    QList<QWidget*> ordered;
+    ordered.reserve(displayList.size());
+    QSet<QPushButton*> visible;
+    visible.reserve(displayList.size());
+    for (const QString& tag : std::as_const(displayList)) {
+        QPushButton* btn = chipFor(tag);
+        const int count = m_tagCounts.value(tag, 0);
+        const bool isSelected = selected.contains(tag);
+        // 以记录的状态而非 isChecked() 判断：点击时按钮已自行切换 checked，但图标尚未更新
+        if (btn->property("tag_count") != QVariant(count) || btn->property("tag_selected") != QVariant(isSelected)) {
+            btn->setProperty("tag_count", count);
+            btn->setProperty("tag_selected", isSelected);
+            updateChipState(btn, isSelected);
+        }
+        ordered.append(btn);
+        visible.insert(btn);
+    }
+    m_flow->moveWidgetsToFront(ordered);
 
-        bool isSelected = m_selected.contains(tag);
-        
-        auto* btn = new QPushButton();
-        btn->setCheckable(true);
-        btn->setChecked(isSelected);
-        btn->setCursor(Qt::PointingHandCursor);
-        btn->setProperty("tag_name", tag);
-        btn->setProperty("tag_count", count);
-        
-        updateChipState(btn, isSelected);
-        
-        connect(btn, &QPushButton::clicked, this, [this, btn, tag](){ 
-            toggleTag(tag); 
-        });
-        m_flow->addWidget(btn);
+    for (QPushButton* btn : std::as_const(m_chips)) {
+        const bool show = visible.contains(btn);
+        if (btn->isHidden() == show) btn->setVisible(show);
     }
 }
 
@@ -228,42 +255,11 @@ void AdvancedTagSelector::updateChipState(QPushButton* btn, bool checked) {
     QString text = name;
     if (count > 0) text += QString(" (%1)").arg(count);
     btn->setText(text);
+    btn->setChecked(checked);
     
     QIcon icon = checked ? IconHelper::getIcon("select", "#ffffff", 14) 
                          : IconHelper::getIcon("clock", "#bbbbbb", 14);
     btn->setIcon(icon);
-    btn->setIconSize(QSize(14, 14));
-
-    if (checked) {
-        btn->setStyleSheet(
-            "QPushButton {"
-            "  background-color: #4a90e2;"
-            "  color: white;"
-            "  border: 1px solid #4a90e2;"
-            "  border-radius: 14px;"
-            "  padding: 6px 12px;"
-            "  font-size: 12px;"
-            "  font-family: 'Segoe UI', 'Microsoft YaHei';"
-            "}"
-        );
-    } else {
-        btn->setStyleSheet(
-            "QPushButton {"
-            "  background-color: #2D2D2D;"
-            "  color: #BBB;"
-            "  border: 1px solid #444;"
-            "  border-radius: 14px;"
-            "  padding: 6px 12px;"
-            "  font-size: 12px;"
-            "  font-family: 'Segoe UI', 'Microsoft YaHei';"
-            "}"
-            "QPushButton:hover {"
-            "  background-color: #383838;"
-            "  border-color: #666;"
-            "  color: white;"
-            "}"
-        );
-    }
 }
 
 void AdvancedTagSelector::toggleTag(const QString& tag) {
@@ -5,6 +5,7 @@
 #include <QStringList>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QVariant>
 #include <QVBoxLayout>
 #include <QLineEdit>
@@ -39,8 +40,12 @@ private:
     void updateList();
     void toggleTag(const QString& tag);
     void updateChipState(QPushButton* btn, bool checked);
+    void rebuildCountIndex();
+    QPushButton* chipFor(const QString& tag);
 
     QList<QVariantMap> m_recentTags;
+    QHash<QString, int> m_tagCounts;       // 标签名 -> 使用次数，替代逐标签线性查找 m_recentTags
+    QHash<QString, QPushButton*> m_chips;  // [PERF] 标签芯片池：刷新列表时只切换显隐 / 顺序 / 状态，不再销毁重建
     QStringList m_allTags;
     QStringList m_selected;
     bool m_confirmed = false;
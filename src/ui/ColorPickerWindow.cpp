@@ -3,6 +3,7 @@
 #include "IconHelper.h"
 #include "StringUtils.h"
 #include "../core/DatabaseManager.h"
+#include "../core/PaletteExtractor.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QApplication>
@@ -29,6 +30,7 @@
 #include <QJsonObject>
 #include <QFile>
 #include <QPainterPath>
+#include <QtConcurrent>
 #include <cmath>
 #include <algorithm>
 #include <QtMath>
@@ -525,6 +527,7 @@ ColorPickerWindow::ColorPickerWindow(QWidget* parent)
     m_favorites = loadFavorites();
     loadWindowSettings();
     initUI();
+    connect(&m_paletteWatcher, &QFutureWatcher<QStringList>::finished, this, &ColorPickerWindow::onPaletteReady);
     QSettings s("RapidNotes", "ColorPicker");
     QString lastColor = s.value("lastColor", "#D64260").toString();
     useColor(lastColor);
@@ -1225,14 +1228,24 @@ void ColorPickerWindow::processImage(const QString& filePath, const QImage& imag
         delete child;
     }
     
-    QStringList colors = extractDominantColors(img, 24);
+    switchView("图片提取");
+
+    // [PERF] 调色板在工作线程中按原图计算，完成后由 onPaletteReady 填充色块；
+    // 连续载入多张图片时 setFuture 会断开旧任务，只展示最后一张的结果
+    m_paletteWatcher.setFuture(QtConcurrent::run([img]() { return PaletteExtractor::extract(img, 24); }));
+}
+
+void ColorPickerWindow::onPaletteReady() {
+    auto* flow = qobject_cast<FlowLayout*>(m_extractGridContainer->layout());
+    if (!flow) return;
+
+    const QStringList colors = m_paletteWatcher.result();
     for (int i = 0; i < colors.size(); ++i) {
         QWidget* tile = createColorTile(m_extractGridContainer, colors[i]);
         flow->addWidget(tile);
     }
     m_extractGridContainer->updateGeometry();
-    
-    switchView("图片提取");
+
     showNotification("图片已加载，调色板生成完毕");
 }
 
@@ -1272,33 +1285,6 @@ void ColorPickerWindow::pasteImage() {
     showNotification("剪贴板中没有图片或格式不支持", true);
 }
 
-QStringList ColorPickerWindow::extractDominantColors(const QImage& img, int num) {
-    // 2026-03-xx 按照用户要求：将变量名 small 修改为 scaledImg，规避 Windows SDK 的 #define small char 冲突
-    QImage scaledImg = img.scaled(120, 120, Qt::IgnoreAspectRatio, Qt::FastTransformation).convertToFormat(QImage::Format_RGB32);
-    QMap<QRgb, int> counts;
-    for (int y = 0; y < scaledImg.height(); ++y) {
-        for (int x = 0; x < scaledImg.width(); ++x) { counts[scaledImg.pixel(x, y)]++; }
-    }
-    QList<QRgb> sorted = counts.keys();
-    std::sort(sorted.begin(), sorted.end(), [&](QRgb a, QRgb b){ return counts[a] > counts[b]; });
-    
-    QStringList result;
-    for (QRgb rgb : sorted) {
-        QColor c(rgb);
-        bool distinct = true;
-        for(const QString& ex : result) {
-            QColor exc(ex);
-            int diff = abs(exc.red() - c.red()) + abs(exc.green() - c.green()) + abs(exc.blue() - c.blue());
-            if(diff < 20) { distinct = false; break; }
-        }
-        if(distinct) {
-            result << c.name().toUpper(); 
-            if (result.size() >= num) break;
-        }
-    }
-    return result;
-}
-
 void ColorPickerWindow::showNotification(const QString& message, bool isError) {
     // [ULTIMATE FIX] 增加防抖，防止连续操作导致的通知堆叠
     static qint64 lastNotifyTime = 0;
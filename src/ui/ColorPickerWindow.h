@@ -12,6 +12,7 @@
 #include <QScrollArea>
 #include <QTimer>
 #include <QFrame>
+#include <QFutureWatcher>
 
 /**
  * @brief 专业颜色管理器 Pro
@@ -60,6 +61,7 @@ private slots:
     // 图片处理
     void processImage(const QString& filePath, const QImage& image = QImage());
     void pasteImage();
+    void onPaletteReady();
 
 private:
     void initUI();
@@ -81,7 +83,6 @@ private:
     QString rgbToHex(int r, int g, int b);
     QColor hexToColor(const QString& hex);
     QString colorToHex(const QColor& c);
-    QStringList extractDominantColors(const QImage& img, int num);
 
     // --- UI 组件 ---
     // 左侧
@@ -119,6 +120,7 @@ private:
 
     // 状态
     QString m_currentImagePath = "";
+    QFutureWatcher<QStringList> m_paletteWatcher; // 后台调色板提取
     // [CRITICAL] 收藏夹列表，持久化存储用户喜爱的颜色。
     QStringList m_favorites;
     QFrame* m_notification = nullptr;
@@ -1,5 +1,6 @@
 #include "Editor.h"
 #include "StringUtils.h"
+#include "../core/DatabaseManager.h"
 #include <QMimeData>
 #include <QFileInfo>
 #include <utility>
@@ -203,7 +204,7 @@ void Editor::setNote(const QVariantMap& note, bool isPreview) {
     QString title = note.value("title").toString();
     QString content = note.value("content").toString();
     QString type = note.value("item_type").toString();
-    QByteArray blob = note.value("data_blob").toByteArray();
+    QByteArray blob = DatabaseManager::instance().resolveBlob(note);
 
     m_edit->clear();
     
@@ -411,7 +412,7 @@ void Editor::togglePreview(bool preview) {
         QString title = m_currentNote.value("title").toString();
         QString content = m_currentNote.value("content").toString();
         QString type = m_currentNote.value("item_type").toString();
-        QByteArray data = m_currentNote.value("data_blob").toByteArray();
+        QByteArray data = DatabaseManager::instance().resolveBlob(m_currentNote);
 
         QString html = StringUtils::generateNotePreviewHtml(title, content, type, data, m_zoomFactor);
         m_preview->setHtml(html);
@@ -443,7 +444,7 @@ bool Editor::eventFilter(QObject* watched, QEvent* event) {
                 QString title = m_currentNote.value("title").toString();
                 QString content = m_currentNote.value("content").toString();
                 QString type = m_currentNote.value("item_type").toString();
-                QByteArray data = m_currentNote.value("data_blob").toByteArray();
+                QByteArray data = DatabaseManager::instance().resolveBlob(m_currentNote);
 
                 if (!title.isEmpty() || !content.isEmpty()) {
                     QString html = StringUtils::generateNotePreviewHtml(title, content, type, data, m_zoomFactor);
@@ -1,6 +1,7 @@
 #include "FileSearchWidget.h"
 #include "FileSearchHistoryPopup.h"
 #include "StringUtils.h"
+#include "../models/FileResultModel.h"
 
 #include "IconHelper.h"
 #include <QVBoxLayout>
@@ -104,17 +105,17 @@ static bool isSupportedFile(const QString& filePath) {
 }
 
 // ----------------------------------------------------------------------------
-// FileResultListWidget 辅助类
+// FileResultListView 辅助类
 // ----------------------------------------------------------------------------
-class FileResultListWidget : public QListWidget {
+class FileResultListView : public QListView {
 public:
-    using QListWidget::QListWidget;
+    using QListView::QListView;
 protected:
     void startDrag(Qt::DropActions supportedActions) override {
-        QList<QListWidgetItem*> items = selectedItems();
-        if (items.isEmpty()) return;
+        QModelIndexList indexes = selectionModel()->selectedRows();
+        if (indexes.isEmpty()) return;
 
-        QMimeData* data = mimeData(items);
+        QMimeData* data = model()->mimeData(indexes);
         if (!data) return;
 
         QDrag* drag = new QDrag(this);
@@ -127,22 +128,6 @@ protected:
         
         drag->exec(supportedActions);
     }
-
-    QMimeData* mimeData(const QList<QListWidgetItem*>& items) const override {
-        QMimeData* mime = new QMimeData();
-        QList<QUrl> urls;
-        QStringList paths;
-        for (auto* item : items) {
-            QString p = item->data(Qt::UserRole).toString();
-            if (!p.isEmpty()) {
-                urls << QUrl::fromLocalFile(p);
-                paths << p;
-            }
-        }
-        mime->setUrls(urls);
-        mime->setText(paths.join("\n"));
-        return mime;
-    }
 };
 
 // ----------------------------------------------------------------------------
@@ -219,24 +204,24 @@ void FileSearchWidget::setupStyles() {
         QSplitter::handle {
             background-color: #333;
         }
-        QListWidget {
+        QListView {
             background-color: #252526; 
             border: 1px solid #333333;
             border-radius: 6px;
             padding: 4px;
         }
-        QListWidget::item {
+        QListView::item {
             height: 30px;
             padding-left: 8px;
             border-radius: 4px;
             color: #CCCCCC;
         }
-        QListWidget::item:selected {
+        QListView::item:selected {
             background-color: #3e3e42; // 2026-03-xx 统一选中色
             border-left: 3px solid #007ACC;
             color: #FFFFFF;
         }
-        QListWidget::item:hover {
+        QListView::item:hover {
             background-color: #2A2D2E;
         }
         QLineEdit {
@@ -372,15 +357,11 @@ void FileSearchWidget::initUI() {
     btnCopyAll->setStyleSheet("QToolButton { border: none; background: transparent; padding: 2px; }"
                                "QToolButton:hover { background-color: #3e3e42; border-radius: 4px; }"); // 2026-03-xx 统一悬停色
     connect(btnCopyAll, &QToolButton::clicked, this, [this](){
-        if (m_fileList->count() == 0) {
+        if (m_resultModel->rowCount() == 0) {
             ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color:#e74c3c;'>[ERR] 结果列表为空</b>"), 700);
             return;
         }
-        QStringList paths;
-        for (int i = 0; i < m_fileList->count(); ++i) {
-            QString p = m_fileList->item(i)->data(Qt::UserRole).toString();
-            if (!p.isEmpty()) paths << p;
-        }
+        QStringList paths = m_resultModel->allPaths();
         if (paths.isEmpty()) return;
         QApplication::clipboard()->setText(paths.join("\n"));
         // 2026-03-13 按照用户要求：提示时长缩短为 700ms
@@ -392,14 +373,19 @@ void FileSearchWidget::initUI() {
     listHeaderLayout->addWidget(btnCopyAll);
     layout->addLayout(listHeaderLayout);
 
-    m_fileList = new FileResultListWidget();
+    // [PERF] 虚拟化列表：模型只保存命中 id，视图按可见行取数据，不再限制 500 条
+    m_resultModel = new FileResultModel(this);
+    m_fileList = new FileResultListView();
+    m_fileList->setModel(m_resultModel);
+    m_fileList->setUniformItemSizes(true);
+    m_fileList->setLayoutMode(QListView::Batched);
     m_fileList->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     m_fileList->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     m_fileList->setSelectionMode(QAbstractItemView::ExtendedSelection);
     m_fileList->setDragEnabled(true);
     m_fileList->setDragDropMode(QAbstractItemView::DragOnly);
     m_fileList->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(m_fileList, &QListWidget::customContextMenuRequested, this, &FileSearchWidget::showFileContextMenu);
+    connect(m_fileList, &QListView::customContextMenuRequested, this, &FileSearchWidget::showFileContextMenu);
     
     auto* actionSelectAll = new QAction(this);
     actionSelectAll->setShortcut(QKeySequence("Ctrl+A"));
@@ -456,8 +442,9 @@ void FileSearchWidget::startScan(const QString& path) {
         m_scanThread->deleteLater();
     }
 
-    m_fileList->clear();
+    m_resultModel->clear();
     m_filesData.clear();
+    m_indexDirty = true;
     m_visibleCount = 0;
     m_hiddenCount = 0;
     m_infoLabel->setText("正在扫描: " + path);
@@ -470,6 +457,7 @@ void FileSearchWidget::startScan(const QString& path) {
 
 void FileSearchWidget::onFileFound(const QString& name, const QString& path, bool isHidden) {
     m_filesData.append({name, path, isHidden});
+    m_indexDirty = true;
     if (isHidden) m_hiddenCount++;
     else m_visibleCount++;
 
@@ -485,73 +473,54 @@ void FileSearchWidget::onScanFinished(int count) {
     std::sort(m_filesData.begin(), m_filesData.end(), [](const FileData& a, const FileData& b){
         return a.name.localeAwareCompare(b.name) < 0;
     });
+    m_indexDirty = true;
 
     refreshList();
 }
 
-void FileSearchWidget::refreshList() {
-    m_fileList->clear();
-    QString fullTxt = m_searchInput->text().toLower();
-    QStringList keywords = fullTxt.split(QRegularExpression("[,，]+"), Qt::SkipEmptyParts);
-    
-    QString ext = m_extInput->text().toLower().trimmed();
-    if (ext.startsWith(".")) ext = ext.mid(1);
-
-    bool showHidden = m_showHiddenCheck->isChecked();
-
-    int limit = 500;
-    int shown = 0;
+void FileSearchWidget::rebuildIndex() {
+    // [PERF] 名称与路径一次性写入连续 Arena，并预先小写化，之后每次按键只做匹配
+    int textChars = 0;
+    for (const auto& data : std::as_const(m_filesData)) textChars += data.name.size() + data.path.size();
 
+    auto index = std::make_shared<FileNameIndex>();
+    index->reserve(m_filesData.size(), textChars);
     for (const auto& data : std::as_const(m_filesData)) {
-        if (!showHidden && data.isHidden) continue;
-        if (!ext.isEmpty() && !data.name.toLower().endsWith("." + ext)) continue;
-        
-        if (!keywords.isEmpty()) {
-            bool found = false;
-            for (const QString& kw : keywords) {
-                if (data.name.toLower().contains(kw.trimmed())) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) continue;
-        }
-
-        auto* item = new QListWidgetItem(data.name);
-        item->setData(Qt::UserRole, data.path);
-        
-        m_fileList->addItem(item);
-        
-        shown++;
-        if (shown >= limit) {
-            auto* warn = new QListWidgetItem("--- 结果过多，仅显示前 500 条 ---");
-            warn->setForeground(QColor(255, 170, 0));
-            warn->setTextAlignment(Qt::AlignCenter);
-            warn->setFlags(Qt::NoItemFlags);
-            m_fileList->addItem(warn);
-            break;
-        }
+        index->append(data.name, data.path, data.isHidden);
     }
+    m_resultModel->setIndex(std::move(index));
+    m_indexDirty = false;
 }
 
-void FileSearchWidget::showFileContextMenu(const QPoint& pos) {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) {
-        auto* item = m_fileList->itemAt(pos);
-        if (item) {
-            item->setSelected(true);
-            selectedItems << item;
-        }
+QStringList FileSearchWidget::selectedPaths() const {
+    QStringList paths;
+    const QModelIndexList rows = m_fileList->selectionModel()->selectedRows();
+    for (const auto& idx : rows) {
+        QString p = idx.data(FileResultModel::PathRole).toString();
+        if (!p.isEmpty()) paths << p;
     }
+    return paths;
+}
 
-    if (selectedItems.isEmpty()) return;
+void FileSearchWidget::refreshList() {
+    if (m_indexDirty) rebuildIndex();
 
-    QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) paths << p;
+    QString ext = m_extInput->text().toLower().trimmed();
+    if (ext.startsWith(".")) ext = ext.mid(1);
+
+    // 关键字拆分、模糊匹配、打分排序与分片并行均由模型完成
+    m_resultModel->setFilter(m_searchInput->text(), ext, m_showHiddenCheck->isChecked());
+}
+
+void FileSearchWidget::showFileContextMenu(const QPoint& pos) {
+    if (!m_fileList->selectionModel()->hasSelection()) {
+        QModelIndex index = m_fileList->indexAt(pos);
+        if (index.isValid()) {
+            m_fileList->selectionModel()->select(index, QItemSelectionModel::Select);
+        }
     }
 
+    QStringList paths = selectedPaths();
     if (paths.isEmpty()) return;
 
     QMenu menu(this);
@@ -559,7 +528,7 @@ void FileSearchWidget::showFileContextMenu(const QPoint& pos) {
     menu.setAttribute(Qt::WA_TranslucentBackground);
     menu.setAttribute(Qt::WA_NoSystemBackground);
     
-    if (selectedItems.size() == 1) {
+    if (paths.size() == 1) {
         QString filePath = paths.first();
         menu.addAction(IconHelper::getIcon("folder", "#F1C40F", 18), "定位文件夹", [filePath](){
             QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(filePath).absolutePath()));
@@ -575,20 +544,20 @@ void FileSearchWidget::showFileContextMenu(const QPoint& pos) {
         menu.addSeparator();
     }
 
-    QString copyPathText = selectedItems.size() > 1 ? "复制选中路径" : "复制完整路径";
+    QString copyPathText = paths.size() > 1 ? "复制选中路径" : "复制完整路径";
     menu.addAction(IconHelper::getIcon("copy", "#2ECC71", 18), copyPathText, [paths](){
         QApplication::clipboard()->setText(paths.join("\n"));
     });
 
     // [USER_REQUEST] 新增“复制文件名”选项，并统一视觉风格
-    QString copyNameText = selectedItems.size() > 1 ? "复制选中文件名" : "复制文件名";
+    QString copyNameText = paths.size() > 1 ? "复制选中文件名" : "复制文件名";
     menu.addAction(IconHelper::getIcon("file_export", "#2ECC71", 18), copyNameText, [paths](){
         QStringList names;
         for (const auto& p : paths) names << QFileInfo(p).fileName();
         QApplication::clipboard()->setText(names.join("\n"));
     });
 
-    QString copyFileText = selectedItems.size() > 1 ? "复制选中文件" : "复制文件";
+    QString copyFileText = paths.size() > 1 ? "复制选中文件" : "复制文件";
     menu.addAction(IconHelper::getIcon("file", "#4A90E2", 18), copyFileText, [this](){ copySelectedFiles(); });
 
     menu.addAction(IconHelper::getIcon("star", "#F1C40F", 18), "收藏文件", this, &FileSearchWidget::onFavoriteFile);
@@ -603,19 +572,12 @@ void FileSearchWidget::showFileContextMenu(const QPoint& pos) {
 }
 
 void FileSearchWidget::onEditFile() {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) {
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color:#e74c3c;'>[ERR] 请先选择要操作的内容</b>"), 700);
         return;
     }
 
-    QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) paths << p;
-    }
-    if (paths.isEmpty()) return;
-
     QSettings settings("SearchTool_Standalone", "ExternalEditor");
     QString editorPath = settings.value("EditorPath").toString();
 
@@ -644,8 +606,8 @@ void FileSearchWidget::onEditFile() {
 }
 
 void FileSearchWidget::copySelectedFiles() {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) {
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color:#e74c3c;'>[ERR] 请先选择要操作的内容</b>"), 700);
         return;
     }
@@ -654,15 +616,7 @@ void FileSearchWidget::copySelectedFiles() {
     if (!verifyExportPermission()) return;
 
     QList<QUrl> urls;
-    QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) {
-            urls << QUrl::fromLocalFile(p);
-            paths << p;
-        }
-    }
-    if (urls.isEmpty()) return;
+    for (const QString& p : std::as_const(paths)) urls << QUrl::fromLocalFile(p);
 
     QMimeData* mimeData = new QMimeData();
     mimeData->setUrls(urls);
@@ -670,23 +624,19 @@ void FileSearchWidget::copySelectedFiles() {
 
     QApplication::clipboard()->setMimeData(mimeData);
 
-    QString msg = selectedItems.size() > 1 ? QString("[OK] 已复制 %1 个文件").arg(selectedItems.size()) : "[OK] 已复制到剪贴板";
+    QString msg = paths.size() > 1 ? QString("[OK] 已复制 %1 个文件").arg(paths.size()) : "[OK] 已复制到剪贴板";
     ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>%1</b>").arg(msg)));
 }
 
 void FileSearchWidget::onCutFile() {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) {
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color:#e74c3c;'>[ERR] 请先选择要操作的内容</b>"), 700);
         return;
     }
 
     QList<QUrl> urls;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) urls << QUrl::fromLocalFile(p);
-    }
-    if (urls.isEmpty()) return;
+    for (const QString& p : std::as_const(paths)) urls << QUrl::fromLocalFile(p);
 
     QMimeData* mimeData = new QMimeData();
     mimeData->setUrls(urls);
@@ -703,39 +653,38 @@ void FileSearchWidget::onCutFile() {
 
     QApplication::clipboard()->setMimeData(mimeData);
 
-    QString msg = selectedItems.size() > 1 ? QString("[OK] 已剪切 %1 个文件").arg(selectedItems.size()) : "[OK] 已剪切到剪贴板";
+    QString msg = paths.size() > 1 ? QString("[OK] 已剪切 %1 个文件").arg(paths.size()) : "[OK] 已剪切到剪贴板";
     ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>%1</b>").arg(msg)));
 }
 
 void FileSearchWidget::onDeleteFile() {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) {
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color:#e74c3c;'>[ERR] 请先选择要操作的内容</b>"), 700);
         return;
     }
 
-    int successCount = 0;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString filePath = item->data(Qt::UserRole).toString();
-        if (filePath.isEmpty()) continue;
-
+    QStringList deleted;
+    for (const QString& filePath : std::as_const(paths)) {
         if (QFile::moveToTrash(filePath)) {
-            successCount++;
+            deleted << filePath;
             for (int i = 0; i < m_filesData.size(); ++i) {
                 if (m_filesData[i].path == filePath) {
                     m_filesData.removeAt(i);
                     break;
                 }
             }
-            delete item; 
         }
     }
+    // 索引快照保持不变，只在模型中标记删除，避免整表重建
+    m_resultModel->removePaths(deleted);
 
+    int successCount = deleted.size();
     if (successCount > 0) {
-        QString msg = selectedItems.size() > 1 ? QString("[OK] %1 个文件已删除").arg(successCount) : "[OK] 文件已删除";
+        QString msg = paths.size() > 1 ? QString("[OK] %1 个文件已删除").arg(successCount) : "[OK] 文件已删除";
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>%1</b>").arg(msg)));
         m_infoLabel->setText(msg);
-    } else if (!selectedItems.isEmpty()) {
+    } else {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color: #e74c3c;'>[ERR] 无法删除文件，请检查是否被占用</b>"));
     }
 }
@@ -835,13 +784,12 @@ void FileSearchWidget::onMergeFiles(const QStringList& filePaths, const QString&
 }
 
 void FileSearchWidget::onMergeSelectedFiles() {
-    auto selectedItems = m_fileList->selectedItems();
-    if (selectedItems.isEmpty()) return;
+    QStringList selected = selectedPaths();
+    if (selected.isEmpty()) return;
 
     QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty() && isSupportedFile(p)) {
+    for (const QString& p : std::as_const(selected)) {
+        if (isSupportedFile(p)) {
             paths << p;
         }
     }
@@ -969,13 +917,8 @@ void FileSearchWidget::clearExtHistory() {
 }
 
 void FileSearchWidget::onFavoriteFile() {
-    auto items = m_fileList->selectedItems();
-    if (items.isEmpty()) return;
-    QStringList paths;
-    for (auto* item : items) {
-        QString path = item->data(Qt::UserRole).toString();
-        if (!path.isEmpty()) paths << path;
-    }
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
     emit requestAddFileFavorite(paths);
 }
 
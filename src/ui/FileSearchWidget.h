@@ -2,7 +2,7 @@
 #define FILESEARCHWIDGET_H
 
 #include <QWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QCheckBox>
@@ -13,6 +13,7 @@
 #include <atomic>
 
 class FileSearchHistoryPopup;
+class FileResultModel;
 
 /**
  * @brief 扫描线程：实现增量扫描与目录剪枝
@@ -97,13 +98,16 @@ private:
     void saveFileFavorites();
     void refreshFileFavoritesList(const QString& filterPath = QString());
     void onMergeFiles(const QStringList& filePaths, const QString& rootPath);
+    void rebuildIndex();
+    QStringList selectedPaths() const;
 
     QLineEdit* m_pathInput;
     QLineEdit* m_searchInput;
     QLineEdit* m_extInput;
     QLabel* m_infoLabel;
     QCheckBox* m_showHiddenCheck;
-    QListWidget* m_fileList;
+    QListView* m_fileList;
+    FileResultModel* m_resultModel = nullptr;
     
     ScannerThread* m_scanThread = nullptr;
     FileSearchHistoryPopup* m_historyPopup = nullptr;
@@ -114,6 +118,7 @@ private:
         bool isHidden;
     };
     QList<FileData> m_filesData;
+    bool m_indexDirty = false; // m_filesData 有新增，下次过滤前需重建索引快照
     int m_visibleCount = 0;
     int m_hiddenCount = 0;
     bool verifyExportPermission(); // 2026-03-20 增加导出前的统一身份验证逻辑
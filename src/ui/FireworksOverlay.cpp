@@ -1,9 +1,10 @@
 #include "FireworksOverlay.h"
 #include <QPainter>
+#include <QPainterPath>
+#include <QRadialGradient>
 #include <QGuiApplication>
 #include <QScreen>
 #include <algorithm>
-#include <QRandomGenerator>
 #include <cmath>
 #include <QDebug>
 #include <QSettings>
@@ -12,87 +13,36 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+// 粒子包围盒外扩：覆盖发光精灵光晕、蝴蝶翅膀、彩纸旋转与矩阵字符的绘制范围
+constexpr int kBoundsMargin = 24;
+constexpr float kGlowScale = 3.0f;      // 光晕半径 = 粒子半径 * 3
+constexpr int kMaxCachedSprites = 1024;
+
 // Helper to get random double in range [min, max)
-static double randomDouble(double min, double max) {
+double randomDouble(double min, double max) {
     return min + QRandomGenerator::global()->generateDouble() * (max - min);
 }
-
-Particle::Particle() : gravity(0), drag(0.92), size(2.0), decay(4.0), alpha(255.0), age(0), 
-    index(0), total(1), rotation(0), spin(0), widthFactor(1.0), phase(0), amp(0) {}
-
-bool Particle::update() {
-    if (style == "butterfly") {
-        pos += vel;
-        vel.setY(vel.y() + gravity);
-        vel *= drag;
-        pos.setX(pos.x() + std::sin(age * 0.2 + phase) * 0.8);
-        alpha -= decay;
-        age++;
-    } else if (style == "dna") {
-        pos.setY(pos.y() + vel.y());
-        age++;
-        double offset = std::sin((pos.y() * 0.05) + phase) * amp;
-        pos.setX(initialPos.x() + offset);
-        alpha = (offset > 0) ? 255.0 : 100.0;
-        if (age > 60) alpha = 0;
-    } else if (style == "lightning") {
-        alpha -= decay;
-    } else if (style == "confetti") {
-        pos += vel;
-        vel.setY(vel.y() + gravity);
-        vel *= drag;
-        rotation += spin;
-        widthFactor = std::abs(std::cos(rotation));
-        alpha -= 2.0;
-    } else if (style == "void") {
-        if (mode == "suck") {
-            pos += vel;
-            double dist = std::sqrt(std::pow(pos.x() - initialPos.x(), 2) + std::pow(pos.y() - initialPos.y(), 2));
-            if (dist < 5) {
-                mode = "boom";
-                double angle = randomDouble(0, M_PI * 2);
-                double speed = randomDouble(2.0, 8.0);
-                vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-                color = Qt::white;
-            }
-        } else {
-            pos += vel;
-            alpha -= 5.0;
-        }
-    } else if (style == "phoenix") {
-        pos += vel;
-        vel.setY(vel.y() + gravity);
-        vel *= drag;
-        if (age > 10 && color.green() > 5) {
-            color.setGreen(color.green() - 5);
-        }
-        alpha -= decay;
-        age++;
-    } else {
-        pos += vel;
-        vel.setY(vel.y() + gravity);
-        vel *= drag;
-        alpha -= decay;
-    }
-    return alpha > 0;
 }
 
 FireworksOverlay* FireworksOverlay::m_instance = nullptr;
 
-FireworksOverlay::FireworksOverlay(QWidget* parent) : QWidget(parent) {
+FireworksOverlay::FireworksOverlay(QWidget* parent)
+    : QWidget(parent), m_flicker(QRandomGenerator::global()->generate()) {
     // 增加 Qt::WindowDoesNotAcceptFocus 以减少 DWM 交互开销
     setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::Tool | Qt::WindowTransparentForInput | Qt::WindowDoesNotAcceptFocus);
     setAttribute(Qt::WA_TranslucentBackground);
     setAttribute(Qt::WA_ShowWithoutActivating);
-    
+
     m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
     connect(m_timer, &QTimer::timeout, this, &FireworksOverlay::animate);
 
     // [NITPICK FIX] 缓存屏幕几何信息
     updateTotalRect();
     connect(qGuiApp, &QGuiApplication::screenAdded, this, &FireworksOverlay::updateTotalRect);
     connect(qGuiApp, &QGuiApplication::screenRemoved, this, &FireworksOverlay::updateTotalRect);
-    
+
     // 2026-03-xx 按照用户要求，解决任务栏闪烁：
     // 初始化即显示并保持，通过不重绘实现逻辑隐藏，避免频繁显隐导致的 DWM 重排和任务栏刷新。
     show();
@@ -116,23 +66,21 @@ void FireworksOverlay::explode(const QPoint& pos) {
     if (geometry() != m_totalRect) {
         setGeometry(m_totalRect);
     }
-    
+
     // show(); // 不再调用 show()，窗口已在构造函数中常驻显示
     QPoint lp = mapFromGlobal(pos);
 
-    QStringList styles = {"neon", "gold", "butterfly", "quantum", "heart", "galaxy", "frozen", "phoenix", 
-                          "matrix", "dna", "lightning", "void", "confetti", "chaos"};
-    QString style = styles.at(QRandomGenerator::global()->bounded(styles.size()));
+    const Style style = Style(QRandomGenerator::global()->bounded(int(StyleCount)));
 
-    int count = 40;
-    if (style == "matrix") count = 15;
-    else if (style == "dna" || style == "lightning" || style == "butterfly") count = 30;
-    else if (style == "heart" || style == "galaxy") count = 60;
+    int total = 40;
+    if (style == Matrix) total = 15;
+    else if (style == Dna || style == Lightning || style == Butterfly) total = 30;
+    else if (style == Heart || style == Galaxy) total = 60;
 
+    // [PERF] 达到粒子上限时只生成剩余容量内的部分；index/total 仍按完整数量计算以保持图案形状
+    const int count = std::min(total, kMaxParticles - m_p.count);
     for (int i = 0; i < count; ++i) {
-        Particle p;
-        initParticle(p, lp, style, i, count);
-        m_particles.append(p);
+        initParticle(m_p.count++, lp, style, i, total);
     }
 
     if (!m_timer->isActive()) {
@@ -140,115 +88,144 @@ void FireworksOverlay::explode(const QPoint& pos) {
     }
 }
 
-void FireworksOverlay::initParticle(Particle& p, const QPoint& pos, const QString& style, int index, int total) {
-    p.pos = pos;
-    p.initialPos = pos;
-    p.style = style;
-    p.index = index;
-    p.total = total;
-    
-    if (style == "butterfly") {
-        double angle = randomDouble(0, M_PI * 2);
-        double speed = randomDouble(1.0, 3.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.gravity = 0.01;
-        p.drag = 0.96;
-        p.color = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 220, 255);
-        p.size = randomDouble(3.0, 5.0);
-        p.decay = 2.0;
-        p.phase = randomDouble(0, M_PI);
-    } else if (style == "matrix") {
-        static QString chars = "01COPYX";
-        p.character = chars.at(QRandomGenerator::global()->bounded(chars.length()));
-        p.vel = QPointF(0, randomDouble(3.0, 6.0));
-        p.color = QColor(0, 255, 70);
-        p.size = QRandomGenerator::global()->bounded(8, 12);
-        p.decay = 5.0;
-    } else if (style == "dna") {
-        p.vel = QPointF(0, -randomDouble(1.0, 3.0));
-        p.phase = (double(index) / total) * 4 * M_PI;
-        p.amp = randomDouble(10.0, 15.0);
-        p.decay = 3.0;
-        p.color = (index % 2 == 0) ? QColor(0, 200, 255) : QColor(255, 0, 150);
-    } else if (style == "lightning") {
-        double angle = randomDouble(0, M_PI * 2);
-        double dist = randomDouble(20.0, 60.0);
-        QPointF target(pos.x() + std::cos(angle) * dist, pos.y() + std::sin(angle) * dist);
-        int steps = 4;
-        for (int i = 0; i < steps; ++i) {
-            double t = double(i + 1) / steps;
-            QPointF next(pos.x() + (target.x() - pos.x()) * t + randomDouble(-10.0, 10.0),
-                         pos.y() + (target.y() - pos.y()) * t + randomDouble(-10.0, 10.0));
-            p.lightningPoints.append(next);
+void FireworksOverlay::initParticle(int i, const QPointF& pos, Style style, int index, int total) {
+    Particles& p = m_p;
+    p.x[i] = p.initX[i] = float(pos.x());
+    p.y[i] = p.initY[i] = float(pos.y());
+    p.vx[i] = p.vy[i] = 0.0f;
+    p.gravity[i] = 0.0f;
+    p.drag[i] = 0.92f;
+    p.size[i] = 2.0f;
+    p.decay[i] = 4.0f;
+    p.alpha[i] = 255.0f;
+    p.rotation[i] = p.spin[i] = 0.0f;
+    p.widthFactor[i] = 1.0f;
+    p.phase[i] = p.amp[i] = 0.0f;
+    p.color[i] = qRgb(255, 255, 255);
+    p.age[i] = 0;
+    p.style[i] = style;
+    p.sucking[i] = false;
+    p.character[i] = 0;
+
+    auto setVelocity = [&](double angle, double speed) {
+        p.vx[i] = float(std::cos(angle) * speed);
+        p.vy[i] = float(std::sin(angle) * speed);
+    };
+
+    // 各样式的运动参数均折算到通用积分 (位移、重力、阻尼、衰减) 上，step() 中只需少量样式修正
+    switch (style) {
+    case Butterfly:
+        setVelocity(randomDouble(0, M_PI * 2), randomDouble(1.0, 3.0));
+        p.gravity[i] = 0.01f;
+        p.drag[i] = 0.96f;
+        p.color[i] = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 220, 255).rgb();
+        p.size[i] = float(randomDouble(3.0, 5.0));
+        p.decay[i] = 2.0f;
+        p.phase[i] = float(randomDouble(0, M_PI));
+        break;
+    case Matrix: {
+        static const QString chars = "01COPYX";
+        p.character[i] = chars.at(QRandomGenerator::global()->bounded(chars.length())).unicode();
+        p.vy[i] = float(randomDouble(3.0, 6.0));
+        p.color[i] = qRgb(0, 255, 70);
+        p.size[i] = float(QRandomGenerator::global()->bounded(8, 12));
+        p.decay[i] = 5.0f;
+        break;
+    }
+    case Dna:
+        // 横向位置由相位解析计算，纵向匀速上升，透明度在 step() 中按前后关系设定
+        p.vy[i] = -float(randomDouble(1.0, 3.0));
+        p.drag[i] = 1.0f;
+        p.decay[i] = 0.0f;
+        p.phase[i] = float((double(index) / total) * 4 * M_PI);
+        p.amp[i] = float(randomDouble(10.0, 15.0));
+        p.color[i] = (index % 2 == 0) ? qRgb(0, 200, 255) : qRgb(255, 0, 150);
+        break;
+    case Lightning: {
+        const double angle = randomDouble(0, M_PI * 2);
+        const double dist = randomDouble(20.0, 60.0);
+        const QPointF target(pos.x() + std::cos(angle) * dist, pos.y() + std::sin(angle) * dist);
+        for (int s = 0; s < kLightningSteps; ++s) {
+            const double t = double(s + 1) / kLightningSteps;
+            p.lightning[i * kLightningSteps + s] = QPointF(pos.x() + (target.x() - pos.x()) * t + randomDouble(-10.0, 10.0),
+                                                           pos.y() + (target.y() - pos.y()) * t + randomDouble(-10.0, 10.0));
         }
-        p.color = QColor(220, 220, 255);
-        p.decay = 20.0;
-    } else if (style == "confetti") {
-        double angle = randomDouble(0, M_PI * 2);
-        double speed = randomDouble(2.0, 6.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.gravity = 0.2;
-        p.drag = 0.92;
-        p.spin = randomDouble(-0.2, 0.2);
-        p.color = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 200, 255);
-        p.size = randomDouble(4.0, 7.0);
-    } else if (style == "void") {
-        double angle = randomDouble(0, M_PI * 2);
-        double dist = randomDouble(40.0, 80.0);
-        p.pos = QPointF(pos.x() + std::cos(angle) * dist, pos.y() + std::sin(angle) * dist);
-        p.vel = (QPointF(pos) - p.pos) * 0.15;
-        p.color = QColor(150, 0, 255);
-        p.mode = "suck";
-        p.decay = 0;
-    } else if (style == "heart") {
-        double t = (double(index) / total) * 2 * M_PI;
-        double scale = randomDouble(1.0, 1.8);
-        p.vel = QPointF((16 * std::pow(std::sin(t), 3)) * 0.1 * scale,
-                        -(13 * std::cos(t) - 5 * std::cos(2*t) - 2 * std::cos(3*t) - std::cos(4*t)) * 0.1 * scale);
-        p.gravity = 0.02;
-        p.color = QColor(255, 80, 150);
-        p.decay = 3.0;
-    } else if (style == "galaxy") {
-        int arm = index % 3;
-        double angle = (arm * 2.09) + (double(index) / total) + randomDouble(-0.2, 0.2);
-        double speed = randomDouble(1.0, 3.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.color = QColor::fromHsv(QRandomGenerator::global()->bounded(200, 301), 220, 255);
-        p.decay = 4.0;
-    } else if (style == "frozen") {
-        double angle = randomDouble(0, M_PI * 2);
-        double speed = randomDouble(5.0, 12.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.gravity = 0.05;
-        p.drag = 0.80;
-        p.color = QColor(200, 255, 255);
-        p.decay = 5.0;
-    } else if (style == "phoenix") {
-        double angle = randomDouble(M_PI + 0.5, 2 * M_PI - 0.5);
-        double speed = randomDouble(1.0, 4.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.gravity = -0.1;
-        p.color = QColor(255, int(randomDouble(150, 256)), 50);
-        p.decay = 4.0;
-    } else if (style == "chaos") {
-        p.vel = QPointF(randomDouble(-2.0, 2.0), randomDouble(-2.0, 2.0));
-        p.drag = 0.98;
-        p.color = QColor(255, 50, 50);
-        p.decay = 6.0;
-    } else {
-        double angle = randomDouble(0, M_PI * 2);
-        double speed = randomDouble(1.0, 5.0);
-        p.vel = QPointF(std::cos(angle) * speed, std::sin(angle) * speed);
-        p.gravity = 0.15;
-        if (style == "gold") {
-            p.color = QColor(255, 235, 100);
-            p.gravity = 0.25;
+        p.color[i] = qRgb(220, 220, 255);
+        p.decay[i] = 20.0f;
+        break;
+    }
+    case Confetti:
+        setVelocity(randomDouble(0, M_PI * 2), randomDouble(2.0, 6.0));
+        p.gravity[i] = 0.2f;
+        p.drag[i] = 0.92f;
+        p.spin[i] = float(randomDouble(-0.2, 0.2));
+        p.color[i] = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 200, 255).rgb();
+        p.size[i] = float(randomDouble(4.0, 7.0));
+        p.decay[i] = 2.0f;
+        break;
+    case Void: {
+        const double angle = randomDouble(0, M_PI * 2);
+        const double dist = randomDouble(40.0, 80.0);
+        p.x[i] = float(pos.x() + std::cos(angle) * dist);
+        p.y[i] = float(pos.y() + std::sin(angle) * dist);
+        p.vx[i] = (p.initX[i] - p.x[i]) * 0.15f;
+        p.vy[i] = (p.initY[i] - p.y[i]) * 0.15f;
+        p.drag[i] = 1.0f;
+        p.decay[i] = 0.0f;
+        p.color[i] = qRgb(150, 0, 255);
+        p.sucking[i] = true;
+        break;
+    }
+    case Heart: {
+        const double t = (double(index) / total) * 2 * M_PI;
+        const double scale = randomDouble(1.0, 1.8);
+        p.vx[i] = float((16 * std::pow(std::sin(t), 3)) * 0.1 * scale);
+        p.vy[i] = float(-(13 * std::cos(t) - 5 * std::cos(2*t) - 2 * std::cos(3*t) - std::cos(4*t)) * 0.1 * scale);
+        p.gravity[i] = 0.02f;
+        p.color[i] = qRgb(255, 80, 150);
+        p.decay[i] = 3.0f;
+        break;
+    }
+    case Galaxy: {
+        const int arm = index % 3;
+        setVelocity((arm * 2.09) + (double(index) / total) + randomDouble(-0.2, 0.2), randomDouble(1.0, 3.0));
+        p.color[i] = QColor::fromHsv(QRandomGenerator::global()->bounded(200, 301), 220, 255).rgb();
+        p.decay[i] = 4.0f;
+        break;
+    }
+    case Frozen:
+        setVelocity(randomDouble(0, M_PI * 2), randomDouble(5.0, 12.0));
+        p.gravity[i] = 0.05f;
+        p.drag[i] = 0.80f;
+        p.color[i] = qRgb(200, 255, 255);
+        p.decay[i] = 5.0f;
+        break;
+    case Phoenix:
+        setVelocity(randomDouble(M_PI + 0.5, 2 * M_PI - 0.5), randomDouble(1.0, 4.0));
+        p.gravity[i] = -0.1f;
+        p.color[i] = qRgb(255, int(randomDouble(150, 256)), 50);
+        p.decay[i] = 4.0f;
+        break;
+    case Chaos:
+        p.vx[i] = float(randomDouble(-2.0, 2.0));
+        p.vy[i] = float(randomDouble(-2.0, 2.0));
+        p.drag[i] = 0.98f;
+        p.color[i] = qRgb(255, 50, 50);
+        p.decay[i] = 6.0f;
+        break;
+    default: // Neon / Gold / Quantum
+        setVelocity(randomDouble(0, M_PI * 2), randomDouble(1.0, 5.0));
+        p.gravity[i] = 0.15f;
+        if (style == Gold) {
+            p.color[i] = qRgb(255, 235, 100);
+            p.gravity[i] = 0.25f;
         } else {
-            p.color = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 220, 255);
+            p.color[i] = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 220, 255).rgb();
         }
-        if (style == "quantum") {
-            p.decay = 5.0;
+        if (style == Quantum) {
+            p.decay[i] = 5.0f;
         }
+        break;
     }
 }
 
@@ -258,88 +235,277 @@ void FireworksOverlay::updateTotalRect() {
         totalRect = totalRect.united(screen->geometry());
     }
     m_totalRect = totalRect;
+    // 屏幕变化可能带来新的缩放比例，精灵需按新比例重新渲染
+    m_spriteCache.clear();
     if (isVisible()) {
         setGeometry(m_totalRect);
     }
 }
 
+void FireworksOverlay::step() {
+    Particles& p = m_p;
+    const int n = p.count;
+
+    // [PERF] 通用积分：无分支的连续数组运算，可被自动向量化
+    for (int i = 0; i < n; ++i) {
+        p.x[i] += p.vx[i];
+        p.y[i] += p.vy[i];
+        p.vy[i] = (p.vy[i] + p.gravity[i]) * p.drag[i];
+        p.vx[i] *= p.drag[i];
+        p.alpha[i] -= p.decay[i];
+    }
+
+    // 少数样式的额外运动规则
+    for (int i = 0; i < n; ++i) {
+        switch (p.style[i]) {
+        case Butterfly:
+            p.x[i] += std::sin(p.age[i] * 0.2f + p.phase[i]) * 0.8f;
+            ++p.age[i];
+            break;
+        case Dna: {
+            ++p.age[i];
+            const float offset = std::sin(p.y[i] * 0.05f + p.phase[i]) * p.amp[i];
+            p.x[i] = p.initX[i] + offset;
+            p.alpha[i] = p.age[i] > 60 ? 0.0f : (offset > 0 ? 255.0f : 100.0f);
+            break;
+        }
+        case Confetti:
+            p.rotation[i] += p.spin[i];
+            p.widthFactor[i] = std::abs(std::cos(p.rotation[i]));
+            break;
+        case Void:
+            if (p.sucking[i] && std::hypot(p.x[i] - p.initX[i], p.y[i] - p.initY[i]) < 5.0f) {
+                const double angle = randomDouble(0, M_PI * 2);
+                const double speed = randomDouble(2.0, 8.0);
+                p.vx[i] = float(std::cos(angle) * speed);
+                p.vy[i] = float(std::sin(angle) * speed);
+                p.color[i] = qRgb(255, 255, 255);
+                p.decay[i] = 5.0f;
+                p.sucking[i] = false;
+            }
+            break;
+        case Phoenix: {
+            const QRgb c = p.color[i];
+            if (p.age[i] > 10 && qGreen(c) > 5) {
+                p.color[i] = qRgb(qRed(c), qGreen(c) - 5, qBlue(c));
+            }
+            ++p.age[i];
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // 稳定压缩：保持绘制顺序不变，移除透明度耗尽的粒子
+    int alive = 0;
+    for (int i = 0; i < n; ++i) {
+        if (p.alpha[i] > 0) {
+            if (alive != i) moveParticle(i, alive);
+            ++alive;
+        }
+    }
+    p.count = alive;
+}
+
+void FireworksOverlay::moveParticle(int from, int to) {
+    Particles& p = m_p;
+    p.x[to] = p.x[from]; p.y[to] = p.y[from];
+    p.vx[to] = p.vx[from]; p.vy[to] = p.vy[from];
+    p.initX[to] = p.initX[from]; p.initY[to] = p.initY[from];
+    p.gravity[to] = p.gravity[from]; p.drag[to] = p.drag[from];
+    p.decay[to] = p.decay[from]; p.alpha[to] = p.alpha[from]; p.size[to] = p.size[from];
+    p.rotation[to] = p.rotation[from]; p.spin[to] = p.spin[from];
+    p.widthFactor[to] = p.widthFactor[from];
+    p.phase[to] = p.phase[from]; p.amp[to] = p.amp[from];
+    p.color[to] = p.color[from];
+    p.age[to] = p.age[from];
+    p.style[to] = p.style[from];
+    p.sucking[to] = p.sucking[from];
+    p.character[to] = p.character[from];
+    if (p.style[to] == Lightning) {
+        std::copy_n(&p.lightning[from * kLightningSteps], kLightningSteps, &p.lightning[to * kLightningSteps]);
+    }
+}
+
+QRect FireworksOverlay::particleBounds() const {
+    const Particles& p = m_p;
+    if (p.count == 0) return QRect();
+
+    float minX = p.x[0], maxX = p.x[0], minY = p.y[0], maxY = p.y[0];
+    for (int i = 1; i < p.count; ++i) {
+        minX = std::min(minX, p.x[i]);
+        maxX = std::max(maxX, p.x[i]);
+        minY = std::min(minY, p.y[i]);
+        maxY = std::max(maxY, p.y[i]);
+    }
+
+    // 闪电折线远离粒子坐标，单独并入
+    for (int i = 0; i < p.count; ++i) {
+        if (p.style[i] != Lightning) continue;
+        for (int s = 0; s < kLightningSteps; ++s) {
+            const QPointF& pt = p.lightning[i * kLightningSteps + s];
+            minX = std::min(minX, float(pt.x()));
+            maxX = std::max(maxX, float(pt.x()));
+            minY = std::min(minY, float(pt.y()));
+            maxY = std::max(maxY, float(pt.y()));
+        }
+    }
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY)).toAlignedRect()
+        .adjusted(-kBoundsMargin, -kBoundsMargin, kBoundsMargin, kBoundsMargin);
+}
+
+const QImage& FireworksOverlay::glowSprite(QRgb color, float radius) {
+    // [PERF] 发光粒子按颜色分桶预渲染为精灵，绘制时只需一次贴图
+    const quint32 bucket = ((qRed(color) >> 4) << 8) | ((qGreen(color) >> 4) << 4) | (qBlue(color) >> 4);
+    const quint32 halfPixels = quint32(std::clamp(qRound(radius * 2), 1, 0xFFFF));
+    const quint32 key = bucket | (halfPixels << 12);
+
+    auto it = m_spriteCache.constFind(key);
+    if (it != m_spriteCache.constEnd()) return it.value();
+    if (m_spriteCache.size() >= kMaxCachedSprites) m_spriteCache.clear();
+
+    const QColor base((qRed(color) & 0xF0) | 0x08, (qGreen(color) & 0xF0) | 0x08, (qBlue(color) & 0xF0) | 0x08);
+    const float r = halfPixels / 2.0f;
+    const int side = int(std::ceil(r * kGlowScale * 2));
+    const qreal dpr = devicePixelRatioF();
+
+    QImage sprite(QSize(side, side) * dpr, QImage::Format_ARGB32_Premultiplied);
+    sprite.setDevicePixelRatio(dpr);
+    sprite.fill(Qt::transparent);
+    {
+        QPainter sp(&sprite);
+        sp.setRenderHint(QPainter::Antialiasing);
+        sp.setPen(Qt::NoPen);
+        const QPointF center(side / 2.0, side / 2.0);
+
+        QColor halo = base;
+        QRadialGradient glow(center, r * kGlowScale);
+        halo.setAlpha(90);
+        glow.setColorAt(0.0, halo);
+        halo.setAlpha(0);
+        glow.setColorAt(1.0, halo);
+        sp.setBrush(glow);
+        sp.drawEllipse(center, r * kGlowScale, r * kGlowScale);
+
+        sp.setBrush(base);
+        sp.drawEllipse(center, r, r);
+    }
+    return m_spriteCache.insert(key, sprite).value();
+}
+
 void FireworksOverlay::animate() {
-    if (m_particles.isEmpty()) {
+    if (m_p.count == 0) {
         m_timer->stop();
         // hide(); // 按照用户要求，特效结束不再调用 hide() 以防止任务栏闪烁
-        update(); // 触发最后一次重绘以清除残余
+        update(m_dirtyRect); // 触发最后一次重绘以清除残余
+        m_dirtyRect = QRect();
         return;
     }
-    
-    for (int i = m_particles.size() - 1; i >= 0; --i) {
-        if (!m_particles[i].update()) {
-            m_particles.removeAt(i);
-        }
-    }
-    update();
+
+    step();
+
+    // [PERF] 只重绘粒子包围盒 (并上一帧区域以擦除残影)，避免整块跨屏透明窗口每帧重新合成
+    const QRect bounds = particleBounds();
+    update(m_dirtyRect.united(bounds));
+    m_dirtyRect = bounds;
 }
 
 void FireworksOverlay::paintEvent(QPaintEvent* event) {
-    if (m_particles.isEmpty()) return;
-    
+    Q_UNUSED(event);
+    const Particles& p = m_p;
+    if (p.count == 0) return;
+
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setCompositionMode(QPainter::CompositionMode_Plus);
-    
-    for (const Particle& pt : m_particles) {
-        int alphaVal = int(pt.alpha);
+    painter.setPen(Qt::NoPen);
+    int matrixFontSize = -1;
+
+    for (int i = 0; i < p.count; ++i) {
+        const Style style = Style(p.style[i]);
+        float alphaVal = p.alpha[i];
         // Shimmer logic
-        if (pt.style != "matrix") {
-            double flicker = randomDouble(0.6, 1.0);
-            alphaVal = int(pt.alpha * flicker);
+        if (style != Matrix) {
+            alphaVal *= float(0.6 + m_flicker.generateDouble() * 0.4);
         }
-        
-        QColor c = pt.color;
-        c.setAlpha(std::max(0, std::min(255, alphaVal)));
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(c);
-        
-        if (pt.style == "butterfly") {
-            double flap = std::abs(std::sin(pt.age * 0.3 + pt.phase));
+        const int a = std::clamp(int(alphaVal), 0, 255);
+        if (a == 0) continue;
+
+        const QPointF pos(p.x[i], p.y[i]);
+        QColor c = QColor::fromRgb(p.color[i]);
+        c.setAlpha(a);
+
+        switch (style) {
+        case Butterfly: {
+            const double flap = std::abs(std::sin(p.age[i] * 0.3 + p.phase[i]));
             painter.save();
-            painter.translate(pt.pos);
-            double angle = std::atan2(pt.vel.y(), pt.vel.x());
-            painter.rotate(angle * 180.0 / M_PI + 90);
-            double w = pt.size * flap;
-            double h = pt.size;
+            painter.translate(pos);
+            painter.rotate(std::atan2(p.vy[i], p.vx[i]) * 180.0 / M_PI + 90);
+            const double w = p.size[i] * flap;
+            const double h = p.size[i];
+            painter.setBrush(c);
             painter.drawEllipse(QPointF(-w, 0), w, h);
             painter.drawEllipse(QPointF(w, 0), w, h);
             painter.restore();
-        } else if (pt.style == "matrix") {
+            break;
+        }
+        case Matrix: {
+            const int fontSize = int(p.size[i]);
+            if (fontSize != matrixFontSize) {
+                QFont f("Consolas", fontSize);
+                f.setBold(true);
+                painter.setFont(f);
+                matrixFontSize = fontSize;
+            }
             painter.setPen(c);
-            QFont f("Consolas", int(pt.size));
-            f.setBold(true);
-            painter.setFont(f);
-            painter.drawText(pt.pos, QString(pt.character));
-        } else if (pt.style == "lightning") {
+            painter.drawText(pos, QString(QChar(p.character[i])));
+            painter.setPen(Qt::NoPen);
+            break;
+        }
+        case Lightning: {
             painter.setPen(QPen(c, 1.5));
+            painter.setBrush(c);
             QPainterPath path;
-            path.moveTo(pt.initialPos);
-            for (const QPointF& pnt : pt.lightningPoints) {
-                path.lineTo(pnt);
+            path.moveTo(p.initX[i], p.initY[i]);
+            for (int s = 0; s < kLightningSteps; ++s) {
+                path.lineTo(p.lightning[i * kLightningSteps + s]);
             }
             painter.drawPath(path);
-        } else if (pt.style == "confetti") {
+            painter.setPen(Qt::NoPen);
+            break;
+        }
+        case Confetti: {
             painter.save();
-            painter.translate(pt.pos);
-            painter.rotate(pt.rotation * 180.0 / M_PI);
-            double w = 6 * pt.widthFactor;
-            double h = 10;
+            painter.translate(pos);
+            painter.rotate(p.rotation[i] * 180.0 / M_PI);
+            const double w = 6 * p.widthFactor[i];
+            const double h = 10;
+            painter.setBrush(c);
             painter.drawRect(QRectF(-w / 2, -h / 2, w, h));
             painter.restore();
-        } else if (pt.style == "quantum") {
-            double s = pt.size * (pt.alpha / 255.0);
-            painter.drawRect(QRectF(pt.pos.x() - s / 2, pt.pos.y() - s / 2, s, s));
-        } else if (pt.style == "gold") {
-            painter.setPen(QPen(c, pt.size));
-            painter.drawLine(pt.pos, pt.pos - pt.vel);
-        } else {
-            painter.drawEllipse(pt.pos, pt.size, pt.size);
+            break;
+        }
+        case Quantum: {
+            const double s = p.size[i] * (p.alpha[i] / 255.0);
+            painter.setBrush(c);
+            painter.drawRect(QRectF(pos.x() - s / 2, pos.y() - s / 2, s, s));
+            break;
+        }
+        case Gold:
+            painter.setPen(QPen(c, p.size[i]));
+            painter.drawLine(pos, pos - QPointF(p.vx[i], p.vy[i]));
+            painter.setPen(Qt::NoPen);
+            break;
+        default: {
+            // [PERF] 预渲染的发光精灵直接贴图，替代逐粒子构造画刷并绘制抗锯齿椭圆
+            const QImage& sprite = glowSprite(p.color[i], p.size[i]);
+            const QSizeF s = sprite.deviceIndependentSize();
+            painter.setOpacity(a / 255.0);
+            painter.drawImage(QPointF(pos.x() - s.width() / 2, pos.y() - s.height() / 2), sprite);
+            painter.setOpacity(1.0);
+            break;
+        }
         }
     }
 }
@@ -4,43 +4,18 @@
 #include <QWidget>
 #include <QTimer>
 #include <QColor>
-#include <QList>
+#include <QHash>
+#include <QImage>
 #include <QPointF>
-#include <QPainterPath>
-
-struct Particle {
-    QPointF pos;
-    QPointF initialPos;
-    QPointF vel;
-    double gravity;
-    double drag;
-    double size;
-    double decay;
-    QColor color;
-    double alpha;
-    int age;
-    QString style;
-    int index;
-    int total;
-    double rotation;
-    double spin;
-    QChar character;
-    double widthFactor;
-    double phase;
-    double amp;
-    QList<QPointF> lightningPoints;
-    QString mode; // for 'void' style
-
-    Particle();
-    bool update();
-};
+#include <QRandomGenerator>
+#include <array>
 
 class FireworksOverlay : public QWidget {
     Q_OBJECT
 public:
     explicit FireworksOverlay(QWidget* parent = nullptr);
     static FireworksOverlay* instance();
-    
+
     void explode(const QPoint& pos);
 
 protected:
@@ -51,9 +26,42 @@ private slots:
     void updateTotalRect();
 
 private:
-    void initParticle(Particle& p, const QPoint& pos, const QString& style, int index, int total);
-    
-    QList<Particle> m_particles;
+    friend class BenchFireworks; // 基准测试逐帧驱动积分并按粒子包围盒离屏绘制
+
+    enum Style : quint8 {
+        Neon, Gold, Butterfly, Quantum, Heart, Galaxy, Frozen, Phoenix,
+        Matrix, Dna, Lightning, Void, Confetti, Chaos, StyleCount
+    };
+
+    // [PERF] 粒子总数上限：连续复制时叠加的爆炸超出上限的部分直接丢弃，单帧开销有界
+    static constexpr int kMaxParticles = 480;
+    static constexpr int kLightningSteps = 4;
+
+    // [PERF] 结构数组 (SoA) 布局：通用积分只按下标遍历连续的 float 数组，可被编译器自动向量化
+    struct Particles {
+        int count = 0;
+        std::array<float, kMaxParticles> x, y, vx, vy;
+        std::array<float, kMaxParticles> initX, initY;
+        std::array<float, kMaxParticles> gravity, drag, decay, alpha, size;
+        std::array<float, kMaxParticles> rotation, spin, widthFactor, phase, amp;
+        std::array<QRgb, kMaxParticles> color;
+        std::array<quint16, kMaxParticles> age;
+        std::array<quint8, kMaxParticles> style;
+        std::array<bool, kMaxParticles> sucking;   // void 样式：true 为吸入阶段，false 为爆开阶段
+        std::array<char16_t, kMaxParticles> character;
+        std::array<QPointF, kMaxParticles * kLightningSteps> lightning;
+    };
+
+    void initParticle(int i, const QPointF& pos, Style style, int index, int total);
+    void step();
+    void moveParticle(int from, int to);
+    QRect particleBounds() const;
+    const QImage& glowSprite(QRgb color, float radius);
+
+    Particles m_p;
+    QHash<quint32, QImage> m_spriteCache; // 键：颜色分桶 (每通道 4 bit) + 半径 (半像素精度)
+    QRandomGenerator m_flicker;
+    QRect m_dirtyRect;                    // 上一帧粒子占据的区域，下一帧需一并重绘以擦除残影
     QTimer* m_timer;
     QRect m_totalRect;
     static FireworksOverlay* m_instance;
@@ -30,8 +30,9 @@ FloatingBall::FloatingBall(QWidget* parent)
     setFixedSize(120, 120); // 1:1 复刻 Python 版尺寸
     
     m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(kAnimationIntervalMs);
     connect(m_timer, &QTimer::timeout, this, &FloatingBall::updatePhysics);
-    m_timer->start(16);
 
     restorePosition();
     
@@ -78,7 +79,8 @@ void FloatingBall::paintEvent(QPaintEvent* event) {
     painter.restore();
 
     // 2. 绘制粒子
-    for (const auto& p : m_particles) {
+    for (int i = 0; i < m_particleCount; ++i) {
+        const Particle& p = m_particles[i];
         QColor c = p.color;
         c.setAlphaF(p.life);
         painter.setBrush(c);
@@ -207,6 +209,7 @@ void FloatingBall::mousePressEvent(QMouseEvent* event) {
         m_isDragging = false; // 初始不进入拖拽，等待 move 判定
         m_penY += 3.0f; // 1:1 复刻 Python 按下弹性反馈
         update();
+        ensureAnimating();
     }
 }
 
@@ -252,6 +255,7 @@ void FloatingBall::mouseDoubleClickEvent(QMouseEvent* event) {
 void FloatingBall::enterEvent(QEnterEvent* event) {
     Q_UNUSED(event);
     m_isHovering = true;
+    ensureAnimating();
 }
 
 void FloatingBall::leaveEvent(QEvent* event) {
@@ -297,6 +301,7 @@ void FloatingBall::dragEnterEvent(QDragEnterEvent* event) {
     if (event->mimeData()->hasText() || event->mimeData()->hasUrls() || event->mimeData()->hasImage()) {
         event->acceptProposedAction();
         m_isHovering = true;
+        ensureAnimating();
     } else {
         event->ignore();
     }
@@ -379,6 +384,7 @@ void FloatingBall::dropEvent(QDropEvent* event) {
         burstParticles();
         m_isWriting = true;
         m_writeTimer = 0;
+        ensureAnimating();
         
         event->acceptProposedAction();
     }
@@ -442,20 +448,27 @@ void FloatingBall::burstParticles() {
     // 逻辑保持
 }
 
+void FloatingBall::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    m_timer->stop();
+}
+
+void FloatingBall::ensureAnimating() {
+    if (isVisible() && !m_timer->isActive()) m_timer->start();
+}
+
 void FloatingBall::updatePhysics() {
     m_timeStep += 0.05f;
     
-    // 1. 待机呼吸
-    float idlePenY = qSin(m_timeStep * 0.5f) * 4.0f;
-    float idleBookY = qSin(m_timeStep * 0.5f - 1.0f) * 2.0f;
-    
+    // 1. 静止姿态 (与 generateBallIcon 一致)；原先的待机呼吸需要常驻定时器，已改为静止
     float targetPenAngle = -45.0f;
     float targetPenX = 0.0f;
-    float targetPenY = idlePenY;
-    float targetBookY = idleBookY;
+    float targetPenY = 0.0f;
+    float targetBookY = 0.0f;
     
     // 2. 书写/悬停动画
-    if (m_isWriting || m_isHovering) {
+    const bool active = m_isWriting || m_isHovering;
+    if (active) {
         m_writeTimer++;
         targetPenAngle = -65.0f;
         float writeSpeed = m_timeStep * 3.0f;
@@ -477,10 +490,19 @@ void FloatingBall::updatePhysics() {
 
     updateParticles();
     update();
+
+    // 4. 回到静止姿态且粒子耗尽后停表，直到下一次悬停/按下/拖入
+    const float epsilon = 0.02f;
+    const bool settled = qAbs(targetPenAngle - m_penAngle) < epsilon && qAbs(targetPenX - m_penX) < epsilon
+                      && qAbs(targetPenY - m_penY) < epsilon && qAbs(targetBookY - m_bookY) < epsilon;
+    if (!active && settled && m_particleCount == 0) {
+        m_penAngle = targetPenAngle; m_penX = targetPenX; m_penY = targetPenY; m_bookY = targetBookY;
+        m_timer->stop();
+    }
 }
 
 void FloatingBall::updateParticles() {
-    if ((m_isWriting || m_isHovering) && m_particles.size() < 15) {
+    if ((m_isWriting || m_isHovering) && m_particleCount < kMaxParticles) {
         if (QRandomGenerator::global()->generateDouble() < 0.3) {
             float rad = qDegreesToRadians(m_penAngle);
             float tipLen = 35.0f;
@@ -490,16 +512,18 @@ void FloatingBall::updateParticles() {
             p.life = 1.0;
             p.size = 1.0f + QRandomGenerator::global()->generateDouble() * 2.0f;
             p.color = QColor::fromHsv(QRandomGenerator::global()->bounded(360), 150, 255);
-            m_particles.append(p);
+            m_particles[m_particleCount++] = p;
         }
     }
-    for (int i = 0; i < m_particles.size(); ++i) {
-        m_particles[i].pos += m_particles[i].velocity;
-        m_particles[i].life -= 0.03;
-        m_particles[i].size *= 0.96f;
-        if (m_particles[i].life <= 0) {
-            m_particles.removeAt(i);
-            --i;
+    for (int i = 0; i < m_particleCount; ) {
+        Particle& p = m_particles[i];
+        p.pos += p.velocity;
+        p.life -= 0.03;
+        p.size *= 0.96f;
+        if (p.life <= 0) {
+            p = m_particles[--m_particleCount]; // 与末尾交换，绘制顺序无关
+        } else {
+            ++i;
         }
     }
 }
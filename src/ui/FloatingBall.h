@@ -12,6 +12,7 @@
 #include <QDropEvent>
 #include <QMimeData>
 #include "WritingAnimation.h"
+#include <array>
 
 class FloatingBall : public QWidget {
     Q_OBJECT
@@ -21,6 +22,9 @@ public:
     explicit FloatingBall(QWidget* parent = nullptr);
     static QIcon generateBallIcon();
 
+    // 书写/悬停/回弹时的动画节拍 (60 帧)
+    static constexpr int kAnimationIntervalMs = 16;
+
 protected:
     void paintEvent(QPaintEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
@@ -33,6 +37,7 @@ protected:
     void dragEnterEvent(QDragEnterEvent* event) override;
     void dragLeaveEvent(QDragLeaveEvent* event) override;
     void dropEvent(QDropEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
     static void renderBook(QPainter* p, const QString& skinName, float bookY);
     static void renderPen(QPainter* p, const QString& skinName, float penX, float penY, float penAngle);
 
@@ -40,6 +45,8 @@ private:
     void switchSkin(const QString& name);
     // drawBook 和 drawPen 已改为静态 renderBook/renderPen
     void burstParticles();
+    // [PERF] 按需驱动动画：只在书写/悬停/回弹过程中运行定时器，静止后停止，空闲时不再唤醒 CPU
+    void ensureAnimating();
     void updatePhysics();
     void updateParticles();
     void savePosition();
@@ -66,7 +73,10 @@ private:
         float size;
         QColor color;
     };
-    QList<Particle> m_particles;
+    // 固定容量粒子池：死亡粒子与末尾交换后计数减一，不做内存分配与搬移
+    static constexpr int kMaxParticles = 15;
+    std::array<Particle, kMaxParticles> m_particles;
+    int m_particleCount = 0;
 
     QString m_skinName = "mocha";
 
@@ -23,6 +23,7 @@ FlowLayout::~FlowLayout()
 void FlowLayout::addItem(QLayoutItem *item)
 {
     itemList.append(item);
+    m_hintCacheValid = false;
 }
 
 void FlowLayout::insertItem(int index, QLayoutItem *item)
@@ -68,12 +69,57 @@ QLayoutItem *FlowLayout::itemAt(int index) const
 
 QLayoutItem *FlowLayout::takeAt(int index)
 {
-    if (index >= 0 && index < itemList.size())
+    if (index >= 0 && index < itemList.size()) {
+        m_hintCacheValid = false;
         return itemList.takeAt(index);
-    else
+    } else
         return 0;
 }
 
+void FlowLayout::invalidate()
+{
+    m_hintCacheValid = false;
+    QLayout::invalidate();
+}
+
+void FlowLayout::moveWidgetsToFront(const QList<QWidget *> &widgets)
+{
+    QHash<QWidget *, QLayoutItem *> byWidget;
+    byWidget.reserve(itemList.size());
+    for (QLayoutItem *item : std::as_const(itemList)) {
+        if (item->widget()) byWidget.insert(item->widget(), item);
+    }
+
+    QList<QLayoutItem *> ordered;
+    ordered.reserve(itemList.size());
+    QSet<QLayoutItem *> placed;
+    for (QWidget *w : widgets) {
+        QLayoutItem *item = byWidget.value(w);
+        if (item && !placed.contains(item)) {
+            ordered.append(item);
+            placed.insert(item);
+        }
+    }
+    for (QLayoutItem *item : std::as_const(itemList)) {
+        if (!placed.contains(item)) ordered.append(item);
+    }
+    if (ordered == itemList) return;
+    itemList = ordered;
+    invalidate();
+}
+
+const QList<QSize> &FlowLayout::itemSizeHints() const
+{
+    if (!m_hintCacheValid) {
+        m_hintCache.clear();
+        m_hintCache.reserve(itemList.size());
+        for (QLayoutItem *item : itemList)
+            m_hintCache.append(item->isEmpty() ? QSize() : item->sizeHint());
+        m_hintCacheValid = true;
+    }
+    return m_hintCache;
+}
+
 Qt::Orientations FlowLayout::expandingDirections() const
 {
     return { };
@@ -105,8 +151,10 @@ QSize FlowLayout::minimumSize() const
 {
     QSize size;
     QLayoutItem *item;
-    foreach (item, itemList)
-        size = size.expandedTo(item->minimumSize());
+    foreach (item, itemList) {
+        if (!item->isEmpty())
+            size = size.expandedTo(item->minimumSize());
+    }
 
     size += QSize(2*contentsMargins().top(), 2*contentsMargins().top());
     return size;
@@ -121,8 +169,13 @@ int FlowLayout::doLayout(const QRect &rect, bool testOnly) const
     int y = effectiveRect.y();
     int lineHeight = 0;
 
-    QLayoutItem *item;
-    foreach (item, itemList) {
+    const QList<QSize> &hints = itemSizeHints();
+    for (int i = 0; i < itemList.size(); ++i) {
+        QLayoutItem *item = itemList.at(i);
+        // 隐藏的控件不占位，便于调用方复用控件时只做显隐切换
+        if (item->isEmpty())
+            continue;
+        const QSize hint = hints.at(i);
         QWidget *wid = item->widget();
         int spaceX = horizontalSpacing();
         if (spaceX == -1)
@@ -132,19 +185,19 @@ int FlowLayout::doLayout(const QRect &rect, bool testOnly) const
         if (spaceY == -1)
             spaceY = wid->style()->layoutSpacing(
                 QSizePolicy::PushButton, QSizePolicy::PushButton, Qt::Vertical);
-        int nextX = x + item->sizeHint().width() + spaceX;
+        int nextX = x + hint.width() + spaceX;
         if (nextX - spaceX > effectiveRect.right() && lineHeight > 0) {
             x = effectiveRect.x();
             y = y + lineHeight + spaceY;
-            nextX = x + item->sizeHint().width() + spaceX;
+            nextX = x + hint.width() + spaceX;
             lineHeight = 0;
         }
 
         if (!testOnly)
-            item->setGeometry(QRect(QPoint(x, y), item->sizeHint()));
+            item->setGeometry(QRect(QPoint(x, y), hint));
 
         x = nextX;
-        lineHeight = qMax(lineHeight, item->sizeHint().height());
+        lineHeight = qMax(lineHeight, hint.height());
     }
     return y + lineHeight - rect.y() + bottom;
 }
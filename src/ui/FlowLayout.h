@@ -5,6 +5,12 @@
 #include <QRect>
 #include <QStyle>
 
+/**
+ * @brief 自动换行的流式布局
+ * 隐藏的子控件 (QLayoutItem::isEmpty()) 不参与 doLayout / minimumSize 计算，不占位置也不产生间距。
+ * 这一行为对所有使用者生效 (TagEditorWidget、SearchLineEdit、ColorPickerWindow、AdvancedTagSelector)：
+ * 隐藏子控件即从流中移除，重新显示即回到原位置，无需 takeAt / insertWidget。
+ */
 class FlowLayout : public QLayout {
     Q_OBJECT
 public:
@@ -26,12 +32,21 @@ public:
     void setGeometry(const QRect &rect) override;
     QSize sizeHint() const override;
     QLayoutItem *takeAt(int index) override;
+    void invalidate() override;
+
+    // 按给定顺序把这些控件排到最前，其余项保持原有相对顺序 (只移动指针，不重建控件)
+    void moveWidgetsToFront(const QList<QWidget *> &widgets);
 
 private:
     int doLayout(const QRect &rect, bool testOnly) const;
     int smartSpacing(QStyle::PixelMetric pm) const;
+    const QList<QSize> &itemSizeHints() const;
 
     QList<QLayoutItem *> itemList;
+    // [PERF] 子项 sizeHint 缓存：heightForWidth / setGeometry 反复排版时不再逐项重新计算 (样式表按钮的 sizeHint 代价较高)；
+    // 子控件 updateGeometry 或增删项时经 invalidate() 失效
+    mutable QList<QSize> m_hintCache;
+    mutable bool m_hintCacheValid = false;
     int m_hSpace;
     int m_vSpace;
 };
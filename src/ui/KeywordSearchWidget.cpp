@@ -2,6 +2,9 @@
 #include "ToolTipOverlay.h"
 #include "IconHelper.h"
 #include "StringUtils.h"
+#include "../core/ContentSearcher.h"
+#include "../core/ReplaceEngine.h"
+#include "../models/KeywordResultModel.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -33,26 +36,16 @@
 // ----------------------------------------------------------------------------
 // KeywordSearchHistory 相关辅助类 (复刻 FileSearchHistoryPopup 逻辑)
 // ----------------------------------------------------------------------------
-class KeywordResultListWidget : public QListWidget {
+class KeywordResultListView : public QListView {
 public:
-    using QListWidget::QListWidget;
+    using QListView::QListView;
 protected:
     void startDrag(Qt::DropActions supportedActions) override {
-        QList<QListWidgetItem*> items = selectedItems();
-        if (items.isEmpty()) return;
-
-        QMimeData* mime = new QMimeData();
-        QList<QUrl> urls;
-        QStringList paths;
-        for (auto* item : items) {
-            QString p = item->data(Qt::UserRole).toString();
-            if (!p.isEmpty()) {
-                urls << QUrl::fromLocalFile(p);
-                paths << p;
-            }
-        }
-        mime->setUrls(urls);
-        mime->setText(paths.join("\n"));
+        QModelIndexList indexes = selectionModel()->selectedRows();
+        if (indexes.isEmpty()) return;
+
+        QMimeData* mime = model()->mimeData(indexes);
+        if (!mime) return;
 
         QDrag* drag = new QDrag(this);
         drag->setMimeData(mime);
@@ -299,6 +292,48 @@ KeywordSearchWidget::KeywordSearchWidget(QWidget* parent) : QWidget(parent) {
     m_ignoreDirs = {".git", ".svn", ".idea", ".vscode", "__pycache__", "node_modules", "dist", "build", "venv"};
     setupStyles();
     initUI();
+
+    // 替换与撤销由 ReplaceEngine 在后台事务化执行，结束后回到本线程更新状态
+    m_replacer = new ReplaceEngine(this);
+    connect(m_replacer, &ReplaceEngine::replaceFinished, this, [this](int modifiedFiles, int failedFiles, const QString& backupDir) {
+        m_progressBar->hide();
+        if (backupDir.isEmpty()) {
+            m_statusLabel->setText("替换失败: 无法创建备份目录");
+            ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color: #e74c3c;'>[ERR] 无法创建备份目录，未修改任何文件</b>"));
+            return;
+        }
+        m_lastBackupPath = backupDir;
+        QSettings settings("SearchTool_Standalone", "KeywordSearchHistory");
+        settings.setValue("lastBackupPath", backupDir);
+
+        QString status = QString("替换完成: 修改了 %1 个文件").arg(modifiedFiles);
+        if (failedFiles > 0) status += QString("，%1 个文件失败").arg(failedFiles);
+        m_statusLabel->setText(status);
+        ToolTipOverlay::instance()->showText(QCursor::pos(),
+            StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>[OK] 已修改 %1 个文件 (备份于 %2)</b>")
+            .arg(modifiedFiles).arg(QFileInfo(backupDir).fileName())));
+    });
+    connect(m_replacer, &ReplaceEngine::undoFinished, this, [this](int restoredFiles, int skippedFiles, int conflictFiles) {
+        m_progressBar->hide();
+        QString status = QString("撤销完成，已恢复 %1 个文件").arg(restoredFiles);
+        if (skippedFiles > 0) status += QString("，%1 个无需恢复").arg(skippedFiles);
+        if (conflictFiles > 0) status += QString("，%1 个已被修改而跳过").arg(conflictFiles);
+        m_statusLabel->setText(status);
+        const QString color = conflictFiles > 0 ? "#f39c12" : "#2ecc71";
+        ToolTipOverlay::instance()->showText(QCursor::pos(),
+            StringUtils::wrapToolTip(QString("<b style='color: %1;'>[OK] 已恢复 %2 个文件</b>").arg(color).arg(restoredFiles)));
+    });
+
+    // [PERF] 搜索由 ContentSearcher 在线程池中并行完成，命中结果逐个流式回传
+    m_searcher = new ContentSearcher(this);
+    connect(m_searcher, &ContentSearcher::fileMatched, this,
+            [this](const QString& path, int count, const QString& encoding, const QList<ContentMatch>& matches) {
+        m_resultModel->appendFile(path, count, encoding, matches);
+    });
+    connect(m_searcher, &ContentSearcher::finished, this, [this](int scannedFiles, int foundFiles) {
+        m_statusLabel->setText(QString("完成: 找到 %1 个文件 (扫描了 %2 个)").arg(foundFiles).arg(scannedFiles));
+        m_progressBar->hide();
+    });
 }
 
 KeywordSearchWidget::~KeywordSearchWidget() {
@@ -315,24 +350,24 @@ void KeywordSearchWidget::setupStyles() {
         QSplitter::handle {
             background-color: #333;
         }
-        QListWidget {
+        QListView {
             background-color: #252526; 
             border: 1px solid #333333;
             border-radius: 6px;
             padding: 4px;
         }
-        QListWidget::item {
+        QListView::item {
             height: 30px;
             padding-left: 8px;
             border-radius: 4px;
             color: #CCCCCC;
         }
-        QListWidget::item:selected {
+        QListView::item:selected {
             background-color: #3e3e42; // 2026-03-xx 统一选中色
             border-left: 3px solid #007ACC;
             color: #FFFFFF;
         }
-        QListWidget::item:hover {
+        QListView::item:hover {
             background-color: #2A2D2E;
         }
         QLineEdit {
@@ -499,17 +534,34 @@ void KeywordSearchWidget::initUI() {
     rightLayout->addLayout(btnLayout);
 
     // --- 结果展示区域 ---
-    m_resultList = new KeywordResultListWidget();
+    // [PERF] 虚拟化结果列表：文件头 + 行级命中，按可见行取数据
+    m_resultModel = new KeywordResultModel(this);
+    m_resultList = new KeywordResultListView();
+    m_resultList->setModel(m_resultModel);
+    m_resultList->setUniformItemSizes(true);
     m_resultList->setSelectionMode(QAbstractItemView::ExtendedSelection);
     m_resultList->setDragEnabled(true);
     m_resultList->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(m_resultList, &QListWidget::customContextMenuRequested, this, &KeywordSearchWidget::showResultContextMenu);
-    connect(m_resultList, &QListWidget::itemDoubleClicked, this, [](QListWidgetItem* item) {
-        QString path = item->data(Qt::UserRole).toString();
-        if (!path.isEmpty()) QDesktopServices::openUrl(QUrl::fromLocalFile(path));
-    });
+    connect(m_resultList, &QListView::customContextMenuRequested, this, &KeywordSearchWidget::showResultContextMenu);
+    connect(m_resultList, &QListView::doubleClicked, this, &KeywordSearchWidget::onResultDoubleClicked);
     rightLayout->addWidget(m_resultList, 1);
 
+    m_contextView = new QPlainTextEdit();
+    m_contextView->setReadOnly(true);
+    m_contextView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    m_contextView->setFixedHeight(110);
+    m_contextView->setStyleSheet("QPlainTextEdit { background: #1E1E1E; border: 1px solid #333; border-radius: 4px; color: #CCC; font-family: Consolas, monospace; font-size: 12px; }");
+    m_contextView->hide();
+    rightLayout->addWidget(m_contextView);
+    connect(m_resultList->selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex& current) {
+        if (!current.isValid() || current.data(KeywordResultModel::IsFileRole).toBool()) {
+            m_contextView->hide();
+            return;
+        }
+        m_contextView->setPlainText(current.data(KeywordResultModel::ContextRole).toString());
+        m_contextView->show();
+    });
+
     // --- 状态栏 ---
     auto* statusLayout = new QVBoxLayout();
     m_progressBar = new QProgressBar();
@@ -544,28 +596,32 @@ void KeywordSearchWidget::onBrowseFolder() {
     }
 }
 
+QStringList KeywordSearchWidget::selectedPaths() const {
+    // 行级命中与文件头共享同一路径，去重后按选择顺序返回
+    QStringList paths;
+    const QModelIndexList rows = m_resultList->selectionModel()->selectedRows();
+    for (const auto& idx : rows) {
+        QString p = idx.data(KeywordResultModel::PathRole).toString();
+        if (!p.isEmpty() && !paths.contains(p)) paths << p;
+    }
+    return paths;
+}
+
 void KeywordSearchWidget::showResultContextMenu(const QPoint& pos) {
-    auto selectedItems = m_resultList->selectedItems();
-    if (selectedItems.isEmpty()) {
-        auto* item = m_resultList->itemAt(pos);
-        if (item) {
-            item->setSelected(true);
-            selectedItems << item;
+    if (!m_resultList->selectionModel()->hasSelection()) {
+        QModelIndex index = m_resultList->indexAt(pos);
+        if (index.isValid()) {
+            m_resultList->selectionModel()->select(index, QItemSelectionModel::Select);
         }
     }
-    if (selectedItems.isEmpty()) return;
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
 
     QMenu menu(this);
     menu.setWindowFlags(Qt::Popup | Qt::FramelessWindowHint | Qt::NoDropShadowWindowHint);
     menu.setAttribute(Qt::WA_TranslucentBackground);
     menu.setAttribute(Qt::WA_NoSystemBackground);
 
-    QStringList paths;
-    for (auto* item : selectedItems) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) paths << p;
-    }
-
     if (paths.size() == 1) {
         QString filePath = paths.first();
         menu.addAction(IconHelper::getIcon("folder", "#F1C40F", 18), "定位文件夹", [filePath](){
@@ -583,19 +639,19 @@ void KeywordSearchWidget::showResultContextMenu(const QPoint& pos) {
     }
 
     // [USER_REQUEST] 补全关键字查找菜单，并与文件查找保持完全视觉一致
-    QString copyPathText = selectedItems.size() > 1 ? "复制选中路径" : "复制完整路径";
+    QString copyPathText = paths.size() > 1 ? "复制选中路径" : "复制完整路径";
     menu.addAction(IconHelper::getIcon("copy", "#2ECC71", 18), copyPathText, [paths](){
         QApplication::clipboard()->setText(paths.join("\n"));
     });
 
-    QString copyNameText = selectedItems.size() > 1 ? "复制选中文件名" : "复制文件名";
+    QString copyNameText = paths.size() > 1 ? "复制选中文件名" : "复制文件名";
     menu.addAction(IconHelper::getIcon("file_export", "#2ECC71", 18), copyNameText, [paths](){
         QStringList names;
         for (const auto& p : paths) names << QFileInfo(p).fileName();
         QApplication::clipboard()->setText(names.join("\n"));
     });
 
-    QString copyFileText = selectedItems.size() > 1 ? "复制选中文件" : "复制文件";
+    QString copyFileText = paths.size() > 1 ? "复制选中文件" : "复制文件";
     menu.addAction(IconHelper::getIcon("file", "#4A90E2", 18), copyFileText, [this](){ copySelectedFiles(); });
 
     menu.addAction(IconHelper::getIcon("star", "#F1C40F", 18), "收藏文件", [this, paths](){
@@ -612,13 +668,8 @@ void KeywordSearchWidget::showResultContextMenu(const QPoint& pos) {
 }
 
 void KeywordSearchWidget::onEditFile() {
-    auto selectedItems = m_resultList->selectedItems();
-    if (selectedItems.isEmpty()) return;
-    QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) paths << p;
-    }
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
     QSettings settings("RapidNotes", "ExternalEditor");
     QString editorPath = settings.value("EditorPath").toString();
     if (editorPath.isEmpty() || !QFile::exists(editorPath)) {
@@ -635,17 +686,10 @@ void KeywordSearchWidget::onEditFile() {
 }
 
 void KeywordSearchWidget::copySelectedFiles() {
-    auto selectedItems = m_resultList->selectedItems();
-    if (selectedItems.isEmpty()) return;
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
     QList<QUrl> urls;
-    QStringList paths;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) {
-            urls << QUrl::fromLocalFile(p);
-            paths << p;
-        }
-    }
+    for (const QString& p : std::as_const(paths)) urls << QUrl::fromLocalFile(p);
 
     // 2026-03-20 按照用户要求：复制文件也属于数据导出，必须验证
     if (!verifyExportPermission()) return;
@@ -659,14 +703,10 @@ void KeywordSearchWidget::copySelectedFiles() {
 }
 
 void KeywordSearchWidget::onCutFile() {
-    auto selectedItems = m_resultList->selectedItems();
-    if (selectedItems.isEmpty()) return;
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
     QList<QUrl> urls;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) urls << QUrl::fromLocalFile(p);
-    }
-    if (urls.isEmpty()) return;
+    for (const QString& p : std::as_const(paths)) urls << QUrl::fromLocalFile(p);
     QMimeData* mimeData = new QMimeData();
     mimeData->setUrls(urls);
 #ifdef Q_OS_WIN
@@ -679,26 +719,18 @@ void KeywordSearchWidget::onCutFile() {
 }
 
 void KeywordSearchWidget::onDeleteFile() {
-    auto selectedItems = m_resultList->selectedItems();
-    if (selectedItems.isEmpty()) return;
-    int successCount = 0;
-    for (auto* item : std::as_const(selectedItems)) {
-        QString fp = item->data(Qt::UserRole).toString();
-        if (fp.isEmpty()) continue;
-        if (QFile::moveToTrash(fp)) {
-            successCount++;
-            delete item;
-        }
+    QStringList paths = selectedPaths();
+    if (paths.isEmpty()) return;
+    QStringList deleted;
+    for (const QString& fp : std::as_const(paths)) {
+        if (QFile::moveToTrash(fp)) deleted << fp;
     }
-    if (successCount > 0) ToolTipOverlay::instance()->showText(QCursor::pos(), "[OK] 已删除");
+    m_resultModel->removePaths(deleted);
+    if (!deleted.isEmpty()) ToolTipOverlay::instance()->showText(QCursor::pos(), "[OK] 已删除");
 }
 
 void KeywordSearchWidget::onMergeSelectedFiles() {
-    QStringList paths;
-    for (auto* item : m_resultList->selectedItems()) {
-        QString p = item->data(Qt::UserRole).toString();
-        if (!p.isEmpty()) paths << p;
-    }
+    QStringList paths = selectedPaths();
     if (paths.isEmpty()) return;
     QString rootPath = m_pathEdit->text().trimmed();
     if (!QDir(rootPath).exists()) rootPath = QFileInfo(paths.first()).absolutePath();
@@ -770,29 +802,6 @@ bool KeywordSearchWidget::eventFilter(QObject* watched, QEvent* event) {
     return QWidget::eventFilter(watched, event);
 }
 
-bool KeywordSearchWidget::isTextFile(const QString& filePath) {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) return false;
-    
-    QByteArray chunk = file.read(1024);
-    file.close();
-
-    if (chunk.isEmpty()) return true;
-    if (chunk.contains('\0')) return false;
-
-    return true;
-}
-
-void KeywordSearchWidget::log(const QString& msg, const QString& type, int count) {
-    if (type == "file") {
-        auto* item = new QListWidgetItem(IconHelper::getIcon("file", "#E1523D"), 
-            QString("%1 (匹配 %2 次)").arg(QFileInfo(msg).fileName()).arg(count));
-        item->setData(Qt::UserRole, msg);
-//         item->setToolTip(StringUtils::wrapToolTip(msg));
-        m_resultList->addItem(item);
-    }
-}
-
 void KeywordSearchWidget::onSearch() {
     QString rootDir = m_pathEdit->text().trimmed();
     QString keyword = m_searchEdit->text().trimmed();
@@ -809,76 +818,19 @@ void KeywordSearchWidget::onSearch() {
         addHistoryEntry(Replace, replaceText);
     }
 
-    m_resultList->clear();
+    m_resultModel->clear();
+    m_contextView->hide();
     m_progressBar->show();
     m_progressBar->setRange(0, 0);
     m_statusLabel->setText("正在搜索...");
 
-    QString filter = m_filterEdit->text();
-    bool caseSensitive = m_caseCheck->isChecked();
-
-    (void)QtConcurrent::run([this, rootDir, keyword, filter, caseSensitive]() {
-        int foundFiles = 0;
-        int scannedFiles = 0;
-
-        QStringList filters;
-        if (!filter.isEmpty()) {
-            filters = filter.split(QRegularExpression("[,\\s;]+"), Qt::SkipEmptyParts);
-        }
-
-        QDirIterator it(rootDir, QDir::Files, QDirIterator::Subdirectories);
-        while (it.hasNext()) {
-            QString filePath = it.next();
-            
-            // 过滤目录
-            bool skip = false;
-            for (const QString& ignore : m_ignoreDirs) {
-                if (filePath.contains("/" + ignore + "/") || filePath.contains("\\" + ignore + "\\")) {
-                    skip = true;
-                    break;
-                }
-            }
-            if (skip) continue;
-
-            // 过滤文件名
-            if (!filters.isEmpty()) {
-                bool matchFilter = false;
-                QString fileName = QFileInfo(filePath).fileName();
-                for (const QString& f : filters) {
-                    QRegularExpression re(QRegularExpression::wildcardToRegularExpression(f));
-                    if (re.match(fileName).hasMatch()) {
-                        matchFilter = true;
-                        break;
-                    }
-                }
-                if (!matchFilter) continue;
-            }
-
-            if (!isTextFile(filePath)) continue;
-
-            scannedFiles++;
-            QFile file(filePath);
-            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                QTextStream in(&file);
-                QString content = in.readAll();
-                file.close();
-
-                Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-                if (content.contains(keyword, cs)) {
-                    foundFiles++;
-                    int count = content.count(keyword, cs);
-                    QMetaObject::invokeMethod(this, [this, filePath, count]() {
-                        log(filePath, "file", count);
-                    });
-                }
-            }
-        }
-
-        QMetaObject::invokeMethod(this, [this, scannedFiles, foundFiles, keyword, caseSensitive]() {
-            m_statusLabel->setText(QString("完成: 找到 %1 个文件 (扫描了 %2 个)").arg(foundFiles).arg(scannedFiles));
-            m_progressBar->hide();
-        });
-    });
+    ContentSearcher::Options options;
+    options.rootDir = rootDir;
+    options.keyword = keyword;
+    options.filter = m_filterEdit->text();
+    options.ignoreDirs = m_ignoreDirs;
+    options.caseSensitive = m_caseCheck->isChecked();
+    m_searcher->start(options);
 }
 
 
@@ -898,6 +850,8 @@ void KeywordSearchWidget::onReplace() {
         addHistoryEntry(Replace, replaceText);
     }
 
+    if (m_replacer->isRunning()) return;
+
     // 遵从非阻塞规范，直接执行替换（已有备份机制）
     ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color: #007acc;'>[INFO] 正在开始批量替换...</b>"));
 
@@ -905,123 +859,41 @@ void KeywordSearchWidget::onReplace() {
     m_progressBar->setRange(0, 0);
     m_statusLabel->setText("正在替换...");
 
-    QString filter = m_filterEdit->text();
-    bool caseSensitive = m_caseCheck->isChecked();
-
-    (void)QtConcurrent::run([this, rootDir, keyword, replaceText, filter, caseSensitive]() {
-        int modifiedFiles = 0;
-        QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
-        QString backupDirName = "_backup_" + timestamp;
-        QDir root(rootDir);
-        root.mkdir(backupDirName);
-        m_lastBackupPath = root.absoluteFilePath(backupDirName);
-
-        QStringList filters;
-        if (!filter.isEmpty()) {
-            filters = filter.split(QRegularExpression("[,\\s;]+"), Qt::SkipEmptyParts);
-        }
-
-        QDirIterator it(rootDir, QDir::Files, QDirIterator::Subdirectories);
-        while (it.hasNext()) {
-            QString filePath = it.next();
-            if (filePath.contains(backupDirName)) continue;
-
-            // 过滤目录和文件名（逻辑同搜索）
-            bool skip = false;
-            for (const QString& ignore : m_ignoreDirs) {
-                if (filePath.contains("/" + ignore + "/") || filePath.contains("\\" + ignore + "\\")) {
-                    skip = true;
-                    break;
-                }
-            }
-            if (skip) continue;
-
-            if (!filters.isEmpty()) {
-                bool matchFilter = false;
-                QString fileName = QFileInfo(filePath).fileName();
-                for (const QString& f : filters) {
-                    QRegularExpression re(QRegularExpression::wildcardToRegularExpression(f));
-                    if (re.match(fileName).hasMatch()) {
-                        matchFilter = true;
-                        break;
-                    }
-                }
-                if (!matchFilter) continue;
-            }
-
-            if (!isTextFile(filePath)) continue;
-
-            QFile file(filePath);
-            if (file.open(QIODevice::ReadWrite | QIODevice::Text)) {
-                QTextStream in(&file);
-                QString content = in.readAll();
-                
-                Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-                if (content.contains(keyword, cs)) {
-                    // 备份
-                    QString fileName = QFileInfo(filePath).fileName();
-                    QFile::copy(filePath, m_lastBackupPath + "/" + fileName + ".bak");
-
-                    // 替换
-                    QString newContent;
-                    if (caseSensitive) {
-                        newContent = content.replace(keyword, replaceText);
-                    } else {
-                        newContent = content.replace(QRegularExpression(QRegularExpression::escape(keyword), QRegularExpression::CaseInsensitiveOption), replaceText);
-                    }
-
-                    file.resize(0);
-                    in << newContent;
-                    modifiedFiles++;
-                }
-                file.close();
-            }
-        }
-
-        QMetaObject::invokeMethod(this, [this, modifiedFiles]() {
-            m_statusLabel->setText(QString("替换完成: 修改了 %1 个文件").arg(modifiedFiles));
-            m_progressBar->hide();
-            ToolTipOverlay::instance()->showText(QCursor::pos(), 
-                StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>[OK] 已修改 %1 个文件 (备份于 %2)</b>")
-                .arg(modifiedFiles).arg(QFileInfo(m_lastBackupPath).fileName())));
-        });
-    });
+    // 2026-03-xx 按照用户要求：替换改为事务化执行，原子写入 + 日志，撤销按绝对路径精确恢复
+    ReplaceEngine::Options options;
+    options.rootDir = rootDir;
+    options.keyword = keyword;
+    options.replaceText = replaceText;
+    options.filter = m_filterEdit->text();
+    options.ignoreDirs = m_ignoreDirs;
+    options.caseSensitive = m_caseCheck->isChecked();
+    m_replacer->start(options);
 }
 
 void KeywordSearchWidget::onUndo() {
-    if (m_lastBackupPath.isEmpty() || !QDir(m_lastBackupPath).exists()) {
+    if (m_replacer->isRunning()) return;
+
+    // 备份路径持久化，程序重启 (或崩溃) 后依然可以撤销上一次替换
+    if (m_lastBackupPath.isEmpty()) {
+        QSettings settings("SearchTool_Standalone", "KeywordSearchHistory");
+        m_lastBackupPath = settings.value("lastBackupPath").toString();
+    }
+    if (m_lastBackupPath.isEmpty() || !QFile::exists(ReplaceEngine::journalPath(m_lastBackupPath))) {
         ToolTipOverlay::instance()->showText(QCursor::pos(), StringUtils::wrapToolTip("<b style='color: #e74c3c;'>[ERR] 未找到有效的备份目录！</b>"));
         return;
     }
 
-    int restored = 0;
-    QDir backupDir(m_lastBackupPath);
-    QStringList baks = backupDir.entryList({"*.bak"});
-    
-    QString rootDir = m_pathEdit->text();
-
-    for (const QString& bak : baks) {
-        QString origName = bak.left(bak.length() - 4);
-        
-        // 在根目录下寻找原始文件（简化策略：找同名文件）
-        QDirIterator it(rootDir, {origName}, QDir::Files, QDirIterator::Subdirectories);
-        if (it.hasNext()) {
-            QString targetPath = it.next();
-            if (QFile::remove(targetPath)) {
-                if (QFile::copy(backupDir.absoluteFilePath(bak), targetPath)) {
-                    restored++;
-                }
-            }
-        }
-    }
-
-    m_statusLabel->setText(QString("撤销完成，已恢复 %1 个文件").arg(restored));
-    ToolTipOverlay::instance()->showText(QCursor::pos(), 
-        StringUtils::wrapToolTip(QString("<b style='color: #2ecc71;'>[OK] 已恢复 %1 个文件</b>").arg(restored)));
+    m_progressBar->show();
+    m_progressBar->setRange(0, 0);
+    m_statusLabel->setText("正在撤销...");
+    m_replacer->undo(m_lastBackupPath);
 }
 
 void KeywordSearchWidget::onClearLog() {
-    m_resultList->clear();
+    m_searcher->cancel();
+    m_progressBar->hide();
+    m_resultModel->clear();
+    m_contextView->hide();
     m_statusLabel->setText("就绪");
 }
 
@@ -1041,6 +913,8 @@ void KeywordSearchWidget::focusSearchInput() {
 }
 
 void KeywordSearchWidget::onResultDoubleClicked(const QModelIndex& index) {
+    QString path = index.data(KeywordResultModel::PathRole).toString();
+    if (!path.isEmpty()) QDesktopServices::openUrl(QUrl::fromLocalFile(path));
 }
 
 void KeywordSearchWidget::onSwapSearchReplace() {
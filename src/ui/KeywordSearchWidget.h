@@ -8,9 +8,14 @@
 #include <QCheckBox>
 #include <QProgressBar>
 #include <QLabel>
-#include <QListWidget>
+#include <QListView>
+#include <QPlainTextEdit>
 #include <QSplitter>
 
+class ContentSearcher;
+class ReplaceEngine;
+class KeywordResultModel;
+
 /**
  * @brief 关键字搜索核心组件
  */
@@ -55,9 +60,8 @@ private:
     enum HistoryType { Path, Keyword, Replace };
     void addHistoryEntry(HistoryType type, const QString& text);
     bool verifyExportPermission(); // 2026-03-20 增加导出前的统一身份验证逻辑
-    bool isTextFile(const QString& filePath);
-    void log(const QString& msg, const QString& type = "info", int count = 0);
     void showResultContextMenu(const QPoint& pos);
+    QStringList selectedPaths() const;
     void onMergeFiles(const QStringList& filePaths, const QString& rootPath);
     bool eventFilter(QObject* watched, QEvent* event) override;
 
@@ -66,10 +70,14 @@ private:
     ClickableLineEdit* m_searchEdit;
     ClickableLineEdit* m_replaceEdit;
     QCheckBox* m_caseCheck;
-    QListWidget* m_resultList;
+    QListView* m_resultList;
+    KeywordResultModel* m_resultModel = nullptr;
+    QPlainTextEdit* m_contextView; // 当前选中命中的上下文预览
     QProgressBar* m_progressBar;
     QLabel* m_statusLabel;
 
+    ContentSearcher* m_searcher = nullptr;
+    ReplaceEngine* m_replacer = nullptr;
     QString m_lastBackupPath;
     QStringList m_ignoreDirs;
 };
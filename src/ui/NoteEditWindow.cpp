@@ -676,6 +676,8 @@ void NoteEditWindow::saveNote() {
     QString origApp = m_sourceApp;
     QString origTitle = m_sourceTitle;
     QByteArray origBlob = m_origBlob;
+    // 图片的哈希只取决于未改动的原图；其余类型的哈希随正文变化，交给 updateNote 重新计算
+    QString origHash = (finalType == "image" && m_origItemType == "image") ? m_origContentHash : QString();
 
     (void)QThreadPool::globalInstance()->start([=]() {
         if (noteId == 0) {
@@ -683,7 +685,7 @@ void NoteEditWindow::saveNote() {
         } else {
             // [CRITICAL] 锁定：调用重构后的 updateNote 接口，全量同步所有属性，彻底解决属性破坏问题。
             DatabaseManager::instance().updateNote(noteId, title, content, tagsList, color, catId, 
-                                                finalType, origBlob, origApp, origTitle, remark);
+                                                finalType, origBlob, origApp, origTitle, remark, origHash);
             DatabaseManager::instance().recordAccess(noteId);
         }
         
@@ -744,7 +746,9 @@ void NoteEditWindow::loadNoteData(int id) {
     if (!note.isEmpty()) {
         // [MODIFIED] 2026-03-xx 按照用户要求：加载时备份原始元数据，确保编辑保存时不破坏数据的“身世”。
         m_origItemType = note.value("item_type").toString();
-        m_origBlob = note.value("data_blob").toByteArray();
+        m_origBlob = DatabaseManager::instance().resolveBlob(note);
+        m_origContentHash = note.value("hash_version").toInt() >= DatabaseManager::kContentHashVersion
+                            ? note.value("content_hash").toString() : QString();
         m_sourceApp = note.value("source_app").toString();
         m_sourceTitle = note.value("source_title").toString();
 
@@ -65,6 +65,7 @@ private:
     // 原始属性记录，防止编辑保存时破坏元数据 (用于 updateNote)
     QString m_origItemType;
     QByteArray m_origBlob;
+    QString m_origContentHash; // 原样回写图片时沿用，保存不必重新解码
     QString m_sourceApp;
     QString m_sourceTitle;
 
@@ -12,6 +12,7 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QThread>
+#include <QMenu>
 #include <utility>
 
 OCRWindow::OCRWindow(QWidget* parent) : FramelessDialog("截图取文", parent) {
@@ -23,7 +24,7 @@ OCRWindow::OCRWindow(QWidget* parent) : FramelessDialog("截图取文", parent)
     initUI();
     onClearResults();
     
-    qDebug() << "[OCR] OCRWindow 初始化完成，使用顺序处理模式";
+    qDebug() << "[OCR] OCRWindow 初始化完成，并行上限:" << OCRManager::instance().maxConcurrentRequests();
     
     connect(&OCRManager::instance(), &OCRManager::recognitionFinished, 
             this, &OCRWindow::onRecognitionFinished, 
@@ -32,7 +33,8 @@ OCRWindow::OCRWindow(QWidget* parent) : FramelessDialog("截图取文", parent)
 
 OCRWindow::~OCRWindow() {
     m_processingQueue.clear();
-    m_isProcessing = false;
+    for (int id : std::as_const(m_running)) OCRManager::instance().cancel(id);
+    m_running.clear();
 }
 
 void OCRWindow::initUI() {
@@ -100,6 +102,8 @@ void OCRWindow::initUI() {
         "QListWidget::item:selected { background: #3e3e42; color: white; border-radius: 2px; }" // 2026-03-xx 统一选中色
     );
     connect(m_itemList, &QListWidget::itemSelectionChanged, this, &OCRWindow::onItemSelectionChanged);
+    m_itemList->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(m_itemList, &QListWidget::customContextMenuRequested, this, &OCRWindow::showItemContextMenu);
     middleLayout->addWidget(m_itemList);
 
     middlePanel->setFixedWidth(180);
@@ -165,35 +169,8 @@ void OCRWindow::onPasteAndRecognize() {
         }
     }
 
-    if (!imageData.isEmpty()) {
-        // 限制最多 10 张图片
-        if (imageData.size() > 10) {
-            qDebug() << "[OCR] 粘贴识别: 图片数量超过限制，仅处理前 10 张";
-            imageData = imageData.mid(0, 10);
-        }
-        
-        qDebug() << "[OCR] 粘贴识别: 开始处理" << imageData.size() << "张图片";
-        QList<QImage> imgs;
-        for (auto& p : imageData) {
-            OCRItem item;
-            item.image = p.first;
-            item.name = p.second;
-            // 【核心修复】使用负数 ID 作为临时任务，避免与数据库中的 noteId 冲突导致误更新
-            item.id = -(++m_lastUsedId);
-            item.sessionVersion = m_sessionVersion;
-            m_items.append(item);
-            imgs << p.first;
-            qDebug() << "[OCR] 添加任务 ID:" << item.id << "名称:" << item.name;
-
-            auto* listItem = new QListWidgetItem(item.name, m_itemList);
-            listItem->setData(Qt::UserRole, item.id);
-            listItem->setIcon(IconHelper::getIcon("image", "#888"));
-        }
-        processImages(imgs);
-        
-        // 自动选中第一个新加入的项目
-        m_itemList->setCurrentRow(m_itemList->count() - imageData.size());
-    }
+    qDebug() << "[OCR] 粘贴识别: 开始处理" << imageData.size() << "张图片";
+    addImages(imageData);
 }
 
 void OCRWindow::onBrowseAndRecognize() {
@@ -204,45 +181,23 @@ void OCRWindow::onBrowseAndRecognize() {
     onClearResults();
 
     qDebug() << "[OCR] 浏览识别: 选择了" << files.size() << "个文件";
-    
-    // 限制最多 10 张图片
-    if (files.size() > 10) {
-        qDebug() << "[OCR] 浏览识别: 文件数量超过限制，仅处理前 10 个";
-        files = files.mid(0, 10);
-    }
-    
-    QList<QImage> imgs;
+
+    QList<QPair<QImage, QString>> imageData;
     for (const QString& file : std::as_const(files)) {
         QImage img(file);
-        if (!img.isNull()) {
-            OCRItem item;
-            item.image = img;
-            item.name = QFileInfo(file).fileName();
-            // 【核心修复】使用负数 ID
-            item.id = -(++m_lastUsedId);
-            item.sessionVersion = m_sessionVersion;
-            m_items.append(item);
-            imgs << img;
-            qDebug() << "[OCR] 添加任务 ID:" << item.id << "文件:" << file;
-
-            auto* listItem = new QListWidgetItem(item.name, m_itemList);
-            listItem->setData(Qt::UserRole, item.id);
-            listItem->setIcon(IconHelper::getIcon("image", "#888"));
-        }
-    }
-
-    if (!imgs.isEmpty()) {
-        processImages(imgs);
-        m_itemList->setCurrentRow(m_itemList->count() - imgs.size());
+        if (!img.isNull()) imageData.append({img, QFileInfo(file).fileName()});
     }
+    addImages(imageData);
 }
 
 void OCRWindow::onClearResults() {
     qDebug() << "[OCR] 清空结果";
     
-    m_isProcessing = false;
     m_processingQueue.clear();
+    m_running.clear();
     m_sessionVersion++; // 递增版本号，使旧的回调失效
+    // 正在识别的旧任务直接中止，不再占用识别引擎
+    for (const auto& item : std::as_const(m_items)) OCRManager::instance().cancel(item.id);
     
     m_itemList->clear();
     m_items.clear();
@@ -275,131 +230,176 @@ void OCRWindow::dropEvent(QDropEvent* event) {
     onClearResults();
     
     const QMimeData* mime = event->mimeData();
-    QList<QImage> imgsToProcess;
-
-    // 限制最多 10 张图片
-    int imageCount = 0;
-    const int MAX_IMAGES = 10;
+    QList<QPair<QImage, QString>> imageData;
 
     if (mime->hasImage()) {
         QImage img = qvariant_cast<QImage>(mime->imageData());
-        if (!img.isNull() && imageCount < MAX_IMAGES) {
-            OCRItem item;
-            item.image = img;
-            item.name = "拖入的图片";
-            // 【核心修复】使用负数 ID
-            item.id = -(++m_lastUsedId);
-            item.sessionVersion = m_sessionVersion;
-            m_items.append(item);
-            imgsToProcess << img;
-            imageCount++;
-
-            auto* listItem = new QListWidgetItem(item.name, m_itemList);
-            listItem->setData(Qt::UserRole, item.id);
-            listItem->setIcon(IconHelper::getIcon("image", "#888"));
-        }
+        if (!img.isNull()) imageData.append({img, "拖入的图片"});
     }
 
     if (mime->hasUrls()) {
         for (const QUrl& url : mime->urls()) {
-            if (imageCount >= MAX_IMAGES) {
-                qDebug() << "[OCR] 拖入识别: 已达到最大图片数量限制 (10 张)";
-                break;
-            }
-            
             QString path = url.toLocalFile();
             if (!path.isEmpty()) {
                 QImage img(path);
-                if (!img.isNull()) {
-                    OCRItem item;
-                    item.image = img;
-                    item.name = QFileInfo(path).fileName();
-                    // 【核心修复】使用负数 ID
-                    item.id = -(++m_lastUsedId);
-                    item.sessionVersion = m_sessionVersion;
-                    m_items.append(item);
-                    imgsToProcess << img;
-                    imageCount++;
-
-                    auto* listItem = new QListWidgetItem(item.name, m_itemList);
-                    listItem->setData(Qt::UserRole, item.id);
-                    listItem->setIcon(IconHelper::getIcon("image", "#888"));
-                }
+                if (!img.isNull()) imageData.append({img, QFileInfo(path).fileName()});
             }
         }
     }
 
-    if (!imgsToProcess.isEmpty()) {
-        processImages(imgsToProcess);
-        m_itemList->setCurrentRow(m_itemList->count() - imgsToProcess.size());
+    if (!imageData.isEmpty()) {
+        addImages(imageData);
         event->acceptProposedAction();
     }
 }
 
+// [PERF] 不再限制单批 10 张：派发已按 OCRManager 工作者数限流，其余图片只在队列中等待
+void OCRWindow::addImages(const QList<QPair<QImage, QString>>& images) {
+    if (images.isEmpty()) return;
+
+    QList<QImage> imgs;
+    for (const auto& p : images) {
+        OCRItem item;
+        item.image = p.first;
+        item.name = p.second;
+        // 【核心修复】使用负数 ID 作为临时任务，避免与数据库中的 noteId 冲突导致误更新
+        item.id = -(++m_lastUsedId);
+        item.sessionVersion = m_sessionVersion;
+        m_items.append(item);
+        imgs << p.first;
+        qDebug() << "[OCR] 添加任务 ID:" << item.id << "名称:" << item.name;
+
+        auto* listItem = new QListWidgetItem(item.name, m_itemList);
+        listItem->setData(Qt::UserRole, item.id);
+        listItem->setIcon(IconHelper::getIcon("image", "#888"));
+    }
+    processImages(imgs);
+
+    // 自动选中第一个新加入的项目
+    m_itemList->setCurrentRow(m_itemList->count() - imgs.size());
+}
+
 void OCRWindow::processImages(const QList<QImage>& images) {
     qDebug() << "[OCR] processImages: 添加" << images.size() << "张图片到队列";
-    
-    m_processingQueue.clear(); // 清空旧队列
-    
-    // 将所有图片添加到队列
+    if (images.isEmpty()) return;
+
+    // 空闲 -> 忙碌时才开始计时；上一批仍在识别时追加的图片并入同一批次
+    const bool wasIdle = m_running.isEmpty() && m_processingQueue.isEmpty();
+
+    // 追加到队列末尾 (不清空)，上一批尚未派发的图片继续排队
     int startIdx = m_items.size() - images.size();
     for (int i = 0; i < images.size(); ++i) {
         int taskId = m_items[startIdx + i].id;
-        m_processingQueue.enqueue(taskId);
+        m_processingQueue.append(taskId);
         qDebug() << "[OCR] 添加到队列 ID:" << taskId;
     }
     
-    // 显示并初始化进度条
-    if (m_progressBar && !images.isEmpty()) {
-        m_progressBar->setMaximum(images.size()); // 仅当前批次
-        m_progressBar->setValue(0);
+    // 进度条覆盖全部项目：已完成的计入当前值，新追加的计入总数
+    if (m_progressBar) {
+        m_progressBar->setMaximum(m_items.size());
         m_progressBar->show();
+        updateProgress();
     }
     
-    // 如果当前没有在处理，立即开始处理
-    if (!m_isProcessing) {
-        qDebug() << "[OCR] 开始顺序处理";
-        processNextImage();
-    }
+    if (wasIdle) m_batchTimer.start();
+    processNextImage();
 }
 
 void OCRWindow::processNextImage() {
-    // 检查队列是否为空
-    if (m_processingQueue.isEmpty()) {
-        qDebug() << "[OCR] 所有任务处理完成";
-        m_isProcessing = false;
-        updateRightDisplay();
-        return;
-    }
-    
-    m_isProcessing = true;
-    int taskId = m_processingQueue.dequeue();
-    
-    qDebug() << "[OCR] 开始处理 ID:" << taskId << "剩余:" << m_processingQueue.size();
-    
-    // 找到对应的图片
-    OCRItem* item = nullptr;
-    for (auto& it : m_items) {
-        if (it.id == taskId) {
-            item = &it;
-            break;
+    const int maxInFlight = OCRManager::instance().maxConcurrentRequests();
+    while (m_running.size() < maxInFlight && !m_processingQueue.isEmpty()) {
+        // 当前选中的项目若仍在排队则优先派发，用户正在查看的结果最先出来
+        int index = 0;
+        if (auto* current = m_itemList->currentItem()) {
+            const int selectedPos = m_processingQueue.indexOf(current->data(Qt::UserRole).toInt());
+            if (selectedPos > 0) index = selectedPos;
         }
+        const int taskId = m_processingQueue.takeAt(index);
+
+        OCRItem* item = findItem(taskId);
+        if (!item || item->isFinished) {
+            qDebug() << "[OCR] 跳过任务 ID:" << taskId << "(不存在或已取消)";
+            continue;
+        }
+
+        m_running.insert(taskId);
+        qDebug() << "[OCR] 开始处理 ID:" << taskId << "在途:" << m_running.size() << "剩余:" << m_processingQueue.size();
+        // 识别完成后发射 recognitionFinished，在槽函数中释放名额并派发下一个
+        OCRManager::instance().recognizeAsync(item->image, taskId);
     }
-    
-    if (!item) {
-        qDebug() << "[OCR] 错误: 未找到任务 ID:" << taskId;
-        // 继续处理下一个
-        QMetaObject::invokeMethod(this, &OCRWindow::processNextImage, Qt::QueuedConnection);
+}
+
+OCRWindow::OCRItem* OCRWindow::findItem(int id) {
+    for (auto& item : m_items) {
+        if (item.id == id) return &item;
+    }
+    return nullptr;
+}
+
+void OCRWindow::cancelItem(int id) {
+    OCRItem* item = findItem(id);
+    if (!item || item->isFinished) return;
+
+    if (m_running.contains(id)) {
+        // 识别中：交给 OCRManager 中止，随后仍会收到 "识别已取消" 回调并释放并发名额
+        OCRManager::instance().cancel(id);
         return;
     }
-    
-    // 启动异步识别
-    // 注意：这里我们使用 recognizeAsync，它会在后台线程运行
-    // 识别完成后会发射 recognitionFinished 信号，我们在槽函数中触发下一个任务
-    qDebug() << "[OCR] 调用 recognizeAsync ID:" << taskId;
-    OCRManager::instance().recognizeAsync(item->image, taskId);
+
+    m_processingQueue.removeAll(id);
+    item->result = "识别已取消";
+    item->isFinished = true;
+    updateProgress();
+    updateRightDisplay();
+}
+
+void OCRWindow::updateProgress() {
+    int finished = 0;
+    for (const auto& item : std::as_const(m_items)) {
+        if (item.isFinished) finished++;
+    }
+    qDebug() << "[OCR] 识别进度:" << finished << "/" << m_items.size();
+
+    if (m_progressBar) {
+        m_progressBar->setValue(finished);
+        if (finished >= m_items.size()) {
+            // 完成后延时隐藏；期间又追加了图片则保持显示
+            QTimer::singleShot(700, m_progressBar, [bar = m_progressBar]() {
+                if (bar->value() >= bar->maximum()) bar->hide();
+            });
+        }
+    }
 }
 
+void OCRWindow::showItemContextMenu(const QPoint& pos) {
+    QListWidgetItem* listItem = m_itemList->itemAt(pos);
+    if (!listItem) return;
+    const int id = listItem->data(Qt::UserRole).toInt();
+
+    QMenu menu(this);
+    IconHelper::setupMenu(&menu);
+    menu.setStyleSheet("QMenu { background-color: #2D2D2D; color: #EEE; border: 1px solid #444; padding: 4px; } "
+                       "QMenu::item { padding: 6px 20px 6px 10px; border-radius: 3px; } "
+                       "QMenu::item:selected { background-color: #3e3e42; color: white; }"
+                       "QMenu::item:disabled { color: #666; }");
+
+    if (id == 0) {
+        QList<int> unfinished;
+        for (const auto& item : std::as_const(m_items)) {
+            if (!item.isFinished) unfinished << item.id;
+        }
+        QAction* action = menu.addAction(IconHelper::getIcon("close", "#e74c3c", 18), "取消全部未完成的识别", [this, unfinished]() {
+            for (int taskId : unfinished) cancelItem(taskId);
+        });
+        action->setEnabled(!unfinished.isEmpty());
+    } else {
+        const OCRItem* item = findItem(id);
+        if (!item) return;
+        QAction* action = menu.addAction(IconHelper::getIcon("close", "#e74c3c", 18), "取消识别", [this, id]() { cancelItem(id); });
+        action->setEnabled(!item->isFinished);
+    }
+    menu.exec(m_itemList->mapToGlobal(pos));
+}
 
 void OCRWindow::onItemSelectionChanged() {
     updateRightDisplay();
@@ -409,54 +409,40 @@ void OCRWindow::onRecognitionFinished(const QString& text, int contextId) {
     qDebug() << "[OCR] onRecognitionFinished: 收到识别结果 ID:" << contextId 
              << "线程:" << QThread::currentThread() << "文本长度:" << text.length();
     
-    bool found = false;
-    for (auto& item : m_items) {
-        if (item.id == contextId) {
-            // 检查会话版本号
-            if (item.sessionVersion != m_sessionVersion) {
-                qDebug() << "[OCR] 忽略过期回调 ID:" << contextId 
-                         << "任务会话:" << item.sessionVersion 
-                         << "当前会话:" << m_sessionVersion;
-                // 注意：旧任务的回调不应该触发下一个新任务的处理
-                // 因为新任务的处理循环是由新的 processImages 启动的
-                return; 
-            }
-            
-            item.result = text.trimmed();
-            item.isFinished = true;
-            found = true;
-            qDebug() << "[OCR] 更新任务状态 ID:" << contextId << "名称:" << item.name;
-            break;
-        }
-    }
-    
-    if (!found) {
+    OCRItem* item = findItem(contextId);
+    if (!item) {
         // 如果未找到任务（可能已被清空），也不要触发下一个
         qDebug() << "[OCR] 警告: 未找到对应的任务 ID:" << contextId;
         return;
     }
-    
-    // 统计完成进度
-    int finished = 0;
-    for (const auto& item : std::as_const(m_items)) {
-        if (item.isFinished) finished++;
+    // 检查会话版本号
+    if (item->sessionVersion != m_sessionVersion) {
+        qDebug() << "[OCR] 忽略过期回调 ID:" << contextId 
+                 << "任务会话:" << item->sessionVersion 
+                 << "当前会话:" << m_sessionVersion;
+        return; 
     }
-    qDebug() << "[OCR] 识别进度:" << finished << "/" << m_items.size();
+
+    m_running.remove(contextId);
+    item->result = text.trimmed();
+    item->isFinished = true;
+    qDebug() << "[OCR] 更新任务状态 ID:" << contextId << "名称:" << item->name;
     
-    // 更新进度条
-    if (m_progressBar) {
-        m_progressBar->setValue(finished);
-        if (finished >= m_items.size()) {
-            QTimer::singleShot(700, m_progressBar, &QProgressBar::hide); // 完成1秒后隐藏
-        }
-    }
+    updateProgress();
     
-    // 延迟到主线程更新UI
-    QMetaObject::invokeMethod(this, &OCRWindow::updateRightDisplay, Qt::QueuedConnection);
+    // 逐条推送结果：正在查看该项目或汇总时立即刷新右侧显示 (汇总始终按输入顺序拼接)
+    if (auto* current = m_itemList->currentItem()) {
+        const int shownId = current->data(Qt::UserRole).toInt();
+        if (shownId == 0 || shownId == contextId) updateRightDisplay();
+    }
+
+    if (m_running.isEmpty() && m_processingQueue.isEmpty()) {
+        qDebug() << "[OCR] 批次完成:" << m_items.size() << "张图片，总耗时" << m_batchTimer.elapsed() << "ms";
+        return;
+    }
     
-    // 延迟到下一个事件循环处理任务，避免栈溢出
-    qDebug() << "[OCR] 当前任务完成，准备处理下一个";
-    QMetaObject::invokeMethod(this, &OCRWindow::processNextImage, Qt::QueuedConnection);
+    // 释放了一个并发名额，派发下一个
+    processNextImage();
 }
 
 void OCRWindow::updateRightDisplay() {
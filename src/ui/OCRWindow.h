@@ -10,7 +10,8 @@
 #include <QMap>
 #include <QListWidget>
 #include <QTimer>
-#include <QQueue>
+#include <QSet>
+#include <QElapsedTimer>
 #include <QProgressBar>
 
 class OCRWindow : public FramelessDialog {
@@ -27,7 +28,8 @@ private slots:
     void onClearResults();
     void onCopyResult();
     void onItemSelectionChanged();
-    void processNextImage();  // 处理队列中的下一张图片
+    void processNextImage();  // 在并发上限内派发队列中的图片
+    void showItemContextMenu(const QPoint& pos);
     void onRecognitionFinished(const QString& text, int contextId);
 
 protected:
@@ -36,7 +38,11 @@ protected:
     void keyPressEvent(QKeyEvent* event) override;
 
 private:
+    friend class BenchOcrBatch; // 基准测试经 addImages 驱动完整的排队 / 派发 / 回收流程
+
     void initUI();
+    // 为每张图片建立任务与列表项，并加入识别队列
+    void addImages(const QList<QPair<QImage, QString>>& images);
     void updateRightDisplay();
 
     struct OCRItem {
@@ -48,6 +54,10 @@ private:
         int sessionVersion = 0;
     };
 
+    OCRItem* findItem(int id);
+    void cancelItem(int id);
+    void updateProgress();
+
     QListWidget* m_itemList = nullptr;
     QTextEdit* m_ocrResult = nullptr;
     QProgressBar* m_progressBar = nullptr;
@@ -56,9 +66,11 @@ private:
     int m_lastUsedId = 0;
     int m_sessionVersion = 0;
     
-    // 顺序处理队列
-    QQueue<int> m_processingQueue;  // 待处理的任务 ID 队列
-    bool m_isProcessing = false;  // 是否正在处理
+    // [PERF] 有界并行调度：最多同时提交 OCRManager 工作者数个请求，其余按输入顺序排队；
+    // 派发时优先选择列表中当前选中的项目
+    QList<int> m_processingQueue;  // 待派发的任务 ID (输入顺序)
+    QSet<int> m_running;           // 已提交给 OCRManager、尚未返回的任务 ID
+    QElapsedTimer m_batchTimer;    // 批次总耗时统计
 };
 
 #endif // OCRWINDOW_H
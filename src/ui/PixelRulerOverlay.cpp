@@ -12,6 +12,7 @@
 #include <QKeyEvent>
 #include <QPainter>
 #include <QFontMetrics>
+#include <QtConcurrent>
 #include <cmath>
 
 PixelRulerOverlay::PixelRulerOverlay(QWidget* parent) : QWidget(nullptr) {
@@ -32,6 +33,14 @@ PixelRulerOverlay::PixelRulerOverlay(QWidget* parent) : QWidget(nullptr) {
         cap.geometry = geom;
         cap.dpr = screen->devicePixelRatio();
         cap.image = screen->grabWindow(0, 0, 0, geom.width(), geom.height()).toImage();
+        // [PERF] 每张截图只构建一次边界表，之后每次测量只需二分查找加少量游程比较
+        const QImage image = cap.image;
+        cap.rowRuns = QtConcurrent::run([image]() {
+            return std::make_shared<const PixelRunTable>(PixelRunTable::build(image, Qt::Horizontal));
+        });
+        cap.columnRuns = QtConcurrent::run([image]() {
+            return std::make_shared<const PixelRunTable>(PixelRunTable::build(image, Qt::Vertical));
+        });
         m_captures.append(cap);
     }
     setGeometry(totalRect);
@@ -141,10 +150,10 @@ void PixelRulerOverlay::drawCrossSpacing(QPainter& p, const QPoint& pos) {
     int px = relPos.x() * cap->dpr;
     int py = relPos.y() * cap->dpr;
 
-    int left = findEdge(cap->image, px, py, -1, 0) / cap->dpr;
-    int right = findEdge(cap->image, px, py, 1, 0) / cap->dpr;
-    int top = findEdge(cap->image, px, py, 0, -1) / cap->dpr;
-    int bottom = findEdge(cap->image, px, py, 0, 1) / cap->dpr;
+    int left = edgeDistance(*cap, px, py, -1, 0) / cap->dpr;
+    int right = edgeDistance(*cap, px, py, 1, 0) / cap->dpr;
+    int top = edgeDistance(*cap, px, py, 0, -1) / cap->dpr;
+    int bottom = edgeDistance(*cap, px, py, 0, 1) / cap->dpr;
 
     // 使用橙红色实线 (#ff5722)，对标用户提供的设计图
     p.setPen(QPen(QColor(255, 87, 34), 1, Qt::SolidLine));
@@ -176,16 +185,16 @@ void PixelRulerOverlay::drawOneWaySpacing(QPainter& p, const QPoint& pos, bool h
 
     p.setPen(QPen(QColor(255, 87, 34), 1, Qt::SolidLine));
     if (hor) {
-        int left = findEdge(cap->image, px, py, -1, 0) / cap->dpr;
-        int right = findEdge(cap->image, px, py, 1, 0) / cap->dpr;
+        int left = edgeDistance(*cap, px, py, -1, 0) / cap->dpr;
+        int right = edgeDistance(*cap, px, py, 1, 0) / cap->dpr;
         p.drawLine(pos.x() - left, pos.y(), pos.x() + right, pos.y());
         // 绘制两端截止线
         p.drawLine(pos.x() - left, pos.y() - 10, pos.x() - left, pos.y() + 10);
         p.drawLine(pos.x() + right, pos.y() - 10, pos.x() + right, pos.y() + 10);
         drawLabel(p, pos.x() + (right - left)/2, pos.y() - 20, left + right, true, true);
     } else {
-        int top = findEdge(cap->image, px, py, 0, -1) / cap->dpr;
-        int bottom = findEdge(cap->image, px, py, 0, 1) / cap->dpr;
+        int top = edgeDistance(*cap, px, py, 0, -1) / cap->dpr;
+        int bottom = edgeDistance(*cap, px, py, 0, 1) / cap->dpr;
         p.drawLine(pos.x(), pos.y() - top, pos.x(), pos.y() + bottom);
         p.drawLine(pos.x() - 10, pos.y() - top, pos.x() + 10, pos.y() - top);
         p.drawLine(pos.x() - 10, pos.y() + bottom, pos.x() + 10, pos.y() + bottom);
@@ -239,25 +248,14 @@ void PixelRulerOverlay::drawInfoBox(QPainter& p, const QPoint& pos, const QStrin
     p.drawText(r, Qt::AlignCenter, text);
 }
 
-int PixelRulerOverlay::findEdge(const QImage& img, int x, int y, int dx, int dy) {
-    if (!img.rect().contains(x, y)) return 0;
-    QColor startColor = img.pixelColor(x, y);
-    int dist = 0;
-    int curX = x + dx, curY = y + dy;
-    while (img.rect().contains(curX, curY)) {
-        QColor c = img.pixelColor(curX, curY);
-        // 比较颜色差异,大于阈值则认为遇到了边界
-        // 阈值 10: RGB 总差异 < 10 视为同色,提高边界检测精度
-        if (colorDiff(startColor, c) > 10) break;
-        dist++;
-        curX += dx;
-        curY += dy;
+int PixelRulerOverlay::edgeDistance(const ScreenCapture& cap, int x, int y, int dx, int dy) {
+    const auto& runs = dx != 0 ? cap.rowRuns : cap.columnRuns;
+    if (runs.isFinished()) {
+        const std::shared_ptr<const PixelRunTable> table = runs.result();
+        if (table && !table->isNull()) return table->distance(x, y, dx != 0 ? dx : dy, kEdgeTolerance);
     }
-    return dist;
-}
-
-int PixelRulerOverlay::colorDiff(const QColor& c1, const QColor& c2) {
-    return std::abs(c1.red() - c2.red()) + std::abs(c1.green() - c2.green()) + std::abs(c1.blue() - c2.blue());
+    // 表仍在后台构建：逐像素扫描，阈值 10 (RGB 总差异 < 10 视为同色)
+    return PixelRunTable::scan(cap.image, x, y, dx, dy, kEdgeTolerance);
 }
 
 const PixelRulerOverlay::ScreenCapture* PixelRulerOverlay::getCapture(const QPoint& globalPos) {
@@ -325,18 +323,18 @@ QString PixelRulerOverlay::getMeasurementText(const QPoint& pos) {
     int py = relPos.y() * cap->dpr;
 
     if (m_mode == Spacing) {
-        int left = findEdge(cap->image, px, py, -1, 0) / cap->dpr;
-        int right = findEdge(cap->image, px, py, 1, 0) / cap->dpr;
-        int top = findEdge(cap->image, px, py, 0, -1) / cap->dpr;
-        int bottom = findEdge(cap->image, px, py, 0, 1) / cap->dpr;
+        int left = edgeDistance(*cap, px, py, -1, 0) / cap->dpr;
+        int right = edgeDistance(*cap, px, py, 1, 0) / cap->dpr;
+        int top = edgeDistance(*cap, px, py, 0, -1) / cap->dpr;
+        int bottom = edgeDistance(*cap, px, py, 0, 1) / cap->dpr;
         return QString("%1 × %2").arg(left + right).arg(top + bottom);
     } else if (m_mode == Horizontal) {
-        int left = findEdge(cap->image, px, py, -1, 0) / cap->dpr;
-        int right = findEdge(cap->image, px, py, 1, 0) / cap->dpr;
+        int left = edgeDistance(*cap, px, py, -1, 0) / cap->dpr;
+        int right = edgeDistance(*cap, px, py, 1, 0) / cap->dpr;
         return QString::number(left + right);
     } else if (m_mode == Vertical) {
-        int top = findEdge(cap->image, px, py, 0, -1) / cap->dpr;
-        int bottom = findEdge(cap->image, px, py, 0, 1) / cap->dpr;
+        int top = edgeDistance(*cap, px, py, 0, -1) / cap->dpr;
+        int bottom = edgeDistance(*cap, px, py, 0, 1) / cap->dpr;
         return QString::number(top + bottom);
     }
     return "";
@@ -6,6 +6,9 @@
 #include <QImage>
 #include <QRect>
 #include <QList>
+#include <QFuture>
+#include <memory>
+#include "../core/PixelRunTable.h"
 
 class PixelRulerOverlay : public QWidget {
     Q_OBJECT
@@ -16,8 +19,14 @@ class PixelRulerOverlay : public QWidget {
         QImage image;
         QRect geometry;
         qreal dpr;
+        // [PERF] 行 / 列游程边界表，截图后在工作线程构建，就绪前回退到逐像素扫描
+        QFuture<std::shared_ptr<const PixelRunTable>> rowRuns;
+        QFuture<std::shared_ptr<const PixelRunTable>> columnRuns;
     };
 
+    // 颜色容差：RGB 总差异不超过该值视为同色
+    static constexpr int kEdgeTolerance = 10;
+
 public:
     explicit PixelRulerOverlay(QWidget* parent = nullptr);
     ~PixelRulerOverlay();
@@ -43,8 +52,7 @@ private:
     void drawInfoBox(QPainter& p, const QPoint& pos, const QString& text);
     
     // 工具函数
-    int findEdge(const QImage& img, int x, int y, int dx, int dy);
-    int colorDiff(const QColor& c1, const QColor& c2);
+    int edgeDistance(const ScreenCapture& cap, int x, int y, int dx, int dy);
     const ScreenCapture* getCapture(const QPoint& globalPos);
     
     // 测量与保存
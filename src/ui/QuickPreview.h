@@ -407,7 +407,7 @@ public:
         m_currentNoteId = noteId;
         m_currentTitle = note.value("title").toString();
         m_currentType = note.value("item_type").toString();
-        m_currentData = note.value("data_blob").toByteArray();
+        m_currentData = DatabaseManager::instance().resolveBlob(note);
         m_pureContent = note.value("content").toString();
 
         if (m_searchEdit) m_searchEdit->clear();
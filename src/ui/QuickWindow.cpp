@@ -1663,7 +1663,7 @@ void QuickWindow::activateNote(const QModelIndex& index) {
 
     QString itemType = note.value("item_type").toString();
     QString content = note.value("content").toString();
-    QByteArray blob = note.value("data_blob").toByteArray();
+    QByteArray blob = DatabaseManager::instance().resolveBlob(note);
 
     if (itemType == "image") {
         QImage img;
@@ -2875,7 +2875,7 @@ void QuickWindow::sendNote(const QVariantMap& note) {
     int id = note.value("id").toInt();
     QString itemType = note.value("item_type").toString();
     QString content = note.value("content").toString();
-    QByteArray blob = note.value("data_blob").toByteArray();
+    QByteArray blob = DatabaseManager::instance().resolveBlob(note);
 
     
     DatabaseManager::instance().recordAccess(id);
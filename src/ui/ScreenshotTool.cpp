@@ -3,6 +3,7 @@
 #include "StringUtils.h"
 
 #include "IconHelper.h"
+#include "../core/ImageSaveService.h"
 #include <QApplication>
 #include <QScreen>
 #include <QPainterPathStroker>
@@ -31,6 +32,7 @@
 #include <QDir>
 #include <QGraphicsDropShadowEffect>
 #include <QCoreApplication>
+#include <QtConcurrent>
 #include <cmath>
 
 #ifdef Q_OS_WIN
@@ -367,6 +369,32 @@ void ScreenshotToolbar::createOptionWidget() {
     connect(m_outlineBtn, &QPushButton::clicked, [this]{ m_tool->setFillEnabled(false); });
     connect(m_solidBtn, &QPushButton::clicked, [this]{ m_tool->setFillEnabled(true); });
 
+    // 2.1 马赛克效果选项 (Mosaic/MosaicRect)：像素化 / 模糊，强度通过 Ctrl+滚轮 调整
+    m_pixelateBtn = new QPushButton();
+    m_pixelateBtn->setCheckable(true);
+    m_pixelateBtn->setFixedSize(24, 24);
+    m_pixelateBtn->setIcon(IconHelper::getIcon("screenshot_mosaic", "#ffffff"));
+    m_pixelateBtn->setProperty("tooltipText", "像素化 （Ctrl+滚轮 调整强度）");
+    m_pixelateBtn->installEventFilter(this);
+    m_pixelateBtn->setStyleSheet("QPushButton { border: 1px solid #555; border-radius: 4px; } QPushButton:checked { background-color: #3e3e42; border-color: #007ACC; }");
+
+    m_blurBtn = new QPushButton();
+    m_blurBtn->setCheckable(true);
+    m_blurBtn->setFixedSize(24, 24);
+    m_blurBtn->setIcon(IconHelper::getIcon("screenshot_blur", "#ffffff"));
+    m_blurBtn->setProperty("tooltipText", "模糊 （Ctrl+滚轮 调整强度）");
+    m_blurBtn->installEventFilter(this);
+    m_blurBtn->setStyleSheet("QPushButton { border: 1px solid #555; border-radius: 4px; } QPushButton:checked { background-color: #3e3e42; border-color: #007ACC; }");
+
+    auto* mosaicGroup = new QButtonGroup(this);
+    mosaicGroup->addButton(m_pixelateBtn);
+    mosaicGroup->addButton(m_blurBtn);
+    layout->addWidget(m_pixelateBtn);
+    layout->addWidget(m_blurBtn);
+    if (m_tool->m_currentMosaicEffect == ImageFilterHelper::Effect::Blur) m_blurBtn->setChecked(true); else m_pixelateBtn->setChecked(true);
+    connect(m_pixelateBtn, &QPushButton::clicked, [this]{ m_tool->setMosaicEffect(ImageFilterHelper::Effect::Pixelate); });
+    connect(m_blurBtn, &QPushButton::clicked, [this]{ m_tool->setMosaicEffect(ImageFilterHelper::Effect::Blur); });
+
     // 3. 文字选项 (Text) - 采用独立胶囊布局 (Independent capsule layout)
     m_textOptionWidget = new QWidget(m_optionWidget);
     m_textOptionWidget->setAttribute(Qt::WA_TranslucentBackground);
@@ -783,14 +811,17 @@ void ScreenshotToolbar::selectTool(ScreenshotToolType type) {
     bool isArrow = (type == ScreenshotToolType::Arrow);
     bool isRectOrEllipse = (type == ScreenshotToolType::Rect || type == ScreenshotToolType::Ellipse);
     bool isText = (type == ScreenshotToolType::Text);
+    bool isMosaic = (type == ScreenshotToolType::Mosaic || type == ScreenshotToolType::MosaicRect);
 
     m_arrowStyleBtn->setVisible(isArrow);
     m_outlineBtn->setVisible(isRectOrEllipse);
     m_solidBtn->setVisible(isRectOrEllipse);
+    m_pixelateBtn->setVisible(isMosaic);
+    m_blurBtn->setVisible(isMosaic);
     m_textOptionWidget->setVisible(isText);
 
     if (m_textDivider) {
-        m_textDivider->setVisible(isArrow || isRectOrEllipse || isText);
+        m_textDivider->setVisible(isArrow || isRectOrEllipse || isText || isMosaic);
     }
 
     m_tool->setTool(type); 
@@ -858,7 +889,8 @@ ScreenshotTool::ScreenshotTool(QWidget* parent)
     m_screenPixmap = QGuiApplication::primaryScreen()->grabWindow(0);
     m_screenImage = m_screenPixmap.toImage();
     // [OPTIMIZATION] 移除初始化时的全屏马赛克生成，改为“按需延迟生成”以节省显存 (约节省 130MB+ / 4K屏)
-    m_mosaicPixmap = QPixmap();
+    // [PERF] 马赛克/模糊按标注覆盖的分块局部计算，这里只共享底图数据，不做任何预处理
+    m_mosaicCache.setSource(m_screenImage);
 
     QSettings settings("RapidNotes", "Screenshot");
     m_currentColor = settings.value("color", QColor(255, 50, 50)).value<QColor>();
@@ -869,6 +901,9 @@ ScreenshotTool::ScreenshotTool(QWidget* parent)
     m_currentFontSize = settings.value("fontSize", 14).toInt();
     m_currentBold = settings.value("bold", true).toBool();
     m_currentItalic = settings.value("italic", false).toBool();
+    m_currentMosaicEffect = static_cast<ImageFilterHelper::Effect>(settings.value("mosaicEffect", 0).toInt());
+    m_currentMosaicStrength = std::clamp(settings.value("mosaicStrength", ImageFilterHelper::kDefaultStrength).toInt(),
+                                         ImageFilterHelper::kMinStrength, ImageFilterHelper::kMaxStrength);
     m_isConfirmed = false;
 
     m_toolbar = new ScreenshotToolbar(this); m_toolbar->hide();
@@ -886,7 +921,8 @@ void ScreenshotTool::cancel() {
     // [OPTIMIZATION] 退出时显式释放巨大全屏资源，防止 deleteLater 延迟析构导致的内存堆叠
     m_screenPixmap = QPixmap();
     m_screenImage = QImage();
-    m_mosaicPixmap = QPixmap();
+    m_mosaicCache.clear();
+    m_annotationLayer = QImage();
     close(); 
 }
 
@@ -900,6 +936,27 @@ int BaseShape::getHandleAt(const QPoint& pos) const {
 
 void BaseShape::moveBy(const QPoint& delta) {
     for (auto& p : data.points) p += delta;
+    invalidateBounds();
+}
+
+QRect BaseShape::bounds() const {
+    if (!m_boundsValid) {
+        m_bounds = computeBounds();
+        m_boundsValid = true;
+    }
+    return m_bounds;
+}
+
+QRect BaseShape::computeBounds() const {
+    if (data.points.isEmpty()) return QRect();
+    qreal minX = data.points[0].x(), maxX = minX, minY = data.points[0].y(), maxY = minY;
+    for (const QPointF& pt : data.points) {
+        minX = std::min(minX, pt.x()); maxX = std::max(maxX, pt.x());
+        minY = std::min(minY, pt.y()); maxY = std::max(maxY, pt.y());
+    }
+    // 外扩量覆盖：箭头头部 (24 + 2w)、马赛克笔刷半宽 (3w)、各形状命中容差 (最大 15 / w + 8) 与 10px 句柄
+    const int margin = 24 + data.strokeWidth * 3 + 2;
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY)).toAlignedRect().adjusted(-margin, -margin, margin, margin);
 }
 
 static bool isNearLine(const QPointF& p, const QPointF& s, const QPointF& e, int threshold) {
@@ -910,7 +967,7 @@ static bool isNearLine(const QPointF& p, const QPointF& s, const QPointF& e, int
     return (p - projection).manhattanLength() < threshold;
 }
 
-void RectShape::draw(QPainter& p, const QPixmap&) const {
+void RectShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.size() < 2) return;
     p.setPen(QPen(data.color, data.strokeWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
     p.setBrush(data.isFilled ? QBrush(data.color) : Qt::NoBrush);
@@ -943,9 +1000,10 @@ void RectShape::updatePoint(int index, const QPoint& pos) {
     else if (index == 2) { r.setBottomRight(pos); }
     else if (index == 3) { r.setBottomLeft(pos); }
     data.points[0] = r.topLeft(); data.points[1] = r.bottomRight();
+    invalidateBounds();
 }
 
-void EllipseShape::draw(QPainter& p, const QPixmap&) const {
+void EllipseShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.size() < 2) return;
     p.setPen(QPen(data.color, data.strokeWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
     p.setBrush(data.isFilled ? QBrush(data.color) : Qt::NoBrush);
@@ -978,9 +1036,10 @@ void EllipseShape::updatePoint(int index, const QPoint& pos) {
     else if (index == 2) { r.setBottomRight(pos); }
     else if (index == 3) { r.setBottomLeft(pos); }
     data.points[0] = r.topLeft(); data.points[1] = r.bottomRight();
+    invalidateBounds();
 }
 
-void LineShape::draw(QPainter& p, const QPixmap&) const {
+void LineShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.size() < 2) return;
     p.setPen(QPen(data.color, data.strokeWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
     p.drawLine(data.points[0], data.points[1]);
@@ -999,7 +1058,7 @@ QList<QRect> LineShape::getHandles() const {
     return h;
 }
 
-void ArrowShape::draw(QPainter& p, const QPixmap&) const {
+void ArrowShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.size() < 2) return;
     QPointF start = data.points[0], end = data.points[1];
     QPointF dir = end - start;
@@ -1065,7 +1124,7 @@ QList<QRect> ArrowShape::getHandles() const {
     return h;
 }
 
-void PenShape::draw(QPainter& p, const QPixmap&) const {
+void PenShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.size() < 2) return;
     p.setPen(QPen(data.color, data.strokeWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
     QPainterPath path; path.moveTo(data.points[0]);
@@ -1080,7 +1139,7 @@ bool PenShape::hitTest(const QPoint& pos) const {
     return false;
 }
 
-void MarkerShape::draw(QPainter& p, const QPixmap&) const {
+void MarkerShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.isEmpty()) return;
     p.setBrush(data.color); p.setPen(Qt::NoPen); int r = 12 + data.strokeWidth;
     p.drawEllipse(data.points[0], r, r); p.setPen(Qt::white); p.setFont(QFont("Arial", r, QFont::Bold));
@@ -1093,7 +1152,7 @@ bool MarkerShape::hitTest(const QPoint& pos) const {
     return (pos - data.points[0].toPoint()).manhattanLength() < r + 5;
 }
 
-void TextShape::draw(QPainter& p, const QPixmap&) const {
+void TextShape::draw(QPainter& p, MosaicTileCache&) const {
     if (data.points.isEmpty() || data.text.isEmpty()) return;
     p.setPen(data.color);
     QFont font(data.fontFamily, data.fontSize);
@@ -1112,6 +1171,16 @@ bool TextShape::hitTest(const QPoint& pos) const {
     return r.adjusted(-10, -10, 10, 10).contains(pos);
 }
 
+QRect TextShape::computeBounds() const {
+    if (data.points.isEmpty() || data.text.isEmpty()) return QRect();
+    QFont font(data.fontFamily, data.fontSize);
+    font.setBold(data.isBold); font.setItalic(data.isItalic);
+    QRect r = QFontMetrics(font).boundingRect(data.text);
+    r.moveTo(data.points[0].toPoint().x(), data.points[0].toPoint().y() - r.height());
+    // 与 hitTest 的 10px 容差及左上角句柄保持一致
+    return r.united(getHandles().value(0)).adjusted(-10, -10, 10, 10);
+}
+
 QList<QRect> TextShape::getHandles() const {
     if (data.points.isEmpty() || data.text.isEmpty()) return {};
     QList<QRect> h; int s = 10;
@@ -1120,14 +1189,15 @@ QList<QRect> TextShape::getHandles() const {
     return h;
 }
 
-void MosaicShape::draw(QPainter& p, const QPixmap& mosaicPixmap) const {
+void MosaicShape::draw(QPainter& p, MosaicTileCache& mosaic) const {
     if (data.points.size() < 2) return;
     p.save();
     QPainterPath path; path.moveTo(data.points[0]);
     for(int i=1; i<data.points.size(); ++i) path.lineTo(data.points[i]);
     QPainterPathStroker s; s.setWidth(data.strokeWidth * 6);
-    p.setClipPath(s.createStroke(path));
-    p.drawPixmap(0, 0, mosaicPixmap);
+    const QPainterPath stroke = s.createStroke(path);
+    p.setClipPath(stroke, Qt::IntersectClip);
+    mosaic.draw(p, stroke.boundingRect(), data.mosaicEffect, data.mosaicStrength);
     p.restore();
 }
 
@@ -1138,11 +1208,12 @@ bool MosaicShape::hitTest(const QPoint& pos) const {
     return false;
 }
 
-void MosaicRectShape::draw(QPainter& p, const QPixmap& mosaicPixmap) const {
+void MosaicRectShape::draw(QPainter& p, MosaicTileCache& mosaic) const {
     if (data.points.size() < 2) return;
     p.save();
-    p.setClipRect(QRectF(data.points[0], data.points[1]).normalized());
-    p.drawPixmap(0, 0, mosaicPixmap);
+    const QRectF area = QRectF(data.points[0], data.points[1]).normalized();
+    p.setClipRect(area, Qt::IntersectClip);
+    mosaic.draw(p, area, data.mosaicEffect, data.mosaicStrength);
     p.restore();
 }
 
@@ -1168,6 +1239,114 @@ void MosaicRectShape::updatePoint(int index, const QPoint& pos) {
     else if (index == 2) { r.setBottomRight(pos); }
     else if (index == 3) { r.setBottomLeft(pos); }
     data.points[0] = r.topLeft(); data.points[1] = r.bottomRight();
+    invalidateBounds();
+}
+
+void MosaicTileCache::setSource(const QImage& source) {
+    m_source = source;
+    m_tiles.clear();
+}
+
+void MosaicTileCache::clear() {
+    m_source = QImage();
+    m_tiles.clear();
+}
+
+quint64 MosaicTileCache::tileKey(int col, int row, ImageFilterHelper::Effect effect, int strength) {
+    return quint64(quint16(col)) | (quint64(quint16(row)) << 16) | (quint64(quint8(strength)) << 32) | (quint64(effect) << 40);
+}
+
+void MosaicTileCache::draw(QPainter& painter, const QRectF& logicalRect, ImageFilterHelper::Effect effect, int strength) {
+    if (m_source.isNull() || logicalRect.isEmpty()) return;
+    const qreal dpr = m_source.devicePixelRatio();
+    const QRect pixelRect = QRectF(logicalRect.topLeft() * dpr, logicalRect.size() * dpr).toAlignedRect().intersected(m_source.rect());
+    if (pixelRect.isEmpty()) return;
+
+    struct TileJob { int col; int row; quint64 key; QImage image; };
+    QList<TileJob> cached;
+    QList<TileJob> missing;
+    for (int row = pixelRect.top() / kTileSize; row <= pixelRect.bottom() / kTileSize; ++row) {
+        for (int col = pixelRect.left() / kTileSize; col <= pixelRect.right() / kTileSize; ++col) {
+            const quint64 key = tileKey(col, row, effect, strength);
+            if (const QImage* tile = m_tiles.object(key)) cached.append({col, row, key, *tile});
+            else missing.append({col, row, key, QImage()});
+        }
+    }
+
+    // 缺失的块并行计算；块内是可分离的逐行/逐列滤波
+    if (!missing.isEmpty()) {
+        const QImage source = m_source;
+        QtConcurrent::blockingMap(missing, [&source, effect, strength](TileJob& job) {
+            job.image = ImageFilterHelper::apply(source, QRect(job.col * kTileSize, job.row * kTileSize, kTileSize, kTileSize), effect, strength);
+            job.image.setDevicePixelRatio(source.devicePixelRatio());
+        });
+    }
+
+    for (const QList<TileJob>* jobs : {&cached, &missing}) {
+        for (const TileJob& job : *jobs) {
+            if (!job.image.isNull()) painter.drawImage(QPointF(job.col * kTileSize / dpr, job.row * kTileSize / dpr), job.image);
+        }
+    }
+    for (TileJob& job : missing) {
+        if (job.image.isNull()) continue;
+        const int cost = std::max(1, int(job.image.sizeInBytes() / 1024));
+        m_tiles.insert(job.key, new QImage(std::move(job.image)), cost);
+    }
+}
+
+void RectGridIndex::clear() {
+    m_rects.clear();
+    m_cells.clear();
+    m_cols = m_rows = 0;
+}
+
+void RectGridIndex::build(const QList<QRect>& rects, const QRect& bounds, int cellSize) {
+    clear();
+    m_bounds = bounds;
+    m_cellSize = std::max(8, cellSize);
+    if (bounds.isEmpty()) return;
+
+    // 过滤过小的杂质 (宽或高 < 10)，稳定排序保证面积相同时仍取原检测顺序中靠前的一个
+    for (const QRect& r : rects) {
+        if (r.width() >= 10 && r.height() >= 10 && r.intersects(bounds)) m_rects.append(r);
+    }
+    std::stable_sort(m_rects.begin(), m_rects.end(), [](const QRect& a, const QRect& b) {
+        return qint64(a.width()) * a.height() < qint64(b.width()) * b.height();
+    });
+    // 去重：相同矩形面积必然相同，只需在同面积区间内比较
+    QList<QRect> unique;
+    unique.reserve(m_rects.size());
+    qsizetype groupStart = 0;
+    for (const QRect& r : std::as_const(m_rects)) {
+        const qint64 area = qint64(r.width()) * r.height();
+        if (!unique.isEmpty() && qint64(unique.last().width()) * unique.last().height() != area) groupStart = unique.size();
+        bool duplicate = false;
+        for (qsizetype i = groupStart; i < unique.size() && !duplicate; ++i) duplicate = unique[i] == r;
+        if (!duplicate) unique.append(r);
+    }
+    m_rects = std::move(unique);
+
+    m_cols = (bounds.width() + m_cellSize - 1) / m_cellSize;
+    m_rows = (bounds.height() + m_cellSize - 1) / m_cellSize;
+    m_cells.resize(m_cols * m_rows);
+    for (int i = 0; i < m_rects.size(); ++i) {
+        const QRect r = m_rects[i].intersected(bounds).translated(-bounds.topLeft());
+        const int c0 = r.left() / m_cellSize, c1 = r.right() / m_cellSize;
+        const int r0 = r.top() / m_cellSize, r1 = r.bottom() / m_cellSize;
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) m_cells[row * m_cols + col].append(i);
+        }
+    }
+}
+
+QRect RectGridIndex::smallestContaining(const QPoint& pos) const {
+    if (m_cells.isEmpty() || !m_bounds.contains(pos)) return QRect();
+    const QPoint local = pos - m_bounds.topLeft();
+    const QList<int>& candidates = m_cells[(local.y() / m_cellSize) * m_cols + local.x() / m_cellSize];
+    for (int i : candidates) {
+        if (m_rects[i].contains(pos)) return m_rects[i];
+    }
+    return QRect();
 }
 
 static BaseShape* createShape(const DrawingAnnotation& ann) {
@@ -1196,7 +1375,7 @@ void ScreenshotTool::mousePressEvent(QMouseEvent* e) {
         // 取色后切回上一个工具，如果上一个是 None 则保持 None
         setTool(ScreenshotToolType::None);
         m_toolbar->selectTool(ScreenshotToolType::None);
-        update();
+        updateOverlay();
         return;
     }
     if(e->button() == Qt::RightButton) {
@@ -1209,13 +1388,7 @@ void ScreenshotTool::mousePressEvent(QMouseEvent* e) {
 
     // 强化：在按下鼠标时重新进行一次命中测试，确保 hoveredShape 准确
     if (m_state == ScreenshotState::Editing && !m_isDragging && !m_isDrawing) {
-        m_hoveredShape = nullptr;
-        for (int i = m_annotations.size() - 1; i >= 0; --i) {
-            if (m_annotations[i]->hitTest(e->pos()) || m_annotations[i]->getHandleAt(e->pos()) != -1) {
-                m_hoveredShape = m_annotations[i];
-                break;
-            }
-        }
+        m_hoveredShape = shapeAt(e->pos());
     }
 
     if (m_state == ScreenshotState::Selecting) {
@@ -1225,8 +1398,8 @@ void ScreenshotTool::mousePressEvent(QMouseEvent* e) {
         if (m_hoveredShape) {
             int handle = m_hoveredShape->getHandleAt(e->pos());
             // [CRITICAL] 使用 m_dragOrigin 而不是 m_startPoint，防止修改选区大小 / Use m_dragOrigin to prevent selection resize
-            if (handle != -1) { m_editHandle = handle; m_dragOrigin = e->pos(); m_isDragging = true; update(); return; }
-            if (m_hoveredShape->hitTest(e->pos())) { m_editHandle = 100; m_dragOrigin = e->pos(); m_isDragging = true; update(); return; }
+            if (handle != -1) { m_editHandle = handle; m_dragOrigin = e->pos(); m_isDragging = true; updateOverlay(); return; }
+            if (m_hoveredShape->hitTest(e->pos())) { m_editHandle = 100; m_dragOrigin = e->pos(); m_isDragging = true; updateOverlay(); return; }
         }
 
         int handle = getHandleAt(e->pos());
@@ -1234,6 +1407,8 @@ void ScreenshotTool::mousePressEvent(QMouseEvent* e) {
             if (m_currentTool == ScreenshotToolType::Text) { showTextInput(e->pos()); return; }
             m_isDrawing = true; m_currentAnnotation = {m_currentTool, {e->pos()}, m_currentColor, "", m_currentStrokeWidth, LineStyle::Solid, m_currentArrowStyle, m_fillEnabled, 
                                                        m_currentFontFamily, m_currentFontSize, m_currentBold, m_currentItalic};
+            m_currentAnnotation.mosaicEffect = m_currentMosaicEffect;
+            m_currentAnnotation.mosaicStrength = m_currentMosaicStrength;
             if(m_currentTool == ScreenshotToolType::Marker) {
                 int c = 1; for(auto* a : std::as_const(m_annotations)) if(a->data.type == ScreenshotToolType::Marker) c++;
                 m_currentAnnotation.text = QString::number(c);
@@ -1250,49 +1425,31 @@ void ScreenshotTool::mousePressEvent(QMouseEvent* e) {
             m_dragHandle = 8; m_dragOrigin = e->pos(); m_isDragging = true;
         }
     }
-    update();
+    updateOverlay();
 }
 
 void ScreenshotTool::mouseMoveEvent(QMouseEvent* e) {
     m_lastMouseMovePos = e->pos();
     if (m_state == ScreenshotState::Selecting && !m_isDragging) {
-        QRect smallest; long long minArea = -1;
-        QPoint p = e->pos();
-        
-        // 2026-03-xx 改进算法：在包含鼠标点的矩形中，寻找面积最小的那个。
-        // 同时引入“宽高比”保护，防止选中极其细长的线条控件。
-        for (const QRect& r : std::as_const(m_detectedRects)) {
-            if (r.contains(p)) {
-                // 过滤掉面积过小的杂质
-                if (r.width() < 10 || r.height() < 10) continue;
-                
-                long long area = (long long)r.width() * r.height();
-                if (minArea == -1 || area < minArea) {
-                    minArea = area;
-                    smallest = r;
-                }
-            }
-        }
+        // 2026-03-xx 改进算法：在包含鼠标点的矩形中，寻找面积最小的那个 (过滤宽高 < 10 的杂质)。
+        // [PERF] 改为查询网格索引，只扫描鼠标所在格子的候选，不再每次移动遍历全部检测矩形
+        QRect smallest = m_rectIndex.smallestContaining(e->pos());
         
         // 增加逻辑：如果找到了最小矩形，但其面积占据了全屏的 95% 以上，通常意味着选中的是桌面背景，
         // 此时我们尝试寻找更具体的子项，或者保持原样。
         
         if (m_highlightedRect != smallest) {
             m_highlightedRect = smallest;
-            update();
+            updateOverlay();
         }
     } else {
         m_highlightedRect = QRect();
     }
 
     if (!m_isDragging && !m_isDrawing && m_state == ScreenshotState::Editing) {
-        BaseShape* prevHover = m_hoveredShape; m_hoveredShape = nullptr;
-        for (int i = m_annotations.size() - 1; i >= 0; --i) {
-            if (m_annotations[i]->hitTest(e->pos()) || m_annotations[i]->getHandleAt(e->pos()) != -1) {
-                m_hoveredShape = m_annotations[i]; break;
-            }
-        }
-        if (prevHover != m_hoveredShape) update();
+        BaseShape* prevHover = m_hoveredShape;
+        m_hoveredShape = shapeAt(e->pos());
+        if (prevHover != m_hoveredShape) updateOverlay();
     }
 
     if (m_isDragging) {
@@ -1300,14 +1457,15 @@ void ScreenshotTool::mouseMoveEvent(QMouseEvent* e) {
         if (m_editHandle != -1 && m_hoveredShape) {
             if (m_editHandle == 100) { m_hoveredShape->moveBy(p - m_dragOrigin); m_dragOrigin = p; }
             else { m_hoveredShape->updatePoint(m_editHandle, p); }
-            update(); return;
+            updateOverlay(); return;
         }
         if (m_currentTool == ScreenshotToolType::Eraser) {
-            bool changed = false;
+            QRegion erased;
             for (int i = m_annotations.size() - 1; i >= 0; --i) {
-                if (m_annotations[i]->hitTest(p)) { m_redoStack.append(m_annotations.takeAt(i)); changed = true; if(m_hoveredShape == m_redoStack.last()) m_hoveredShape = nullptr; }
+                if (m_annotations[i]->bounds().contains(p) && m_annotations[i]->hitTest(p)) { erased += m_annotations[i]->bounds(); m_redoStack.append(m_annotations.takeAt(i)); if(m_hoveredShape == m_redoStack.last()) m_hoveredShape = nullptr; }
             }
-            if (changed) update(); return;
+            if (!erased.isEmpty()) invalidateAnnotationLayer(erased);
+            return;
         }
         if (m_state == ScreenshotState::Selecting) {
             m_endPoint = e->pos();
@@ -1331,8 +1489,9 @@ void ScreenshotTool::mouseMoveEvent(QMouseEvent* e) {
         if (m_currentTool == ScreenshotToolType::Arrow || m_currentTool == ScreenshotToolType::Line || m_currentTool == ScreenshotToolType::Rect || m_currentTool == ScreenshotToolType::Ellipse || m_currentTool == ScreenshotToolType::MosaicRect) {
             if (m_activeShape->data.points.size() > 1) m_activeShape->data.points[1] = e->pos(); else m_activeShape->data.points.append(e->pos());
         } else m_activeShape->data.points.append(e->pos());
+        m_activeShape->invalidateBounds();
     } else updateCursor(e->pos());
-    update();
+    updateOverlay();
 }
 
 void ScreenshotTool::mouseReleaseEvent(QMouseEvent* e) {
@@ -1344,11 +1503,11 @@ void ScreenshotTool::mouseReleaseEvent(QMouseEvent* e) {
                 delete m_activeShape; 
                 m_activeShape = nullptr; 
             }
-            update(); 
+            updateOverlay(); 
         } else if (m_currentTool != ScreenshotToolType::None) { 
             m_currentTool = ScreenshotToolType::None; 
             m_toolbar->selectTool(ScreenshotToolType::None); 
-            update(); 
+            updateOverlay(); 
         } else {
             cancel(); 
         }
@@ -1363,6 +1522,7 @@ void ScreenshotTool::mouseReleaseEvent(QMouseEvent* e) {
             m_activeShape = nullptr;
             qDeleteAll(m_redoStack);
             m_redoStack.clear();
+            m_annotationLayerDirty = true;
         }
     }
     else if (m_isDragging) {
@@ -1376,6 +1536,7 @@ void ScreenshotTool::mouseReleaseEvent(QMouseEvent* e) {
                 m_state = ScreenshotState::Editing;
                 m_highlightedRect = QRect();
                 m_detectedRects.clear();
+                m_rectIndex.clear();
             }
         }
     }
@@ -1387,7 +1548,7 @@ void ScreenshotTool::mouseReleaseEvent(QMouseEvent* e) {
         updateToolbarPosition(); m_toolbar->show(); m_infoBar->updateInfo(selectionRect());
         m_infoBar->show(); m_infoBar->move(selectionRect().left(), selectionRect().top() - 35);
     }
-    update();
+    updateOverlay();
 }
 
 void ScreenshotTool::contextMenuEvent(QContextMenuEvent* event) {
@@ -1413,7 +1574,20 @@ void ScreenshotTool::updateToolbarPosition() {
 
 void ScreenshotTool::wheelEvent(QWheelEvent* event) {
     int delta = event->angleDelta().y();
-    if (m_hoveredShape) {
+    // 马赛克强度：矩形马赛克直接滚轮，画笔马赛克 Ctrl+滚轮 (普通滚轮仍调整笔刷粗细)
+    auto adjustsStrength = [&](ScreenshotToolType type) {
+        return type == ScreenshotToolType::MosaicRect || (type == ScreenshotToolType::Mosaic && (event->modifiers() & Qt::ControlModifier));
+    };
+    if (m_hoveredShape && adjustsStrength(m_hoveredShape->data.type)) {
+        int& strength = m_hoveredShape->data.mosaicStrength;
+        strength = std::clamp(strength + (delta > 0 ? 1 : -1), ImageFilterHelper::kMinStrength, ImageFilterHelper::kMaxStrength);
+        invalidateAnnotationLayer(m_hoveredShape->bounds());
+        ToolTipOverlay::instance()->showText(QCursor::pos(), QString("强度: %1").arg(strength), 700);
+    } else if (!m_hoveredShape && adjustsStrength(m_currentTool)) {
+        setMosaicStrength(m_currentMosaicStrength + (delta > 0 ? 1 : -1));
+        ToolTipOverlay::instance()->showText(QCursor::pos(), QString("强度: %1").arg(m_currentMosaicStrength), 700);
+    } else if (m_hoveredShape) {
+        const QRect before = m_hoveredShape->bounds();
         if (m_hoveredShape->data.type == ScreenshotToolType::Text) {
             int newSize = m_hoveredShape->data.fontSize + (delta > 0 ? 2 : -2);
             m_hoveredShape->data.fontSize = std::max(8, std::min(100, newSize));
@@ -1421,7 +1595,8 @@ void ScreenshotTool::wheelEvent(QWheelEvent* event) {
             int newWidth = m_hoveredShape->data.strokeWidth + (delta > 0 ? 1 : -1);
             m_hoveredShape->data.strokeWidth = std::max(1, std::min(50, newWidth));
         }
-        update();
+        m_hoveredShape->invalidateBounds();
+        invalidateAnnotationLayer(before);
     } else {
         // 如果没有悬浮标注，修改全局设置
         if (m_currentTool == ScreenshotToolType::Text) {
@@ -1435,11 +1610,26 @@ void ScreenshotTool::wheelEvent(QWheelEvent* event) {
     event->accept();
 }
 
-void ScreenshotTool::paintEvent(QPaintEvent*) {
-    QPainter p(this); p.setRenderHint(QPainter::Antialiasing);
-    p.drawPixmap(0,0,m_screenPixmap);
-    QRect r = selectionRect(); QPainterPath path; path.addRect(rect());
-    if(r.isValid()) path.addRect(r); p.fillPath(path, QColor(0,0,0,120));
+namespace {
+constexpr int kMagZoom = 12;
+constexpr int kMagCols = 21;
+constexpr int kMagRows = 11;
+constexpr int kMagInfoHeight = 130;
+}
+
+void ScreenshotTool::paintEvent(QPaintEvent* e) {
+    QPainter p(this);
+    QRect r = selectionRect();
+
+    // [PERF] 只回填脏区域内的屏幕底图与遮罩，不再每帧重绘整张全屏图
+    const QRegion region = e->region();
+    const qreal dpr = m_screenPixmap.devicePixelRatio();
+    for (const QRect& dr : region) {
+        p.drawPixmap(dr, m_screenPixmap, QRectF(QPointF(dr.topLeft()) * dpr, QSizeF(dr.size()) * dpr));
+    }
+    const QRegion dimRegion = r.isValid() ? region - QRegion(r) : region;
+    for (const QRect& dr : dimRegion) p.fillRect(dr, QColor(0,0,0,120));
+    p.setRenderHint(QPainter::Antialiasing);
 
     if (m_state == ScreenshotState::Selecting && !m_isDragging && !m_highlightedRect.isEmpty()) {
         p.setPen(QPen(QColor(0, 120, 255, 200), 2)); p.setBrush(QColor(0, 120, 255, 30)); p.drawRect(m_highlightedRect);
@@ -1451,59 +1641,138 @@ void ScreenshotTool::paintEvent(QPaintEvent*) {
         // [STABILITY] 绘制阶段判空保护：确保不会在极其罕见的异步 delete 时刻访问非法地址
         p.save(); // [CRITICAL] 保存状态以防 clip 影响后续绘制
         p.setClipRect(r);
-        for(auto* a : std::as_const(m_annotations)) {
-            a->draw(p, m_mosaicPixmap);
-            if (a == m_hoveredShape) {
-                p.save();
-                p.setRenderHint(QPainter::Antialiasing);
-                p.setPen(QPen(Qt::cyan, 1.2, Qt::DashLine));
-                p.setBrush(Qt::NoBrush);
-                
-                // 针对不同形状绘制更有意义的连接虚线
-                if (a->data.type == ScreenshotToolType::Line || a->data.type == ScreenshotToolType::Arrow) {
-                    if (a->data.points.size() >= 2) p.drawLine(a->data.points[0], a->data.points[1]);
-                } else if (a->data.type == ScreenshotToolType::Rect || a->data.type == ScreenshotToolType::Ellipse || a->data.type == ScreenshotToolType::MosaicRect) {
-                    if (a->data.points.size() >= 2) p.drawRect(QRectF(a->data.points[0], a->data.points[1]).normalized());
-                } else if (a->data.type == ScreenshotToolType::Text) {
-                    // 文字工具显示边界框
-                    QFont font(a->data.fontFamily, a->data.fontSize);
-                    font.setBold(a->data.isBold); font.setItalic(a->data.isItalic);
-                    QRect r = QFontMetrics(font).boundingRect(a->data.text);
-                    r.moveTo(a->data.points[0].toPoint().x(), a->data.points[0].toPoint().y() - r.height());
-                    p.drawRect(r.adjusted(-4, -2, 4, 2));
-                }
 
-                // 绘制编辑句柄
-                auto handles = a->getHandles();
-                for(const auto& hh : std::as_const(handles)) {
-                    p.setPen(QPen(Qt::white, 1));
-                    p.setBrush(QColor(0, 120, 255));
-                    p.drawRect(hh);
-                }
-                p.restore();
+        // [PERF] 已提交的标注从离屏缓存贴图，只有正在绘制/拖拽编辑的标注实时绘制
+        ensureAnnotationLayer();
+        if (!m_annotationLayer.isNull()) {
+            const qreal layerDpr = m_annotationLayer.devicePixelRatio();
+            for (const QRect& dr : region & r) {
+                const QRect local = dr.translated(-r.topLeft());
+                p.drawImage(dr, m_annotationLayer, QRectF(QPointF(local.topLeft()) * layerDpr, QSizeF(local.size()) * layerDpr));
+            }
+        }
+        if (const BaseShape* live = liveEditedShape()) live->draw(p, m_mosaicCache);
+
+        if (m_hoveredShape && m_annotations.contains(m_hoveredShape)) {
+            const BaseShape* a = m_hoveredShape;
+            p.save();
+            p.setRenderHint(QPainter::Antialiasing);
+            p.setPen(QPen(Qt::cyan, 1.2, Qt::DashLine));
+            p.setBrush(Qt::NoBrush);
+            
+            // 针对不同形状绘制更有意义的连接虚线
+            if (a->data.type == ScreenshotToolType::Line || a->data.type == ScreenshotToolType::Arrow) {
+                if (a->data.points.size() >= 2) p.drawLine(a->data.points[0], a->data.points[1]);
+            } else if (a->data.type == ScreenshotToolType::Rect || a->data.type == ScreenshotToolType::Ellipse || a->data.type == ScreenshotToolType::MosaicRect) {
+                if (a->data.points.size() >= 2) p.drawRect(QRectF(a->data.points[0], a->data.points[1]).normalized());
+            } else if (a->data.type == ScreenshotToolType::Text) {
+                // 文字工具显示边界框
+                QFont font(a->data.fontFamily, a->data.fontSize);
+                font.setBold(a->data.isBold); font.setItalic(a->data.isItalic);
+                QRect r = QFontMetrics(font).boundingRect(a->data.text);
+                r.moveTo(a->data.points[0].toPoint().x(), a->data.points[0].toPoint().y() - r.height());
+                p.drawRect(r.adjusted(-4, -2, 4, 2));
             }
+
+            // 绘制编辑句柄
+            auto handles = a->getHandles();
+            for(const auto& hh : std::as_const(handles)) {
+                p.setPen(QPen(Qt::white, 1));
+                p.setBrush(QColor(0, 120, 255));
+                p.drawRect(hh);
+            }
+            p.restore();
         }
         if(m_isDrawing && m_activeShape) {
-            m_activeShape->draw(p, m_mosaicPixmap);
+            m_activeShape->draw(p, m_mosaicCache);
         }
         p.restore(); // [CRITICAL] 恢复状态，解除选区 clip
     }
 
     // [CRITICAL] 放大镜绘制必须在选区 clip 之外，以防被裁剪
-    if (m_state == ScreenshotState::Selecting || m_isDragging || m_isDrawing || m_currentTool == ScreenshotToolType::Picker) {
+    if (isMagnifierVisible()) {
         drawMagnifier(p, m_lastMouseMovePos);
     }
+    m_paintedRects = currentOverlayRects();
+}
+
+ScreenshotTool::OverlayRects ScreenshotTool::currentOverlayRects() const {
+    OverlayRects rects;
+    QRect r = selectionRect();
+    // 选区边框 2px + 10px 圆形句柄居中于边框
+    if (r.isValid()) rects.selection = r.adjusted(-7, -7, 7, 7);
+    if (m_state == ScreenshotState::Selecting && !m_isDragging && !m_highlightedRect.isEmpty()) {
+        rects.highlight = m_highlightedRect.adjusted(-2, -2, 2, 2);
+    }
+    if (isMagnifierVisible()) {
+        // 放大区 + 1px 边框 + 下方信息面板
+        const QRect mag = magnifierRect(m_lastMouseMovePos);
+        if (!mag.isNull()) rects.magnifier = mag.adjusted(-2, -2, 2, kMagInfoHeight + 2);
+    }
+    // 撤销后 m_hoveredShape 可能指向重做栈中的标注，此时不再绘制悬停框
+    if (r.isValid() && m_hoveredShape && m_annotations.contains(m_hoveredShape)) {
+        rects.hoverShape = m_hoveredShape;
+        rects.hover = m_hoveredShape->bounds();
+    }
+    if (m_isDrawing && m_activeShape) rects.active = m_activeShape->bounds();
+    return rects;
+}
+
+void ScreenshotTool::updateOverlay(const QRegion& extra) {
+    const OverlayRects now = currentOverlayRects();
+    QRegion dirty = extra;
+    auto mark = [&dirty](const QRect& before, const QRect& after, bool force) {
+        if (force || before != after) { dirty += before; dirty += after; }
+    };
+    mark(m_paintedRects.selection, now.selection, false);
+    mark(m_paintedRects.highlight, now.highlight, false);
+    mark(m_paintedRects.hover, now.hover, m_paintedRects.hoverShape != now.hoverShape);
+    // 放大镜内容随鼠标变化、绘制中的形状每帧都在变，始终重绘新旧两处
+    mark(m_paintedRects.magnifier, now.magnifier, true);
+    mark(m_paintedRects.active, now.active, true);
+    if (!dirty.isEmpty()) update(dirty);
+}
+
+void ScreenshotTool::invalidateAnnotationLayer(const QRegion& dirty) {
+    m_annotationLayerDirty = true;
+    updateOverlay(dirty);
+}
+
+const BaseShape* ScreenshotTool::liveEditedShape() const {
+    return (m_isDragging && m_editHandle != -1) ? m_hoveredShape : nullptr;
+}
+
+void ScreenshotTool::ensureAnnotationLayer() {
+    const QRect r = selectionRect();
+    const BaseShape* skip = liveEditedShape();
+    if (!m_annotationLayerDirty && m_annotationLayerRect == r && m_annotationLayerSkip == skip) return;
+    m_annotationLayerDirty = false;
+    m_annotationLayerRect = r;
+    m_annotationLayerSkip = skip;
+
+    if (r.isEmpty() || m_annotations.isEmpty() || (m_annotations.size() == 1 && m_annotations.first() == skip)) {
+        m_annotationLayer = QImage();
+        return;
+    }
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize = (QSizeF(r.size()) * dpr).toSize();
+    if (m_annotationLayer.size() != pixelSize) {
+        m_annotationLayer = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        m_annotationLayer.setDevicePixelRatio(dpr);
+    }
+    m_annotationLayer.fill(Qt::transparent);
+
+    QPainter lp(&m_annotationLayer);
+    lp.setRenderHint(QPainter::Antialiasing);
+    lp.translate(-r.topLeft());
+    for (auto* a : std::as_const(m_annotations)) {
+        if (a != skip) a->draw(lp, m_mosaicCache);
+    }
 }
 
 void ScreenshotTool::setTool(ScreenshotToolType t) { 
     if(m_textInput->isVisible()) commitTextInput(); 
-    
-    // [OPTIMIZATION] 延迟初始化马赛克底图
-    if ((t == ScreenshotToolType::Mosaic || t == ScreenshotToolType::MosaicRect) && m_mosaicPixmap.isNull()) {
-        // [FIX] 2026-03-xx 按照用户要求：重命名 small 为 scaledImg 以规避 MSVC/Windows.h 冲突 (#define small char)
-        QImage scaledImg = m_screenImage.scaled(m_screenImage.width()/40, m_screenImage.height()/40, Qt::IgnoreAspectRatio, Qt::FastTransformation);
-        m_mosaicPixmap = QPixmap::fromImage(scaledImg.scaled(m_screenImage.size(), Qt::IgnoreAspectRatio, Qt::FastTransformation));
-    }
+
 
     m_currentTool = t; 
     QSettings("RapidNotes", "Screenshot").setValue("tool", static_cast<int>(t)); 
@@ -1520,9 +1789,14 @@ void ScreenshotTool::setBold(bool bold) { m_currentBold = bold; QSettings("Rapid
 void ScreenshotTool::setItalic(bool italic) { m_currentItalic = italic; QSettings("RapidNotes", "Screenshot").setValue("italic", italic); }
 void ScreenshotTool::setFontFamily(const QString& family) { m_currentFontFamily = family; QSettings("RapidNotes", "Screenshot").setValue("fontFamily", family); }
 void ScreenshotTool::setFontSize(int size) { m_currentFontSize = size; QSettings("RapidNotes", "Screenshot").setValue("fontSize", size); }
+void ScreenshotTool::setMosaicEffect(ImageFilterHelper::Effect effect) { m_currentMosaicEffect = effect; QSettings("RapidNotes", "Screenshot").setValue("mosaicEffect", static_cast<int>(effect)); }
+void ScreenshotTool::setMosaicStrength(int strength) {
+    m_currentMosaicStrength = std::clamp(strength, ImageFilterHelper::kMinStrength, ImageFilterHelper::kMaxStrength);
+    QSettings("RapidNotes", "Screenshot").setValue("mosaicStrength", m_currentMosaicStrength);
+}
 
-void ScreenshotTool::undo() { if(!m_annotations.isEmpty()) { m_redoStack.append(m_annotations.takeLast()); update(); } }
-void ScreenshotTool::redo() { if(!m_redoStack.isEmpty()) { m_annotations.append(m_redoStack.takeLast()); update(); } }
+void ScreenshotTool::undo() { if(!m_annotations.isEmpty()) { m_redoStack.append(m_annotations.takeLast()); invalidateAnnotationLayer(m_redoStack.last()->bounds()); } }
+void ScreenshotTool::redo() { if(!m_redoStack.isEmpty()) { m_annotations.append(m_redoStack.takeLast()); invalidateAnnotationLayer(m_annotations.last()->bounds()); } }
 void ScreenshotTool::copyToClipboard() { 
     QImage img = generateFinalImage();
     emit screenshotCaptured(img, false);
@@ -1530,16 +1804,20 @@ void ScreenshotTool::copyToClipboard() {
     // [OPTIMIZATION] 强制释放截图缓冲区
     m_screenPixmap = QPixmap();
     m_screenImage = QImage();
-    m_mosaicPixmap = QPixmap();
+    m_mosaicCache.clear();
     cancel(); 
 }
 void ScreenshotTool::save() { 
     QImage img = generateFinalImage();
     emit screenshotCaptured(img, false);
-    QString fileName = QString("RPN_%1.png").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
-    QString f = QFileDialog::getSaveFileName(this, "保存截图", fileName, "PNG(*.png)"); 
-    if(!f.isEmpty()) img.save(f); 
-    autoSaveImage(img);
+    const QByteArray format = ImageSaveService::screenshotOptions().format;
+    QString fileName = QString("RPN_%1.%2").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"), QString::fromLatin1(format));
+    QStringList filters;
+    for (const QString& f : ImageSaveService::availableFormats()) filters << QString("%1(*.%2)").arg(f.toUpper(), f);
+    QString selectedFilter = QString("%1(*.%2)").arg(QString::fromLatin1(format).toUpper(), QString::fromLatin1(format));
+    QString f = QFileDialog::getSaveFileName(this, "保存截图", fileName, filters.join(";;"), &selectedFilter); 
+    // [PERF] 用户路径与自动保存共用同一次后台编码
+    autoSaveImage(img, f);
     cancel(); 
 }
 void ScreenshotTool::confirm() { 
@@ -1551,7 +1829,7 @@ void ScreenshotTool::confirm() {
     // [OPTIMIZATION] 确认后立即销毁内存中驻留的全屏大对象
     m_screenPixmap = QPixmap();
     m_screenImage = QImage();
-    m_mosaicPixmap = QPixmap();
+    m_mosaicCache.clear();
     cancel(); 
 }
 void ScreenshotTool::pin() { QImage img = generateFinalImage(); if (img.isNull()) return; auto* widget = new PinnedScreenshotWidget(QPixmap::fromImage(img), selectionRect()); widget->show(); cancel(); }
@@ -1566,6 +1844,15 @@ QList<QRect> ScreenshotTool::getHandleRects() const {
     return l;
 }
 int ScreenshotTool::getHandleAt(const QPoint& p) const { auto l = getHandleRects(); for(int i=0; i<l.size(); ++i) if(l[i].contains(p)) return i; return -1; }
+BaseShape* ScreenshotTool::shapeAt(const QPoint& p) const {
+    // 自顶向下命中；外接矩形不含该点的标注直接跳过，不做路径/描边级的精确测试
+    for (int i = m_annotations.size() - 1; i >= 0; --i) {
+        BaseShape* shape = m_annotations[i];
+        if (!shape->bounds().contains(p)) continue;
+        if (shape->hitTest(p) || shape->getHandleAt(p) != -1) return shape;
+    }
+    return nullptr;
+}
 void ScreenshotTool::updateCursor(const QPoint& p) {
     if (m_state == ScreenshotState::Editing) {
         int handle = getHandleAt(p); if (handle != -1) {
@@ -1596,8 +1883,10 @@ void ScreenshotTool::commitTextInput() {
         m_annotations.append(shape);
         qDeleteAll(m_redoStack);
         m_redoStack.clear();
+        m_annotationLayerDirty = true;
+        updateOverlay(shape->bounds());
     }
-    m_textInput->hide(); m_textInput->clear(); update();
+    m_textInput->hide(); m_textInput->clear();
 }
 
 #ifdef Q_OS_WIN
@@ -1661,27 +1950,20 @@ void ScreenshotTool::detectWindows() {
     QPoint offset = mapToGlobal(QPoint(0,0)); 
     for(QRect& r : m_detectedRects) r.translate(-offset);
     
-    // 去重并过滤极小区域
-    QList<QRect> filtered;
-    for (const QRect& r : std::as_const(m_detectedRects)) {
-        if (r.width() > 5 && r.height() > 5 && !filtered.contains(r)) {
-            filtered.append(r);
-        }
-    }
-    m_detectedRects = filtered;
+    // [PERF] 去重、过滤极小区域并建立网格索引 (原先逐个 contains 去重为平方级，控件多时明显卡顿)
+    m_rectIndex.build(m_detectedRects, rect());
 }
 
-void ScreenshotTool::drawMagnifier(QPainter& p, const QPoint& pos) {
-    if (pos.x() < 0 || pos.y() < 0 || pos.x() >= m_screenImage.width() || pos.y() >= m_screenImage.height()) return;
+bool ScreenshotTool::isMagnifierVisible() const {
+    return m_state == ScreenshotState::Selecting || m_isDragging || m_isDrawing || m_currentTool == ScreenshotToolType::Picker;
+}
+
+QRect ScreenshotTool::magnifierRect(const QPoint& pos) const {
+    if (pos.x() < 0 || pos.y() < 0 || pos.x() >= m_screenImage.width() || pos.y() >= m_screenImage.height()) return QRect();
+    const int magWidth = kMagCols * kMagZoom;
+    const int magHeight = kMagRows * kMagZoom;
+    const int infoHeight = kMagInfoHeight;
 
-    p.save();
-    const int zoom = 12;
-    const int cols = 21;
-    const int rows = 11;
-    const int magWidth = cols * zoom;
-    const int magHeight = rows * zoom;
-    const int infoHeight = 130;
-    
     int margin = 30;
     QRect sel = selectionRect();
     QRect magRect(pos.x() + margin, pos.y() + margin, magWidth, magHeight);
@@ -1699,6 +1981,20 @@ void ScreenshotTool::drawMagnifier(QPainter& p, const QPoint& pos) {
     if (magRect.left() < 0) magRect.moveLeft(5);
     if (magRect.bottom() + infoHeight > height()) magRect.moveBottom(height() - infoHeight - 5);
     if (magRect.top() < 0) magRect.moveTop(5);
+    return magRect;
+}
+
+void ScreenshotTool::drawMagnifier(QPainter& p, const QPoint& pos) {
+    const QRect magRect = magnifierRect(pos);
+    if (magRect.isNull()) return;
+
+    p.save();
+    const int zoom = kMagZoom;
+    const int cols = kMagCols;
+    const int rows = kMagRows;
+    const int magWidth = cols * zoom;
+    const int magHeight = rows * zoom;
+    const int infoHeight = kMagInfoHeight;
     
     p.setRenderHint(QPainter::Antialiasing, false);
     
@@ -1892,31 +2188,34 @@ void ScreenshotTool::executeOCR() {
 QImage ScreenshotTool::generateFinalImage() {
     QRect r = selectionRect(); if(r.isEmpty()) return QImage();
     QPixmap p = m_screenPixmap.copy(r); QPainter painter(&p); painter.translate(-r.topLeft());
-    for(auto* a : std::as_const(m_annotations)) a->draw(painter, m_mosaicPixmap);
+    for(auto* a : std::as_const(m_annotations)) a->draw(painter, m_mosaicCache);
     return p.toImage();
 }
 
-void ScreenshotTool::autoSaveImage(const QImage& img) {
+void ScreenshotTool::autoSaveImage(const QImage& img, const QString& userPath) {
     if (img.isNull()) return;
     
     QSettings settings("RapidNotes", "Screenshot");
     QString defaultPath = QCoreApplication::applicationDirPath() + "/RPN_screenshot";
     QString savePath = settings.value("savePath", defaultPath).toString();
     
-    QDir dir(savePath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
-    
-    QString fileName = QString("RPN_%1.png").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
-    QString fullPath = dir.absoluteFilePath(fileName);
-    
-    if (img.save(fullPath)) {
-        // 使用非阻塞彩色反馈告知用户已自动保存 (2026-03-xx 统一修改为 700ms)
-        ToolTipOverlay::instance()->showText(QCursor::pos(), QString("[OK] 已自动保存至:\n%1").arg(fullPath), 700);
-    } else {
-        ToolTipOverlay::instance()->showText(QCursor::pos(), "[ERR] 自动保存失败，请检查路径权限", 700);
-    }
+    // [PERF] 编码与写盘交给后台线程：浮层无需等待 PNG 压缩即可关闭，目录在写入时按需创建
+    const ImageSaveService::Options options = ImageSaveService::screenshotOptions();
+    QString fileName = QString("RPN_%1.%2").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"), QString::fromLatin1(options.format));
+    const QString fullPath = QDir(savePath).absoluteFilePath(fileName);
+
+    QStringList paths;
+    if (!userPath.isEmpty()) paths << userPath;
+    paths << fullPath;
+    ImageSaveService::instance().saveAsync(img, paths, options, [fullPath](const QString& path, bool ok) {
+        if (path != fullPath) return;
+        if (ok) {
+            // 使用非阻塞彩色反馈告知用户已自动保存 (2026-03-xx 统一修改为 700ms)
+            ToolTipOverlay::instance()->showText(QCursor::pos(), QString("[OK] 已自动保存至:\n%1").arg(fullPath), 700);
+        } else {
+            ToolTipOverlay::instance()->showText(QCursor::pos(), "[ERR] 自动保存失败，请检查路径权限", 700);
+        }
+    });
 }
 void ScreenshotTool::keyPressEvent(QKeyEvent* e) { 
     if(e->key() == Qt::Key_Escape) {
@@ -1953,7 +2252,7 @@ void ScreenshotTool::keyPressEvent(QKeyEvent* e) {
     }
     else if (e->key() == Qt::Key_Shift) {
         m_colorFormatIndex = (m_colorFormatIndex + 1) % 3;
-        update();
+        updateOverlay();
     }
     else if (e->key() == Qt::Key_M) {
         QString coordStr = QString("%1, %2").arg(m_lastMouseMovePos.x()).arg(m_lastMouseMovePos.y());
@@ -8,6 +8,7 @@
 #include <QPixmap>
 #include <QPainter>
 #include <QPainterPath>
+#include <QRegion>
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -18,8 +19,10 @@
 #include <QColorDialog>
 #include <QList>
 #include <QAbstractItemView>
+#include <QCache>
 #include <functional>
 #include <utility>
+#include "../core/ImageFilterHelper.h"
 
 enum class ScreenshotState { Selecting, Editing };
 enum class ScreenshotToolType { None, Rect, Ellipse, Arrow, Line, Pen, Marker, Text, Mosaic, MosaicRect, Eraser, Picker };
@@ -46,25 +49,61 @@ struct DrawingAnnotation {
     int fontSize = 12;
     bool isBold = false;
     bool isItalic = false;
+    // 马赛克相关属性
+    ImageFilterHelper::Effect mosaicEffect = ImageFilterHelper::Effect::Pixelate;
+    int mosaicStrength = ImageFilterHelper::kDefaultStrength;
+};
+
+/**
+ * @brief 马赛克 / 模糊效果的分块缓存
+ * 截图按 256px (物理像素) 切块，只为标注实际覆盖到的块按需计算，结果以 (块, 效果, 强度) 为键缓存，
+ * 调整强度或切换效果只会计算新组合下用到的块。一次绘制中缺失的多个块在线程池中并行计算。
+ */
+class MosaicTileCache {
+public:
+    void setSource(const QImage& source);
+    void clear();
+    // 绘制 logicalRect (逻辑坐标) 覆盖到的效果块，调用方负责设置裁剪
+    void draw(QPainter& painter, const QRectF& logicalRect, ImageFilterHelper::Effect effect, int strength);
+
+private:
+    static constexpr int kTileSize = 256;
+    static quint64 tileKey(int col, int row, ImageFilterHelper::Effect effect, int strength);
+
+    QImage m_source;
+    QCache<quint64, QImage> m_tiles{96 * 1024}; // 成本以 KB 计，约 96MB
 };
 
 class BaseShape {
 public:
     BaseShape(const DrawingAnnotation& ann) : data(ann) {}
     virtual ~BaseShape() = default;
-    virtual void draw(QPainter& painter, const QPixmap& mosaicPixmap) const = 0;
+    virtual void draw(QPainter& painter, MosaicTileCache& mosaic) const = 0;
     virtual bool hitTest(const QPoint& pos) const = 0;
     virtual QList<QRect> getHandles() const { return {}; }
     virtual int getHandleAt(const QPoint& pos) const;
-    virtual void updatePoint(int index, const QPoint& pos) { if(index >= 0 && index < data.points.size()) data.points[index] = pos; }
+    virtual void updatePoint(int index, const QPoint& pos) { if(index >= 0 && index < data.points.size()) data.points[index] = pos; invalidateBounds(); }
     virtual void moveBy(const QPoint& delta);
+
+    // 覆盖绘制内容、命中容差与编辑句柄的外接矩形 (缓存)，用于悬停/擦除的快速排除；
+    // 直接修改 data (点、线宽、字号) 后必须调用 invalidateBounds()
+    QRect bounds() const;
+    void invalidateBounds() { m_boundsValid = false; }
+
     DrawingAnnotation data;
+
+protected:
+    virtual QRect computeBounds() const;
+
+private:
+    mutable QRect m_bounds;
+    mutable bool m_boundsValid = false;
 };
 
 class RectShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
     void updatePoint(int index, const QPoint& pos) override;
@@ -73,7 +112,7 @@ public:
 class EllipseShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
     void updatePoint(int index, const QPoint& pos) override;
@@ -82,7 +121,7 @@ public:
 class LineShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
 };
@@ -90,7 +129,7 @@ public:
 class ArrowShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
 };
@@ -98,41 +137,65 @@ public:
 class PenShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
 };
 
 class MarkerShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
 };
 
 class TextShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
+protected:
+    QRect computeBounds() const override;
 };
 
 class MosaicShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
 };
 
 class MosaicRectShape : public BaseShape {
 public:
     using BaseShape::BaseShape;
-    void draw(QPainter& painter, const QPixmap& mosaicPixmap) const override;
+    void draw(QPainter& painter, MosaicTileCache& mosaic) const override;
     bool hitTest(const QPoint& pos) const override;
     QList<QRect> getHandles() const override;
     void updatePoint(int index, const QPoint& pos) override;
 };
 
+/**
+ * @brief 检测到的窗口/控件矩形的均匀网格索引
+ * 每次截图构建一次：矩形按面积升序排列，每个格子记录与之相交的矩形下标 (同样按面积升序)。
+ * 查询“包含某点的最小矩形”只需顺序扫描该点所在格子的候选，第一个包含该点的即为结果。
+ */
+class RectGridIndex {
+public:
+    void build(const QList<QRect>& rects, const QRect& bounds, int cellSize = 64);
+    void clear();
+    bool isEmpty() const { return m_rects.isEmpty(); }
+    int size() const { return int(m_rects.size()); }
+    QRect smallestContaining(const QPoint& pos) const;
+
+private:
+    QRect m_bounds;
+    int m_cellSize = 64;
+    int m_cols = 0;
+    int m_rows = 0;
+    QList<QRect> m_rects;
+    QList<QList<int>> m_cells;
+};
+
 class ScreenshotTool;
 class ScreenshotToolbar;
 
@@ -181,6 +244,8 @@ public:
     QPushButton* m_arrowStyleBtn = nullptr;
     QPushButton* m_outlineBtn = nullptr;
     QPushButton* m_solidBtn = nullptr;
+    QPushButton* m_pixelateBtn = nullptr;
+    QPushButton* m_blurBtn = nullptr;
     QPushButton* m_wheelBtn = nullptr;
     QBoxLayout* m_recentLayout = nullptr;
     QWidget* m_textOptionWidget = nullptr;
@@ -226,6 +291,8 @@ public:
     void setItalic(bool italic);
     void setFontFamily(const QString& family);
     void setFontSize(int size);
+    void setMosaicEffect(ImageFilterHelper::Effect effect);
+    void setMosaicStrength(int strength);
     
     void updateToolbarPosition();
     void undo();
@@ -266,7 +333,8 @@ private:
     void showTextInput(const QPoint& pos);
     void commitTextInput();
     QImage generateFinalImage();
-    void autoSaveImage(const QImage& img);
+    // 后台编码并原子写入自动保存目录；userPath 非空时同一次编码也写入该路径
+    void autoSaveImage(const QImage& img, const QString& userPath = QString());
     void detectWindows();
     void collectQtWidgets(QWidget* parent);
     void detectItemViewRects(QAbstractItemView* view);
@@ -274,15 +342,34 @@ private:
     void collectUIAElements(HWND hwnd);
 #endif
     void drawMagnifier(QPainter& p, const QPoint& pos);
+    bool isMagnifierVisible() const;
+    QRect magnifierRect(const QPoint& pos) const;
+    BaseShape* shapeAt(const QPoint& pos) const;
+
+    // [PERF] 局部重绘：记录动态元素上一帧的位置，与当前位置合并为脏区域
+    struct OverlayRects {
+        QRect selection;
+        QRect highlight;
+        QRect magnifier;
+        QRect hover;
+        QRect active;
+        const BaseShape* hoverShape = nullptr;
+    };
+    OverlayRects currentOverlayRects() const;
+    void updateOverlay(const QRegion& extra = QRegion());
+    void invalidateAnnotationLayer(const QRegion& dirty = QRegion());
+    void ensureAnnotationLayer();
+    const BaseShape* liveEditedShape() const;
 
     QPixmap m_screenPixmap;
     QImage m_screenImage;
-    QPixmap m_mosaicPixmap;
+    MosaicTileCache m_mosaicCache;
     
     ScreenshotState m_state = ScreenshotState::Selecting;
     ScreenshotToolType m_currentTool = ScreenshotToolType::None;
     
     QList<QRect> m_detectedRects;
+    RectGridIndex m_rectIndex; // m_detectedRects 的网格索引，detectWindows 时构建
     QRect m_highlightedRect;
 
     QPoint m_startPoint, m_endPoint;
@@ -299,6 +386,12 @@ private:
     DrawingAnnotation m_currentAnnotation;
     bool m_isDrawing = false;
 
+    OverlayRects m_paintedRects;
+    QImage m_annotationLayer;                          // 已提交标注的离屏缓存，仅覆盖选区
+    QRect m_annotationLayerRect;
+    const BaseShape* m_annotationLayerSkip = nullptr;  // 正在拖拽编辑的标注不进缓存，实时绘制
+    bool m_annotationLayerDirty = true;
+
     ScreenshotToolbar* m_toolbar = nullptr;
     SelectionInfoBar* m_infoBar = nullptr;
     QLineEdit* m_textInput = nullptr;
@@ -316,6 +409,9 @@ private:
     int m_currentFontSize = 14;
     bool m_currentBold = true;
     bool m_currentItalic = false;
+
+    ImageFilterHelper::Effect m_currentMosaicEffect = ImageFilterHelper::Effect::Pixelate;
+    int m_currentMosaicStrength = ImageFilterHelper::kDefaultStrength;
 };
 
 #endif // SCREENSHOTTOOL_H
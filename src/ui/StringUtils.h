@@ -25,6 +25,7 @@
 #include <vector>
 #include <functional>
 #include "../core/ClipboardMonitor.h"
+#include "../core/DatabaseManager.h"
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -333,7 +334,7 @@ public:
             const QVariantMap& note = notes.first();
             QString type = note.value("item_type").toString();
             QString content = note.value("content").toString();
-            QByteArray blob = note.value("data_blob").toByteArray();
+            QByteArray blob = DatabaseManager::instance().resolveBlob(note);
 
             // 1. 图片类型：直接复制二进制图
             if (type == "image") {
@@ -0,0 +1,118 @@
+#ifndef OCRPREPROCESSREFERENCE_H
+#define OCRPREPROCESSREFERENCE_H
+
+#include <QImage>
+#include <QPainter>
+#include <QLinearGradient>
+#include <QRandomGenerator>
+#include <QSize>
+#include <algorithm>
+
+/**
+ * @brief 逐步执行的旧版 OCR 预处理 (灰度 -> 缩放 -> 角点反色 -> 0.5% 拉伸 -> 十字锐化)
+ *
+ * 与重构前的 OCRManager::preprocessImage 逐行对应，仅在缩放后补上 Grayscale8 转换
+ * (平滑缩放输出 32 位格式，旧代码随后按字节读取会读错像素)。用作融合/并行实现的像素级基准。
+ */
+namespace OcrPreprocessReference {
+
+inline QImage run(const QImage& original, int fixedScale = 0) {
+    QImage processed = original.convertToFormat(QImage::Format_Grayscale8);
+
+    int scale = 3;
+    if (processed.width() > 2000 || processed.height() > 2000) scale = 1;
+    else if (processed.width() > 1000 || processed.height() > 1000) scale = 2;
+    if (fixedScale > 0) scale = fixedScale;
+
+    if (scale > 1) {
+        int targetW = processed.width() * scale;
+        int targetH = processed.height() * scale;
+        if (targetW > 4000 || targetH > 4000) {
+            QSize sz(targetW, targetH);
+            sz.scale(4000, 4000, Qt::KeepAspectRatio);
+            targetW = sz.width();
+            targetH = sz.height();
+        }
+        processed = processed.scaled(targetW, targetH, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+                        .convertToFormat(QImage::Format_Grayscale8);
+    }
+
+    int cornerSum = 0;
+    cornerSum += qGray(processed.pixel(0, 0));
+    cornerSum += qGray(processed.pixel(processed.width() - 1, 0));
+    cornerSum += qGray(processed.pixel(0, processed.height() - 1));
+    cornerSum += qGray(processed.pixel(processed.width() - 1, processed.height() - 1));
+    if (cornerSum / 4 < 128) processed.invertPixels();
+
+    int histogram[256] = {0};
+    for (int y = 0; y < processed.height(); ++y) {
+        const uchar* line = processed.constScanLine(y);
+        for (int x = 0; x < processed.width(); ++x) histogram[line[x]]++;
+    }
+
+    const int totalPixels = processed.width() * processed.height();
+    int minGray = 0, maxGray = 255;
+    int count = 0;
+    for (int i = 0; i < 256; ++i) {
+        count += histogram[i];
+        if (count > totalPixels * 0.005) { minGray = i; break; }
+    }
+    count = 0;
+    for (int i = 255; i >= 0; --i) {
+        count += histogram[i];
+        if (count > totalPixels * 0.005) { maxGray = i; break; }
+    }
+
+    if (maxGray > minGray) {
+        for (int y = 0; y < processed.height(); ++y) {
+            uchar* line = processed.scanLine(y);
+            for (int x = 0; x < processed.width(); ++x) {
+                const int val = (line[x] - minGray) * 255 / (maxGray - minGray);
+                line[x] = static_cast<uchar>(qBound(0, val, 255));
+            }
+        }
+    }
+
+    QImage sharpened = processed;
+    for (int y = 1; y < processed.height() - 1; ++y) {
+        const uchar* prevLine = processed.constScanLine(y - 1);
+        const uchar* currLine = processed.constScanLine(y);
+        const uchar* nextLine = processed.constScanLine(y + 1);
+        uchar* destLine = sharpened.scanLine(y);
+        for (int x = 1; x < processed.width() - 1; ++x) {
+            const int sum = currLine[x] * 5 - prevLine[x] - nextLine[x] - currLine[x - 1] - currLine[x + 1];
+            destLine[x] = static_cast<uchar>(qBound(0, sum, 255));
+        }
+    }
+    return sharpened;
+}
+
+// 类截图样本：渐变底色 + 若干行文字 + 少量噪点；dark 为深色背景 (触发反色)
+inline QImage sampleImage(const QSize& size, QImage::Format format, bool dark, quint32 seed) {
+    QImage image(size, QImage::Format_RGB32);
+    QPainter p(&image);
+    QLinearGradient gradient(0, 0, size.width(), size.height());
+    gradient.setColorAt(0, dark ? QColor(20, 24, 40) : QColor(250, 248, 240));
+    gradient.setColorAt(1, dark ? QColor(50, 30, 60) : QColor(210, 225, 235));
+    p.fillRect(image.rect(), gradient);
+
+    QFont font("Arial");
+    font.setPixelSize(std::max(10, size.height() / 24));
+    p.setFont(font);
+    p.setPen(dark ? QColor(230, 230, 200) : QColor(30, 30, 90));
+    for (int y = font.pixelSize() * 2; y < size.height(); y += font.pixelSize() * 2) {
+        p.drawText(8, y, QStringLiteral("RapidNotes OCR 预处理回归 0123456789 The quick brown fox"));
+    }
+    p.end();
+
+    QRandomGenerator rng(seed);
+    for (int i = 0; i < size.width() * size.height() / 50; ++i) {
+        const int v = rng.bounded(256);
+        image.setPixel(rng.bounded(size.width()), rng.bounded(size.height()), qRgb(v, v, v));
+    }
+    return image.convertToFormat(format);
+}
+
+} // namespace OcrPreprocessReference
+
+#endif // OCRPREPROCESSREFERENCE_H
@@ -0,0 +1,27 @@
+#ifndef TESTDATABASE_H
+#define TESTDATABASE_H
+
+#include "core/DatabaseManager.h"
+#include <QSqlDatabase>
+#include <QTemporaryDir>
+
+/**
+ * @brief 测试进程共用的 DatabaseManager 实例
+ * 单例只初始化一次，数据库文件放在进程生命周期内有效的临时目录中，不触碰用户数据。
+ */
+namespace TestDatabase {
+
+inline bool ensureInitialized() {
+    static QTemporaryDir dir;
+    static const bool ok = dir.isValid() && DatabaseManager::instance().init(dir.filePath("test_notes.db"));
+    return ok;
+}
+
+// 与 DatabaseManager 共用的主连接 (同在主线程)，用于检查表结构与查询计划
+inline QSqlDatabase connection() {
+    return QSqlDatabase::database("RapidNotes_Main_Conn");
+}
+
+} // namespace TestDatabase
+
+#endif // TESTDATABASE_H
@@ -0,0 +1,9 @@
+#include "TestRegistry.h"
+#include <QApplication>
+
+// 用法：RapidNotesTests [测试类名] [QTest 参数...]，基准测试 RapidNotesBench 同理
+int main(int argc, char** argv) {
+    // 部分被测对象是窗口部件 (悬浮球、标签选择器、截图遮罩)，统一使用 QApplication
+    QApplication app(argc, argv);
+    return TestRegistry::runAll(argc, argv);
+}
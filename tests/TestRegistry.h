@@ -0,0 +1,61 @@
+#ifndef TESTREGISTRY_H
+#define TESTREGISTRY_H
+
+#include <QObject>
+#include <QList>
+#include <QtTest>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 测试类注册表
+ *
+ * 单元测试与基准测试各自只有一个可执行文件：每个 tst_* / bench_* 源文件用 RAPIDNOTES_TEST
+ * 登记自己的测试类，TestMain 依次运行全部测试类，失败数累加作为退出码。
+ */
+namespace TestRegistry {
+
+struct Entry {
+    const char* name;
+    std::function<QObject*()> create;
+};
+
+inline QList<Entry>& entries() {
+    static QList<Entry> s_entries;
+    return s_entries;
+}
+
+inline int add(const char* name, std::function<QObject*()> create) {
+    entries().append({name, std::move(create)});
+    return int(entries().size());
+}
+
+// 第一个与测试类同名的参数只运行该类，其余参数原样交给 QTest (如 -v2、函数名)
+inline int runAll(int argc, char** argv) {
+    const char* only = nullptr;
+    std::vector<char*> args{argv[0]};
+    for (int i = 1; i < argc; ++i) {
+        if (!only && argv[i][0] != '-') {
+            bool isClass = false;
+            for (const Entry& e : entries()) isClass = isClass || qstrcmp(e.name, argv[i]) == 0;
+            if (isClass) { only = argv[i]; continue; }
+        }
+        args.push_back(argv[i]);
+    }
+
+    int failures = 0;
+    for (const Entry& e : entries()) {
+        if (only && qstrcmp(e.name, only) != 0) continue;
+        std::unique_ptr<QObject> test(e.create());
+        failures += QTest::qExec(test.get(), int(args.size()), args.data());
+    }
+    return failures;
+}
+
+} // namespace TestRegistry
+
+#define RAPIDNOTES_TEST(TestClass) \
+    static const int s_registered##TestClass = TestRegistry::add(#TestClass, [] { return new TestClass; });
+
+#endif // TESTREGISTRY_H
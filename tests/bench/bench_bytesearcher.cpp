@@ -0,0 +1,172 @@
+#include "TestRegistry.h"
+#include "core/ContentSearcher.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <iterator>
+#include <memory>
+
+namespace {
+// 8 MB 类源码文本：固定种子随机拼接常见单词，关键字低频出现
+QByteArray makeCorpus() {
+    static const char* const words[] = {"int", "return", "const", "QString", "value", "index", "for", "if", "else",
+                                        "while", "auto", "nullptr", "void", "static", "m_data", "size", "count"};
+    QRandomGenerator rng(20260327);
+    QByteArray corpus;
+    corpus.reserve(8 * 1024 * 1024 + 64);
+    while (corpus.size() < 8 * 1024 * 1024) {
+        const int r = rng.bounded(1000);
+        if (r == 0) corpus += "DatabaseManager";
+        else corpus += words[rng.bounded(int(std::size(words)))];
+        corpus += (r % 13 == 0) ? '\n' : ' ';
+    }
+    return corpus;
+}
+
+// 类源码目录树：kDirCount 个子目录 × kFilesPerDir 个 .cpp/.h，外加应被过滤的 build 目录与二进制文件
+constexpr int kDirCount = 40;
+constexpr int kFilesPerDir = 50;
+constexpr int kFileBytes = 24 * 1024;
+
+void writeSourceTree(const QString& root, const QByteArray& corpus) {
+    QRandomGenerator rng(20260418);
+    auto slice = [&]() { return corpus.mid(rng.bounded(int(corpus.size() - kFileBytes)), kFileBytes); };
+    for (int d = 0; d < kDirCount; ++d) {
+        const QString dir = QString("%1/module_%2").arg(root).arg(d);
+        QDir().mkpath(dir);
+        for (int f = 0; f < kFilesPerDir; ++f) {
+            QFile file(QString("%1/file_%2.%3").arg(dir).arg(f).arg(f % 3 == 0 ? "h" : "cpp"));
+            if (file.open(QIODevice::WriteOnly)) file.write(slice());
+        }
+        QFile binary(dir + "/icon.png");
+        if (binary.open(QIODevice::WriteOnly)) binary.write(QByteArray(kFileBytes, '\0'));
+    }
+    for (int f = 0; f < kFilesPerDir; ++f) {
+        QDir().mkpath(root + "/build");
+        QFile file(QString("%1/build/generated_%2.cpp").arg(root).arg(f));
+        if (file.open(QIODevice::WriteOnly)) file.write(slice());
+    }
+}
+
+// 对照组：重构前 KeywordSearchWidget 的单线程路径 (逐文件路径 contains 忽略目录、逐次编译通配符、
+// 读 1 KB 判二进制、QTextStream::readAll 整文件解码后 QString::count)；返回命中文件数
+int readAllSearch(const QString& rootDir, const QString& keyword, const QString& filter,
+                  const QStringList& ignoreDirs, bool caseSensitive) {
+    int foundFiles = 0;
+    const QStringList filters = filter.split(QRegularExpression("[,\\s;]+"), Qt::SkipEmptyParts);
+    QDirIterator it(rootDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString filePath = it.next();
+        bool skip = false;
+        for (const QString& ignore : ignoreDirs) {
+            if (filePath.contains("/" + ignore + "/") || filePath.contains("\\" + ignore + "\\")) { skip = true; break; }
+        }
+        if (skip) continue;
+        if (!filters.isEmpty()) {
+            bool matchFilter = false;
+            const QString fileName = QFileInfo(filePath).fileName();
+            for (const QString& f : filters) {
+                QRegularExpression re(QRegularExpression::wildcardToRegularExpression(f));
+                if (re.match(fileName).hasMatch()) { matchFilter = true; break; }
+            }
+            if (!matchFilter) continue;
+        }
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        const QByteArray chunk = file.read(1024);
+        if (chunk.contains('\0')) continue;
+        file.seek(0);
+        QTextStream in(&file);
+        const QString content = in.readAll();
+        const Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        if (content.contains(keyword, cs)) foundFiles++;
+    }
+    return foundFiles;
+}
+}
+
+class BenchByteSearcher : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        m_corpus = makeCorpus();
+        // 参考值：旧实现整文件解码为 UTF-16 后 QString::count
+        m_expected = int(QString::fromUtf8(m_corpus).count("DatabaseManager", Qt::CaseInsensitive));
+        QVERIFY(m_expected > 0);
+    }
+
+    void countCaseSensitive() {
+        const ByteSearcher searcher("DatabaseManager", true);
+        int count = 0;
+        QBENCHMARK { count = searcher.countIn(m_corpus.constData(), m_corpus.size()); }
+        QCOMPARE(count, m_expected);
+    }
+
+    void countCaseInsensitive() {
+        const ByteSearcher searcher("databasemanager", false);
+        int count = 0;
+        QBENCHMARK { count = searcher.countIn(m_corpus.constData(), m_corpus.size()); }
+        QCOMPARE(count, m_expected);
+    }
+
+    // 对照组：旧实现的解码 + QString::count
+    void decodeAndCount() {
+        int count = 0;
+        QBENCHMARK { count = int(QString::fromUtf8(m_corpus).count("DatabaseManager", Qt::CaseInsensitive)); }
+        QCOMPARE(count, m_expected);
+    }
+
+    // 合成源码树上的完整搜索：预编译过滤 + 目录剪枝 + mmap 字节查找 + 专用线程池
+    void sourceTreeSearch() {
+        ensureSourceTree();
+        ContentSearcher searcher;
+        ContentSearcher::Options options;
+        options.rootDir = m_tree->path();
+        options.keyword = "DatabaseManager";
+        options.filter = kTreeFilter;
+        options.ignoreDirs = {"build"};
+        int found = 0;
+        QBENCHMARK {
+            QSignalSpy spy(&searcher, &ContentSearcher::finished);
+            searcher.start(options);
+            QVERIFY(spy.wait(120000));
+            QCOMPARE(spy.first().at(0).toInt(), kDirCount * kFilesPerDir);
+            found = spy.first().at(1).toInt();
+        }
+        QCOMPARE(found, m_treeExpected);
+    }
+
+    // 对照组：旧版 readAll 单线程路径
+    void sourceTreeReadAll() {
+        ensureSourceTree();
+        int found = 0;
+        QBENCHMARK { found = readAllSearch(m_tree->path(), "DatabaseManager", kTreeFilter, {"build"}, false); }
+        QCOMPARE(found, m_treeExpected);
+    }
+
+private:
+    static constexpr const char* kTreeFilter = "*.cpp, *.h";
+
+    void ensureSourceTree() {
+        if (m_tree) return;
+        m_tree = std::make_unique<QTemporaryDir>();
+        QVERIFY(m_tree->isValid());
+        writeSourceTree(m_tree->path(), m_corpus);
+        m_treeExpected = readAllSearch(m_tree->path(), "DatabaseManager", kTreeFilter, {"build"}, false);
+        QVERIFY(m_treeExpected > 0);
+    }
+
+    std::unique_ptr<QTemporaryDir> m_tree;
+    int m_treeExpected = 0;
+    QByteArray m_corpus;
+    int m_expected = 0;
+};
+
+RAPIDNOTES_TEST(BenchByteSearcher)
+#include "bench_bytesearcher.moc"
@@ -0,0 +1,98 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include "OcrPreprocessReference.h"
+#include "core/ClipboardMonitor.h"
+#include "core/ImageHashHelper.h"
+#include <QBuffer>
+#include <QImageWriter>
+
+namespace {
+// 与 ClipboardMonitor::encodeImage 相同的写入参数，只是格式由调用方指定
+QByteArray encodeAs(const QImage& image, const QString& encoding) {
+    if (encoding == "auto") return ClipboardMonitor::encodeImage(image);
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, encoding == "webp" ? "webp" : "png");
+    if (encoding == "webp") writer.setQuality(100);
+    else if (encoding == "png-fast") writer.setQuality(80);
+    return writer.write(image) ? data : QByteArray();
+}
+
+// 复制图片到入库的完整路径，与 ClipboardMonitor::processImageAsync + main.cpp 的入库回调逐步对应：
+// 超过 20 MB 降采样 -> 像素哈希 (与上一次相同则跳过编码) -> 编码 -> addNote (携带预计算哈希，走去重查询)
+// 返回新笔记 ID；去重命中返回 0
+int captureToInsert(const QImage& image, const QString& encoding, QString* lastHash) {
+    QImage img = image;
+    if (qint64(img.width()) * img.height() * 4 > 20 * 1024 * 1024) {
+        img = img.scaled(2560, 2560, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    const QString pixelHash = ImageHashHelper::pixelHash(img);
+    if (pixelHash == *lastHash) return 0;
+
+    const QByteArray blob = encodeAs(img, encoding);
+    if (blob.isEmpty()) return -1;
+    *lastHash = pixelHash;
+    return DatabaseManager::instance().addNote("[截图]", "[截图]", {}, "", -1, "image", blob, "", "", "", pixelHash);
+}
+}
+
+class BenchCaptureInsert : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+        m_hasWebp = QImageWriter::supportedImageFormats().contains("webp");
+    }
+
+    void captureToInsert_data() {
+        QTest::addColumn<QSize>("size");
+        QTest::addColumn<QString>("encoding");
+        QTest::addColumn<bool>("duplicate");
+
+        const QList<QPair<QString, QSize>> sizes = {
+            {"1080p", QSize(1920, 1080)}, {"4K", QSize(3840, 2160)}, {"5K", QSize(5120, 2880)}};
+        for (const auto& [name, size] : sizes) {
+            // auto = ClipboardMonitor::encodeImage 的实际选择；png = 旧版默认压缩级别
+            for (const QString& encoding : {"auto", "png", "png-fast", "webp"}) {
+                QTest::newRow(qPrintable(name + " " + encoding)) << size << encoding << false;
+            }
+            QTest::newRow(qPrintable(name + " duplicate")) << size << QString("auto") << true;
+        }
+    }
+
+    void captureToInsert() {
+        QFETCH(QSize, size);
+        QFETCH(QString, encoding);
+        QFETCH(bool, duplicate);
+        if (encoding == "webp" && !m_hasWebp) QSKIP("未安装 WebP 图像插件");
+
+        // 每次迭代改写左上角，保证哈希不同、不会被去重；图片不与他处共享，改写不触发深拷贝
+        QImage image = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, quint32(size.width()));
+        QString lastHash;
+        if (duplicate) QVERIFY(::captureToInsert(image, encoding, &lastHash) > 0);
+
+        quint32 round = 0;
+        int result = 0;
+        QBENCHMARK {
+            if (!duplicate) markRound(image, ++round);
+            result = ::captureToInsert(image, encoding, &lastHash);
+        }
+        if (duplicate) QCOMPARE(result, 0);
+        else QVERIFY(result > 0);
+    }
+
+private:
+    // 改写 4x4 色块而非单个像素：5K 降采样后变化仍能落到输出像素上
+    static void markRound(QImage& image, quint32 round) {
+        const QRgb mark = qRgb(round & 0xff, (round >> 8) & 0xff, 0x5a);
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) image.setPixel(x, y, mark);
+        }
+    }
+
+    bool m_hasWebp = false;
+};
+
+RAPIDNOTES_TEST(BenchCaptureInsert)
+#include "bench_captureinsert.moc"
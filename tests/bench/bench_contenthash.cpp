@@ -0,0 +1,39 @@
+#include "TestRegistry.h"
+#include "OcrPreprocessReference.h"
+#include "core/ImageHashHelper.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+
+// 保存图片笔记时 GUI 线程上的哈希开销：解码 + 像素哈希 (旧路径) 对比字节哈希 (延后升级)
+class BenchContentHash : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        const QImage image = OcrPreprocessReference::sampleImage(QSize(1920, 1080), QImage::Format_RGB32, false, 34);
+        QBuffer buffer(&m_png);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QVERIFY(image.save(&buffer, "PNG"));
+    }
+
+    void decodeAndPixelHash() {
+        QString hash;
+        QBENCHMARK {
+            QImage image;
+            image.loadFromData(m_png);
+            hash = ImageHashHelper::pixelHash(image);
+        }
+        QCOMPARE(hash.size(), 64);
+    }
+
+    void byteHash() {
+        QString hash;
+        QBENCHMARK { hash = QCryptographicHash::hash(m_png, QCryptographicHash::Sha256).toHex(); }
+        QCOMPARE(hash.size(), 64);
+    }
+
+private:
+    QByteArray m_png;
+};
+
+RAPIDNOTES_TEST(BenchContentHash)
+#include "bench_contenthash.moc"
@@ -0,0 +1,76 @@
+#include "TestRegistry.h"
+#include "models/FileResultModel.h"
+#include <QRandomGenerator>
+#include <QVector>
+#include <iterator>
+
+namespace {
+struct FileRecord {
+    QString name;
+    QString path;
+    bool hidden;
+};
+
+// 固定种子生成近似真实目录树的文件名，保证多次运行结果可比
+QVector<FileRecord> makeFiles(int count) {
+    static const char* const stems[] = {"report", "main", "config", "image", "backup", "notes", "index", "data",
+                                        "test", "readme", "screenshot", "invoice", "draft", "module", "helper"};
+    static const char* const exts[] = {"txt", "cpp", "h", "png", "jpg", "pdf", "md", "json", "docx", "xlsx"};
+    constexpr int stemCount = int(std::size(stems));
+    constexpr int extCount = int(std::size(exts));
+
+    QRandomGenerator rng(20260318);
+    QVector<FileRecord> files;
+    files.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString dir = QString("C:/Users/bench/Documents/project%1/sub%2").arg(rng.bounded(200)).arg(rng.bounded(50));
+        const QString name = QString("%1_%2_%3.%4").arg(QLatin1String(stems[rng.bounded(stemCount)]), QLatin1String(stems[rng.bounded(stemCount)]))
+                                 .arg(i).arg(QLatin1String(exts[rng.bounded(extCount)]));
+        files.append({name, dir + "/" + name, rng.bounded(20) == 0});
+    }
+    return files;
+}
+
+// 与 FileSearchWidget::rebuildIndex 相同的构建方式
+std::shared_ptr<FileNameIndex> buildIndex(const QVector<FileRecord>& files) {
+    int textChars = 0;
+    for (const auto& f : files) textChars += f.name.size() + f.path.size();
+    auto index = std::make_shared<FileNameIndex>();
+    index->reserve(files.size(), textChars);
+    for (const auto& f : files) index->append(f.name, f.path, f.hidden);
+    return index;
+}
+}
+
+class BenchFileIndex : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() { m_files = makeFiles(kFileCount); }
+
+    // 扫描结束后的整体重建
+    void rebuildIndex() {
+        QBENCHMARK {
+            auto index = buildIndex(m_files);
+            QCOMPARE(index->size(), kFileCount);
+        }
+    }
+
+    // 逐键输入：首键全量匹配，之后每键在上一次的命中集合中收窄
+    void typeQuery() {
+        FileResultModel model;
+        model.setIndex(buildIndex(m_files));
+        const QString query = "screenshot";
+        QBENCHMARK {
+            model.setFilter(QString(), QString(), true);
+            for (int i = 1; i <= query.size(); ++i) model.setFilter(query.left(i), QString(), true);
+        }
+        QVERIFY(model.rowCount() > 0);
+    }
+
+private:
+    static constexpr int kFileCount = 200000;
+    QVector<FileRecord> m_files;
+};
+
+RAPIDNOTES_TEST(BenchFileIndex)
+#include "bench_fileindex.moc"
@@ -0,0 +1,61 @@
+#include "TestRegistry.h"
+#include "ui/FireworksOverlay.h"
+#include <QSettings>
+
+// 满载 (粒子上限) 的烟花帧耗时：积分一步 + 把粒子包围盒离屏绘制到同尺寸 QImage。
+// 动画定时器停掉，由测试逐帧驱动；不经窗口系统合成，结果与显示器和特效开关无关
+class BenchFireworks : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        // explode() 受用户的特效开关控制：测试期间临时打开，结束后还原
+        QSettings settings("RapidNotes", "General");
+        m_savedSetting = settings.value("showFireworks");
+        settings.setValue("showFireworks", true);
+        m_overlay = FireworksOverlay::instance();
+        QVERIFY(m_overlay);
+    }
+
+    void saturatedFrames() {
+        const QPoint center = m_overlay->mapToGlobal(m_overlay->rect().center());
+        qint64 renderedPixels = 0;
+        QBENCHMARK {
+            // 连续复制叠加的爆炸：12 次足以触及 480 粒子上限
+            for (int i = 0; i < 12; ++i) m_overlay->explode(center + QPoint(i * 7, i * 5));
+            m_overlay->m_timer->stop();
+            QVERIFY(m_overlay->m_p.count > 0);
+            renderedPixels = 0;
+            for (int frame = 0; frame < kFrames && m_overlay->m_p.count > 0; ++frame) {
+                m_overlay->step();
+                const QRect bounds = m_overlay->particleBounds();
+                if (bounds.isEmpty()) continue;
+                QImage image(bounds.size(), QImage::Format_ARGB32_Premultiplied);
+                image.fill(Qt::transparent);
+                m_overlay->render(&image, QPoint(), QRegion(bounds), QWidget::RenderFlags());
+                renderedPixels += qint64(bounds.width()) * bounds.height();
+            }
+        }
+        qInfo().noquote() << QString("每帧平均绘制 %1 像素").arg(renderedPixels / kFrames);
+    }
+
+    void cleanupTestCase() {
+        QSettings settings("RapidNotes", "General");
+        if (m_savedSetting.isValid()) settings.setValue("showFireworks", m_savedSetting);
+        else settings.remove("showFireworks");
+        if (!m_overlay) return;
+        // 丢弃剩余粒子，清除最后一帧
+        m_overlay->m_timer->stop();
+        m_overlay->m_p.count = 0;
+        m_overlay->m_dirtyRect = QRect();
+        m_overlay->update();
+    }
+
+private:
+    static constexpr int kFrames = 60; // 约 1 秒动画
+
+    FireworksOverlay* m_overlay = nullptr;
+    QVariant m_savedSetting;
+};
+
+RAPIDNOTES_TEST(BenchFireworks)
+#include "bench_fireworks.moc"
@@ -0,0 +1,122 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include "models/NoteModel.h"
+#include <QBuffer>
+#include <QImage>
+#include <QPainter>
+
+namespace {
+constexpr int kRows = 100;
+
+QByteArray makePng(int seed) {
+    QImage image(1280, 720, QImage::Format_RGB32);
+    image.fill(QColor::fromHsv(seed * 37 % 360, 160, 200));
+    QPainter painter(&image);
+    painter.fillRect(QRect(40, 40, 600, 300), Qt::white);
+    painter.drawText(QRect(60, 60, 560, 260), Qt::TextWordWrap, QString("screenshot %1").arg(seed));
+    painter.end();
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return bytes;
+}
+
+// 每 5 条一张内联图片 (缩略图缓存)，其余为未回填 plain_text 的 HTML 笔记 (纯文本缓存)
+QVariantMap makeNote(int id) {
+    QVariantMap note;
+    note["id"] = id;
+    note["title"] = QString("note %1").arg(id);
+    note["tags"] = "bench";
+    if (id % 5 == 0) {
+        note["item_type"] = "image";
+        note["content"] = "[截图]";
+        note["data_blob"] = makePng(id);
+        note["blob_format"] = "png";
+    } else {
+        note["item_type"] = "text";
+        QString html = "<html><body>";
+        for (int p = 0; p < 20; ++p) html += QString("<p>paragraph %1 of note %2 &amp; some <b>bold</b> text</p>").arg(p).arg(id);
+        note["content"] = html + "</body></html>";
+    }
+    return note;
+}
+
+// 视图刷新后重绘可见行时读取的带缓存角色
+void paintAllRows(const NoteModel& model) {
+    for (int row = 0; row < model.rowCount(); ++row) {
+        const QModelIndex index = model.index(row, 0);
+        model.data(index, Qt::DecorationRole);
+        model.data(index, NoteModel::PlainContentRole);
+    }
+}
+}
+
+// 剪贴板采集后的列表刷新：100 行、角色缓存已预热，新列表只在首行多一条、末行挤出一条
+class BenchNoteModel : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+        for (int id = 1; id <= kRows; ++id) m_pool.append(makeNote(id));
+    }
+
+    void prependOne_data() {
+        QTest::addColumn<bool>("repaint");
+        QTest::newRow("setNotes") << false;
+        QTest::newRow("setNotes + repaint") << true;
+    }
+
+    // 增量比对：其余 99 行保持原位，缓存保留
+    void prependOne() {
+        QFETCH(bool, repaint);
+        NoteModel model;
+        QList<QVariantMap> page = m_pool;
+        model.setNotes(page);
+        paintAllRows(model);
+
+        int nextId = kRows + 1;
+        QBENCHMARK {
+            page.removeLast();
+            page.prepend(makeTextNote(nextId++));
+            model.setNotes(page);
+            if (repaint) paintAllRows(model);
+        }
+        QCOMPARE(model.rowCount(), kRows);
+        QCOMPARE(model.data(model.index(0, 0), NoteModel::IdRole).toInt(), nextId - 1);
+    }
+
+    // 对照组：先清空再整表写入，等价于改造前的 beginResetModel——全部行重建、缓存全部失效
+    void resetThenRepaint() {
+        NoteModel model;
+        QList<QVariantMap> page = m_pool;
+        model.setNotes(page);
+        paintAllRows(model);
+
+        int nextId = kRows + 1;
+        QBENCHMARK {
+            page.removeLast();
+            page.prepend(makeTextNote(nextId++));
+            model.setNotes({});
+            model.setNotes(page);
+            paintAllRows(model);
+        }
+        QCOMPARE(model.rowCount(), kRows);
+    }
+
+private:
+    // 新采集的条目一律用文本笔记，避免把 PNG 编码计入刷新耗时
+    static QVariantMap makeTextNote(int id) {
+        QVariantMap note;
+        note["id"] = id;
+        note["title"] = QString("captured %1").arg(id);
+        note["item_type"] = "text";
+        note["content"] = QString("<p>captured text %1</p>").arg(id);
+        return note;
+    }
+
+    QList<QVariantMap> m_pool;
+};
+
+RAPIDNOTES_TEST(BenchNoteModel)
+#include "bench_notemodel.moc"
@@ -0,0 +1,123 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include "core/OCRManager.h"
+#include "ui/OCRWindow.h"
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QPainter>
+#include <QTimer>
+
+namespace {
+// 每张图片带唯一标记，保证像素哈希互不相同，不会命中 OCR 缓存
+QList<QImage> makeImages(int count, const QString& tag) {
+    QList<QImage> images;
+    for (int i = 0; i < count; ++i) {
+        QImage image(900, 260, QImage::Format_RGB32);
+        image.fill(Qt::white);
+        QPainter p(&image);
+        QFont font("Arial");
+        font.setPixelSize(28);
+        p.setFont(font);
+        p.setPen(Qt::black);
+        for (int line = 0; line < 3; ++line) {
+            p.drawText(30, 60 + line * 70, QString("%1 image %2 line %3").arg(tag).arg(i).arg(line));
+        }
+        images << image;
+    }
+    return images;
+}
+}
+
+class BenchOcrBatch : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+#ifndef Q_OS_WIN
+        QSKIP("当前平台不支持 OCR，跳过批量识别耗时测量");
+#endif
+        QVERIFY(TestDatabase::ensureInitialized());
+    }
+
+    // 50 张图片一次加入 OCRWindow (与拖入 / 浏览 / 粘贴同一入口)，计时到队列清空、全部任务完成。
+    // 派发、并发上限、选中项优先与逐条刷新右侧结果都走窗口自身的 processNextImage / onRecognitionFinished
+    void ocrWindowDrain() {
+        OCRWindow window;
+        const QList<QImage> images = makeImages(kImageCount, QString("window %1").arg(m_round++));
+        QList<QPair<QImage, QString>> named;
+        for (int i = 0; i < images.size(); ++i) named.append({images[i], QString("bench_%1.png").arg(i)});
+
+        qint64 drainMs = -1;
+        QBENCHMARK_ONCE {
+            QElapsedTimer timer;
+            timer.start();
+            window.addImages(named);
+            QVERIFY(waitUntilDrained(&window));
+            drainMs = timer.elapsed();
+        }
+        QCOMPARE(window.m_items.size(), kImageCount);
+        for (const auto& item : std::as_const(window.m_items)) QVERIFY2(item.isFinished, qPrintable(item.name));
+        qInfo().noquote() << QString("OCRWindow: %1 张图片，并行上限 %2，队列清空耗时 %3 ms")
+                                 .arg(kImageCount).arg(OCRManager::instance().maxConcurrentRequests()).arg(drainMs);
+    }
+
+    // 对照组：旧版逐张串行 (上一张返回后才提交下一张)
+    void sequentialReference() {
+        const QList<QImage> images = makeImages(kImageCount, QString("sequential %1").arg(m_round++));
+        int finished = 0;
+        QBENCHMARK_ONCE { finished = runBatch(images, 1); }
+        QCOMPARE(finished, kImageCount);
+    }
+
+private:
+    static constexpr int kImageCount = 50;
+
+    // 在途上限 maxInFlight，名额释放后立即派发下一张；返回完成张数
+    int runBatch(const QList<QImage>& images, int maxInFlight) {
+        const int baseId = m_nextContextId;
+        m_nextContextId += images.size();
+        int next = 0;
+        int running = 0;
+        int finished = 0;
+
+        QEventLoop loop;
+        auto dispatch = [&]() {
+            while (running < maxInFlight && next < images.size()) {
+                ++running;
+                OCRManager::instance().recognizeAsync(images[next], baseId + next);
+                ++next;
+            }
+        };
+        const auto conn = connect(&OCRManager::instance(), &OCRManager::recognitionFinished, &loop,
+                                  [&](const QString&, int contextId) {
+            if (contextId < baseId || contextId >= baseId + images.size()) return;
+            --running;
+            if (++finished == images.size()) loop.quit();
+            else dispatch();
+        }, Qt::QueuedConnection);
+
+        dispatch();
+        QTimer::singleShot(10 * 60 * 1000, &loop, &QEventLoop::quit);
+        loop.exec();
+        disconnect(conn);
+        return finished;
+    }
+
+    // 等待窗口的排队与在途任务全部清空。本连接晚于窗口自身的连接建立，同一结果先由窗口处理
+    static bool waitUntilDrained(OCRWindow* window) {
+        auto drained = [window]() { return window->m_running.isEmpty() && window->m_processingQueue.isEmpty(); };
+        if (drained()) return true;
+        QEventLoop loop;
+        const auto conn = connect(&OCRManager::instance(), &OCRManager::recognitionFinished, &loop,
+                                  [&]() { if (drained()) loop.quit(); }, Qt::QueuedConnection);
+        QTimer::singleShot(10 * 60 * 1000, &loop, &QEventLoop::quit);
+        loop.exec();
+        disconnect(conn);
+        return drained();
+    }
+
+    int m_round = 0;
+    int m_nextContextId = 1000000;
+};
+
+RAPIDNOTES_TEST(BenchOcrBatch)
+#include "bench_ocrbatch.moc"
@@ -0,0 +1,36 @@
+#include "TestRegistry.h"
+#include "OcrPreprocessReference.h"
+#include "core/OCRManager.h"
+
+class BenchOcrPreprocess : public QObject {
+    Q_OBJECT
+private slots:
+    void preprocess_data() {
+        QTest::addColumn<QSize>("size");
+        QTest::newRow("800x600 (3x)") << QSize(800, 600);
+        QTest::newRow("1920x1080 (2x)") << QSize(1920, 1080);
+        QTest::newRow("2560x1440 (1x)") << QSize(2560, 1440);
+    }
+
+    // 融合查表 + 行段并行锐化
+    void preprocess() {
+        QFETCH(QSize, size);
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, 42);
+        QImage out;
+        QBENCHMARK { out = OCRManager::preprocessImage(input, false); }
+        QCOMPARE(out.format(), QImage::Format_Grayscale8);
+    }
+
+    // 对照组：旧版逐步执行的单线程流水线
+    void reference_data() { preprocess_data(); }
+    void reference() {
+        QFETCH(QSize, size);
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, 42);
+        QImage out;
+        QBENCHMARK { out = OcrPreprocessReference::run(input); }
+        QCOMPARE(out.format(), QImage::Format_Grayscale8);
+    }
+};
+
+RAPIDNOTES_TEST(BenchOcrPreprocess)
+#include "bench_ocrpreprocess.moc"
@@ -0,0 +1,80 @@
+#include "TestRegistry.h"
+#include "OcrPreprocessReference.h"
+#include "core/PaletteExtractor.h"
+#include <QColor>
+#include <QMap>
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+// 对照组：旧版 ColorPickerWindow::extractDominantColors (120x120 缩略图 + QMap 精确计数)
+QStringList thumbnailPalette(const QImage& img, int num) {
+    QImage scaledImg = img.scaled(120, 120, Qt::IgnoreAspectRatio, Qt::FastTransformation).convertToFormat(QImage::Format_RGB32);
+    QMap<QRgb, int> counts;
+    for (int y = 0; y < scaledImg.height(); ++y) {
+        for (int x = 0; x < scaledImg.width(); ++x) { counts[scaledImg.pixel(x, y)]++; }
+    }
+    QList<QRgb> sorted = counts.keys();
+    std::sort(sorted.begin(), sorted.end(), [&](QRgb a, QRgb b){ return counts[a] > counts[b]; });
+
+    QStringList result;
+    for (QRgb rgb : sorted) {
+        QColor c(rgb);
+        bool distinct = true;
+        for (const QString& ex : result) {
+            QColor exc(ex);
+            int diff = std::abs(exc.red() - c.red()) + std::abs(exc.green() - c.green()) + std::abs(exc.blue() - c.blue());
+            if (diff < 20) { distinct = false; break; }
+        }
+        if (distinct) {
+            result << c.name().toUpper();
+            if (result.size() >= num) break;
+        }
+    }
+    return result;
+}
+}
+
+class BenchPaletteExtractor : public QObject {
+    Q_OBJECT
+private slots:
+    void compute_data() {
+        QTest::addColumn<QSize>("size");
+        QTest::newRow("256x256") << QSize(256, 256);
+        QTest::newRow("1920x1080") << QSize(1920, 1080);
+        QTest::newRow("4000x3000") << QSize(4000, 3000);
+    }
+
+    // 全分辨率直方图 + Lab k-means++ (不经缓存)
+    void compute() {
+        QFETCH(QSize, size);
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, 48);
+        QStringList palette;
+        QBENCHMARK { palette = PaletteExtractor::compute(input, 24); }
+        QVERIFY(!palette.isEmpty());
+    }
+
+    // 缓存命中：再次打开同一张图片，只剩像素哈希
+    void cached_data() { compute_data(); }
+    void cached() {
+        QFETCH(QSize, size);
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, 48);
+        const QStringList expected = PaletteExtractor::extract(input, 24);
+        QStringList palette;
+        QBENCHMARK { palette = PaletteExtractor::extract(input, 24); }
+        QCOMPARE(palette, expected);
+    }
+
+    // 对照组：旧版缩略图精确计数
+    void reference_data() { compute_data(); }
+    void reference() {
+        QFETCH(QSize, size);
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format_RGB32, false, 48);
+        QStringList palette;
+        QBENCHMARK { palette = thumbnailPalette(input, 24); }
+        QVERIFY(!palette.isEmpty());
+    }
+};
+
+RAPIDNOTES_TEST(BenchPaletteExtractor)
+#include "bench_paletteextractor.moc"
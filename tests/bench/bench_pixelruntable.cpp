@@ -0,0 +1,119 @@
+#include "TestRegistry.h"
+#include "core/PixelRunTable.h"
+#include <QPainter>
+#include <QRandomGenerator>
+
+namespace {
+constexpr int kTolerance = 10;     // 与 PixelRulerOverlay::kEdgeTolerance 一致
+constexpr int kCursorCount = 2000;
+
+// 4K 类桌面截图：渐变壁纸上叠放大块纯色窗口、标题栏与文字行
+QImage makeCapture() {
+    const QSize size(3840, 2160);
+    QImage image(size, QImage::Format_RGB32);
+    QPainter p(&image);
+    QLinearGradient wallpaper(0, 0, 0, size.height());
+    wallpaper.setColorAt(0, QColor(20, 40, 80));
+    wallpaper.setColorAt(1, QColor(60, 100, 140));
+    p.fillRect(image.rect(), wallpaper);
+
+    QRandomGenerator rng(47);
+    for (int w = 0; w < 12; ++w) {
+        const QRect window(rng.bounded(size.width() - 1600), rng.bounded(size.height() - 1000),
+                           800 + rng.bounded(800), 500 + rng.bounded(500));
+        p.fillRect(window, QColor(245, 245, 245));
+        p.fillRect(QRect(window.topLeft(), QSize(window.width(), 36)), QColor::fromHsv(rng.bounded(360), 120, 200));
+        p.setPen(Qt::black);
+        for (int line = 0; line < 12; ++line) {
+            p.drawText(window.left() + 20, window.top() + 70 + line * 22, QString("window %1 line %2").arg(w).arg(line));
+        }
+    }
+    p.end();
+    return image;
+}
+
+// 平坦区域的光标：以光标为中心 9×9 内颜色完全相同 (标尺最常停留的窗口空白处)
+QList<QPoint> flatCursors(const QImage& image) {
+    QRandomGenerator rng(4747);
+    QList<QPoint> points;
+    while (points.size() < kCursorCount) {
+        const int x = 4 + rng.bounded(image.width() - 8);
+        const int y = 4 + rng.bounded(image.height() - 8);
+        const QRgb c = image.pixel(x, y);
+        bool flat = true;
+        for (int dy = -4; dy <= 4 && flat; ++dy) {
+            for (int dx = -4; dx <= 4 && flat; ++dx) flat = image.pixel(x + dx, y + dy) == c;
+        }
+        if (flat) points << QPoint(x, y);
+    }
+    return points;
+}
+}
+
+// 像素标尺：4K 截图的游程表构建耗时，以及平坦区域内四向测距 (游程表 vs 逐像素扫描)
+class BenchPixelRunTable : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        m_image = makeCapture();
+        m_cursors = flatCursors(m_image);
+        m_rows = PixelRunTable::build(m_image, Qt::Horizontal);
+        m_columns = PixelRunTable::build(m_image, Qt::Vertical);
+        QVERIFY(!m_rows.isNull());
+        QVERIFY(!m_columns.isNull());
+    }
+
+    void build_data() {
+        QTest::addColumn<int>("orientation");
+        QTest::newRow("rows") << int(Qt::Horizontal);
+        QTest::newRow("columns") << int(Qt::Vertical);
+    }
+
+    void build() {
+        QFETCH(int, orientation);
+        PixelRunTable table;
+        QBENCHMARK { table = PixelRunTable::build(m_image, Qt::Orientation(orientation)); }
+        QVERIFY(!table.isNull());
+    }
+
+    // 每个光标位置测上下左右四个方向，与 PixelRulerOverlay::edgeDistance 的调用方式一致
+    void distance() {
+        for (const QPoint& c : std::as_const(m_cursors)) {
+            QCOMPARE(m_rows.distance(c.x(), c.y(), -1, kTolerance), PixelRunTable::scan(m_image, c.x(), c.y(), -1, 0, kTolerance));
+            QCOMPARE(m_rows.distance(c.x(), c.y(), 1, kTolerance), PixelRunTable::scan(m_image, c.x(), c.y(), 1, 0, kTolerance));
+            QCOMPARE(m_columns.distance(c.x(), c.y(), -1, kTolerance), PixelRunTable::scan(m_image, c.x(), c.y(), 0, -1, kTolerance));
+            QCOMPARE(m_columns.distance(c.x(), c.y(), 1, kTolerance), PixelRunTable::scan(m_image, c.x(), c.y(), 0, 1, kTolerance));
+        }
+        qint64 total = 0;
+        QBENCHMARK {
+            total = 0;
+            for (const QPoint& c : std::as_const(m_cursors)) {
+                total += m_rows.distance(c.x(), c.y(), -1, kTolerance) + m_rows.distance(c.x(), c.y(), 1, kTolerance)
+                       + m_columns.distance(c.x(), c.y(), -1, kTolerance) + m_columns.distance(c.x(), c.y(), 1, kTolerance);
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    // 对照组：表未建好时的逐像素扫描回退路径
+    void scan() {
+        qint64 total = 0;
+        QBENCHMARK {
+            total = 0;
+            for (const QPoint& c : std::as_const(m_cursors)) {
+                total += PixelRunTable::scan(m_image, c.x(), c.y(), -1, 0, kTolerance) + PixelRunTable::scan(m_image, c.x(), c.y(), 1, 0, kTolerance)
+                       + PixelRunTable::scan(m_image, c.x(), c.y(), 0, -1, kTolerance) + PixelRunTable::scan(m_image, c.x(), c.y(), 0, 1, kTolerance);
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+private:
+    QImage m_image;
+    QList<QPoint> m_cursors;
+    PixelRunTable m_rows;
+    PixelRunTable m_columns;
+};
+
+RAPIDNOTES_TEST(BenchPixelRunTable)
+#include "bench_pixelruntable.moc"
@@ -0,0 +1,96 @@
+#include "TestRegistry.h"
+#include "ui/ScreenshotTool.h"
+#include <QRandomGenerator>
+
+namespace {
+const QRect kScreen(0, 0, 2560, 1440);
+
+// 类桌面的检测结果：若干顶层窗口，每个窗口内嵌套多层控件，另有少量重复与细小杂质
+QList<QRect> makeDetectedRects(int windows, int controlsPerWindow) {
+    QRandomGenerator rng(41);
+    QList<QRect> rects;
+    for (int w = 0; w < windows; ++w) {
+        const QRect window(rng.bounded(2000), rng.bounded(1000), 400 + rng.bounded(1200), 300 + rng.bounded(700));
+        rects << window.intersected(kScreen);
+        QRect parent = window;
+        for (int c = 0; c < controlsPerWindow; ++c) {
+            if (c % 8 == 0) parent = window;
+            const int cw = std::max(4, parent.width() / 2 - rng.bounded(std::max(1, parent.width() / 4)));
+            const int ch = std::max(4, parent.height() / 2 - rng.bounded(std::max(1, parent.height() / 4)));
+            const QRect control(parent.left() + rng.bounded(std::max(1, parent.width() - cw)),
+                                parent.top() + rng.bounded(std::max(1, parent.height() - ch)), cw, ch);
+            rects << control;
+            if (c % 10 == 0) rects << control; // 多次枚举得到的重复矩形
+            parent = control;
+        }
+    }
+    return rects;
+}
+
+QList<QPoint> makeQueries(int count) {
+    QRandomGenerator rng(4141);
+    QList<QPoint> points;
+    for (int i = 0; i < count; ++i) points << QPoint(rng.bounded(kScreen.width()), rng.bounded(kScreen.height()));
+    return points;
+}
+
+// 重构前 mouseMoveEvent 中的逐个扫描：包含该点的矩形里面积最小者
+QRect linearSmallest(const QList<QRect>& rects, const QPoint& p) {
+    QRect smallest;
+    qint64 minArea = -1;
+    for (const QRect& r : rects) {
+        if (!r.contains(p) || r.width() < 10 || r.height() < 10) continue;
+        const qint64 area = qint64(r.width()) * r.height();
+        if (minArea == -1 || area < minArea) { minArea = area; smallest = r; }
+    }
+    return smallest;
+}
+}
+
+class BenchRectGridIndex : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        // 250 个窗口 × (1 + 40 控件 + 4 重复) ≈ 1.1 万个矩形，贴近控件密集桌面的枚举规模
+        m_rects = makeDetectedRects(250, 40);
+        m_queries = makeQueries(20000);
+    }
+
+    void build() {
+        RectGridIndex index;
+        QBENCHMARK { index.build(m_rects, kScreen); }
+        QVERIFY(!index.isEmpty());
+    }
+
+    // 悬停查询：网格索引 vs 旧版全量扫描，命中结果面积必须一致
+    void hoverLookup() {
+        RectGridIndex index;
+        index.build(m_rects, kScreen);
+        for (const QPoint& p : std::as_const(m_queries)) {
+            const QRect a = index.smallestContaining(p), b = linearSmallest(m_rects, p);
+            QCOMPARE(qint64(a.width()) * a.height(), qint64(b.width()) * b.height());
+        }
+        int hits = 0;
+        QBENCHMARK {
+            hits = 0;
+            for (const QPoint& p : std::as_const(m_queries)) hits += !index.smallestContaining(p).isNull();
+        }
+        QVERIFY(hits > 0);
+    }
+
+    void hoverLookupLinear() {
+        int hits = 0;
+        QBENCHMARK {
+            hits = 0;
+            for (const QPoint& p : std::as_const(m_queries)) hits += !linearSmallest(m_rects, p).isNull();
+        }
+        QVERIFY(hits > 0);
+    }
+
+private:
+    QList<QRect> m_rects;
+    QList<QPoint> m_queries;
+};
+
+RAPIDNOTES_TEST(BenchRectGridIndex)
+#include "bench_rectgridindex.moc"
@@ -0,0 +1,132 @@
+#include "TestRegistry.h"
+#include "ui/ScreenshotTool.h"
+#include "core/ImageSaveService.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QTemporaryDir>
+
+// 确认截图到浮层关闭的耗时：后台编码保存 vs 旧版在 GUI 线程同步 QImage::save
+class BenchScreenshotClose : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(m_saveDir.isValid());
+        QSettings settings("RapidNotes", "Screenshot");
+        m_savedPath = settings.value("savePath");
+        settings.setValue("savePath", m_saveDir.path());
+    }
+
+    void cleanupTestCase() {
+        QSettings settings("RapidNotes", "Screenshot");
+        if (m_savedPath.isValid()) settings.setValue("savePath", m_savedPath);
+        else settings.remove("savePath");
+    }
+
+    void confirmToClose() {
+        QPointer<ScreenshotTool> tool = openWithSelection();
+        QVERIFY(tool);
+        const int before = savedFiles();
+        QBENCHMARK_ONCE { tool->confirm(); }
+        QVERIFY(!tool || !tool->isVisible());
+        // 文件仍会由后台写出
+        QTRY_VERIFY_WITH_TIMEOUT(savedFiles() > before, 10000);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    // 对照组：同一张整屏图在 GUI 线程上编码并写盘
+    void synchronousSaveReference() {
+        QPointer<ScreenshotTool> tool = openWithSelection();
+        QVERIFY(tool);
+        const QImage image = tool->grab().toImage();
+        bool ok = false;
+        QBENCHMARK_ONCE { ok = image.save(m_saveDir.filePath("reference.png"), "PNG"); }
+        QVERIFY(ok);
+        tool->cancel();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    // 与屏幕分辨率无关的固定 5K 图：GUI 线程上 saveAsync 的返回耗时 vs 同步 QImage::save
+    void fixed5KImage_data() {
+        QTest::addColumn<bool>("async");
+        QTest::newRow("ImageSaveService::saveAsync") << true;
+        QTest::newRow("QImage::save (GUI thread)") << false;
+    }
+
+    void fixed5KImage() {
+        QFETCH(bool, async);
+        const QImage image = makeCapture(QSize(5120, 2880));
+        const QString path = m_saveDir.filePath(async ? "fixed5k_async.png" : "fixed5k_sync.png");
+        const ImageSaveService::Options options; // 两组都用默认 PNG 编码，耗时可直接对比
+
+        bool done = false;
+        bool ok = false;
+        QElapsedTimer untilWritten;
+        untilWritten.start();
+        QBENCHMARK_ONCE {
+            if (async) {
+                ImageSaveService::instance().saveAsync(image, {path}, options, [&](const QString&, bool saved) {
+                    ok = saved;
+                    done = true;
+                });
+            } else {
+                ok = image.save(path, "PNG");
+                done = true;
+            }
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(done, 30000);
+        QVERIFY(ok);
+        QVERIFY(QFileInfo(path).size() > 0);
+        qInfo().noquote() << QString("%1: 文件写出共 %2 ms").arg(QTest::currentDataTag()).arg(untilWritten.elapsed());
+    }
+
+private:
+    // 类桌面内容：渐变底色 + 若干窗口块 + 文字与噪点，避免纯色图让编码器走捷径
+    static QImage makeCapture(const QSize& size) {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        QPainter painter(&image);
+        QLinearGradient background(0, 0, size.width(), size.height());
+        background.setColorAt(0, QColor(30, 60, 110));
+        background.setColorAt(1, QColor(140, 90, 60));
+        painter.fillRect(image.rect(), background);
+        QRandomGenerator rng(44);
+        for (int w = 0; w < 24; ++w) {
+            const QRect window(rng.bounded(size.width() - 800), rng.bounded(size.height() - 600), 400 + rng.bounded(400), 300 + rng.bounded(300));
+            painter.fillRect(window, QColor::fromHsv(rng.bounded(360), 40, 230));
+            painter.setPen(Qt::black);
+            for (int line = 0; line < window.height() / 18; ++line) {
+                painter.drawText(window.left() + 8, window.top() + 18 * (line + 1), QString("line %1 of window %2").arg(line).arg(w));
+            }
+        }
+        painter.end();
+        for (int i = 0; i < size.width() * size.height() / 50; ++i) {
+            image.setPixel(rng.bounded(size.width()), rng.bounded(size.height()), 0xff000000u | rng.generate());
+        }
+        return image;
+    }
+
+    ScreenshotTool* openWithSelection() {
+        auto* tool = new ScreenshotTool;
+        tool->show();
+        if (!QTest::qWaitForWindowExposed(tool)) return nullptr;
+        const QRect area = tool->rect().adjusted(10, 10, -10, -10);
+        QTest::mousePress(tool, Qt::LeftButton, Qt::NoModifier, area.topLeft());
+        QTest::mouseMove(tool, area.bottomRight());
+        QTest::mouseRelease(tool, Qt::LeftButton, Qt::NoModifier, area.bottomRight());
+        return tool;
+    }
+
+    int savedFiles() const {
+        return QDir(m_saveDir.path()).entryList({"RPN_*"}, QDir::Files).size();
+    }
+
+    QTemporaryDir m_saveDir;
+    QVariant m_savedPath;
+};
+
+RAPIDNOTES_TEST(BenchScreenshotClose)
+#include "bench_screenshotclose.moc"
@@ -0,0 +1,124 @@
+#include "TestRegistry.h"
+#include "ui/ScreenshotTool.h"
+#include <QPaintEvent>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QtMath>
+
+namespace {
+// 统计截图遮罩每帧实际重绘的像素面积
+class PaintMeter : public QObject {
+public:
+    qint64 paintedArea = 0;
+    int frames = 0;
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (event->type() == QEvent::Paint) {
+            for (const QRect& r : static_cast<QPaintEvent*>(event)->region()) paintedArea += qint64(r.width()) * r.height();
+            ++frames;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+}
+
+// 编辑态下画笔拖动一帧的耗时：局部脏区域重绘 vs 整屏重绘 (旧版每次 update() 的行为)
+class BenchScreenshotFrame : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        // 画笔/矩形工具切换会写入用户的截图偏好，结束时恢复
+        m_savedTool = QSettings("RapidNotes", "Screenshot").value("tool");
+    }
+
+    void cleanupTestCase() {
+        QSettings settings("RapidNotes", "Screenshot");
+        if (m_savedTool.isValid()) settings.setValue("tool", m_savedTool);
+        else settings.remove("tool");
+    }
+
+    void init() {
+        m_tool = new ScreenshotTool;
+        m_tool->show();
+        QVERIFY(QTest::qWaitForWindowExposed(m_tool));
+        const QRect area = m_tool->rect().adjusted(40, 40, -40, -40);
+        QVERIFY(area.width() > 200 && area.height() > 200);
+
+        // 拖出选区进入编辑态，再铺上一批已提交的矩形标注
+        QTest::mousePress(m_tool, Qt::LeftButton, Qt::NoModifier, area.topLeft());
+        QTest::mouseMove(m_tool, area.bottomRight());
+        QTest::mouseRelease(m_tool, Qt::LeftButton, Qt::NoModifier, area.bottomRight());
+        m_tool->setTool(ScreenshotToolType::Rect);
+        QRandomGenerator rng(42);
+        for (int i = 0; i < 40; ++i) {
+            const QPoint a(area.left() + 10 + rng.bounded(area.width() - 80), area.top() + 10 + rng.bounded(area.height() - 80));
+            const QPoint b = a + QPoint(20 + rng.bounded(50), 20 + rng.bounded(50));
+            QTest::mousePress(m_tool, Qt::LeftButton, Qt::NoModifier, a);
+            QTest::mouseMove(m_tool, b);
+            QTest::mouseRelease(m_tool, Qt::LeftButton, Qt::NoModifier, b);
+        }
+        QCoreApplication::processEvents();
+
+        m_center = area.center();
+        m_radius = std::min(area.width(), area.height()) / 3;
+        m_tool->setTool(ScreenshotToolType::Pen);
+        QTest::mousePress(m_tool, Qt::LeftButton, Qt::NoModifier, strokePoint(0));
+        QCoreApplication::processEvents();
+        m_meter.paintedArea = 0;
+        m_meter.frames = 0;
+        m_tool->installEventFilter(&m_meter);
+        m_step = 0;
+    }
+
+    void cleanup() {
+        QPointer<ScreenshotTool> tool = m_tool;
+        if (tool) {
+            tool->removeEventFilter(&m_meter);
+            QTest::mouseRelease(tool, Qt::LeftButton, Qt::NoModifier, strokePoint(m_step));
+            tool->cancel();
+        }
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        m_tool = nullptr;
+    }
+
+    void penStrokeDirtyRegion() {
+        QBENCHMARK { frame(false); }
+        report();
+    }
+
+    void penStrokeFullRepaint() {
+        QBENCHMARK { frame(true); }
+        report();
+    }
+
+private:
+    QPoint strokePoint(int step) const {
+        const qreal angle = step * 0.05;
+        return m_center + QPoint(qRound(m_radius * qCos(angle)), qRound(m_radius * qSin(angle * 1.3)));
+    }
+
+    void frame(bool fullRepaint) {
+        QTest::mouseMove(m_tool, strokePoint(++m_step));
+        if (fullRepaint) m_tool->update();
+        QCoreApplication::processEvents();
+    }
+
+    void report() {
+        QVERIFY(m_meter.frames > 0);
+        const qint64 full = qint64(m_tool->width()) * m_tool->height();
+        qDebug().noquote() << QString("平均每帧重绘 %1% 屏幕面积 (%2 帧)")
+                                  .arg(100.0 * m_meter.paintedArea / m_meter.frames / full, 0, 'f', 1)
+                                  .arg(m_meter.frames);
+    }
+
+    ScreenshotTool* m_tool = nullptr;
+    PaintMeter m_meter;
+    QVariant m_savedTool;
+    QPoint m_center;
+    int m_radius = 0;
+    int m_step = 0;
+};
+
+RAPIDNOTES_TEST(BenchScreenshotFrame)
+#include "bench_screenshotframe.moc"
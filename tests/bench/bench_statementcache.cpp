@@ -0,0 +1,120 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include <QDateTime>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+namespace {
+// 与 DatabaseManager 中对应调用的 SQL 文本逐字一致
+const QString kSelectById = "SELECT * FROM notes WHERE id = :id";
+const QString kUpdateRating = "UPDATE notes SET rating = :val, updated_at = :now, last_accessed_at = :now WHERE id = :id";
+const QString kDedupeLookup = "SELECT id, category_id, tags FROM notes WHERE content_hash = :hash AND is_deleted = 0 LIMIT 1";
+}
+
+// 热点语句的单次调用延迟：经 cachedQuery 复用预编译语句 vs 每次调用重新 prepare
+class BenchStatementCache : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+        auto& db = DatabaseManager::instance();
+        m_noteId = db.addNote("statement cache bench", "statement cache bench content", {"bench"});
+        QVERIFY(m_noteId > 0);
+        m_contentHash = db.getNoteById(m_noteId).value("content_hash").toString();
+        QVERIFY(!m_contentHash.isEmpty());
+    }
+
+    void perCall_data() {
+        QTest::addColumn<QString>("sql");
+        QTest::newRow("getNoteById") << kSelectById;
+        QTest::newRow("updateNoteState") << kUpdateRating;
+        QTest::newRow("addNote dedupe lookup") << kDedupeLookup;
+    }
+
+    // 经 cachedQuery 的公开接口 (getNoteById / updateNoteState / addNote 重复内容)；输出本轮语句缓存命中率
+    void viaCachedQuery_data() { perCall_data(); }
+    void viaCachedQuery() {
+        QFETCH(QString, sql);
+        auto& db = DatabaseManager::instance();
+        const QVariantMap before = db.statementCacheStats();
+        int rating = 0;
+        QBENCHMARK {
+            if (sql == kSelectById) {
+                QCOMPARE(db.getNoteById(m_noteId).value("id").toInt(), m_noteId);
+            } else if (sql == kUpdateRating) {
+                QVERIFY(db.updateNoteState(m_noteId, "rating", ++rating % 6));
+            } else {
+                // 内容相同 -> 命中查重分支，返回已有笔记 ID
+                QCOMPARE(db.addNote("statement cache bench", "statement cache bench content", {"bench"}), m_noteId);
+            }
+        }
+        reportHitRate(before, db.statementCacheStats());
+    }
+
+    // 对照组：同样的 SQL，每次调用新建 QSqlQuery 并 prepare (改造前的写法)
+    void freshPrepare_data() { perCall_data(); }
+    void freshPrepare() {
+        QFETCH(QString, sql);
+        const QSqlDatabase conn = TestDatabase::connection();
+        int rating = 0;
+        QBENCHMARK {
+            QSqlQuery query(conn);
+            QVERIFY(query.prepare(sql));
+            bindFor(query, sql, ++rating % 6);
+            QVERIFY(query.exec());
+            if (sql == kSelectById) {
+                QVERIFY(query.next());
+                QVariantMap map;
+                const QSqlRecord rec = query.record();
+                for (int i = 0; i < rec.count(); ++i) map[rec.fieldName(i).toLower()] = query.value(i);
+                QCOMPARE(map.value("id").toInt(), m_noteId);
+            } else if (sql == kDedupeLookup) {
+                QVERIFY(query.next());
+                QCOMPARE(query.value(0).toInt(), m_noteId);
+            }
+        }
+    }
+
+    // 语句层面的纯复用开销 (cachedQuery 交出的就是这样一条常驻语句)：只 bind + exec，不含接口内的其余逻辑
+    void reusedStatement_data() { perCall_data(); }
+    void reusedStatement() {
+        QFETCH(QString, sql);
+        QSqlQuery query(TestDatabase::connection());
+        QVERIFY(query.prepare(sql));
+        int rating = 0;
+        QBENCHMARK {
+            bindFor(query, sql, ++rating % 6);
+            QVERIFY(query.exec());
+            if (sql != kUpdateRating) QVERIFY(query.next());
+            query.finish();
+        }
+    }
+
+private:
+    void bindFor(QSqlQuery& query, const QString& sql, int rating) const {
+        if (sql == kDedupeLookup) {
+            query.bindValue(":hash", m_contentHash);
+            return;
+        }
+        if (sql == kUpdateRating) {
+            query.bindValue(":val", rating);
+            query.bindValue(":now", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+        }
+        query.bindValue(":id", m_noteId);
+    }
+
+    static void reportHitRate(const QVariantMap& before, const QVariantMap& after) {
+        const quint64 hits = after.value("hits").toULongLong() - before.value("hits").toULongLong();
+        const quint64 misses = after.value("misses").toULongLong() - before.value("misses").toULongLong();
+        const quint64 total = hits + misses;
+        qInfo().nospace() << QTest::currentDataTag() << ": 语句缓存命中 " << hits << " / 未命中 " << misses
+                          << "，命中率 " << (total ? 100.0 * hits / total : 0.0) << "%"
+                          << " (累计命中率 " << after.value("hitRate").toDouble() << ")";
+    }
+
+    int m_noteId = 0;
+    QString m_contentHash;
+};
+
+RAPIDNOTES_TEST(BenchStatementCache)
+#include "bench_statementcache.moc"
@@ -0,0 +1,67 @@
+#include "TestRegistry.h"
+#include "ui/AdvancedTagSelector.h"
+#include <QLineEdit>
+#include <QPointer>
+
+namespace {
+QStringList makeTags(int count) {
+    static const char* const prefixes[] = {"project", "design", "reading", "meeting", "research"};
+    QStringList tags;
+    tags.reserve(count);
+    for (int i = 0; i < count; ++i) tags << QString("%1-%2").arg(prefixes[i % 5]).arg(i);
+    return tags;
+}
+}
+
+class BenchTagSelector : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        const QStringList tags = makeTags(kTagCount);
+        QList<QVariantMap> recent;
+        recent.reserve(tags.size());
+        for (int i = 0; i < tags.size(); ++i) recent << QVariantMap{{"name", tags[i]}, {"count", kTagCount - i}};
+
+        // 选择器隐藏时会 deleteLater 自身，因此放在堆上并用 QPointer 持有
+        m_selector = new AdvancedTagSelector;
+        m_selector->setup(recent, tags, {tags[3], tags[42]});
+        m_selector->show();
+        QVERIFY(QTest::qWaitForWindowExposed(m_selector));
+        m_search = m_selector->findChild<QLineEdit*>();
+        QVERIFY(m_search);
+    }
+
+    void cleanupTestCase() {
+        if (m_selector) m_selector->hide();
+    }
+
+    // 5,000 个标签下逐字输入再清空：每次按键刷新列表并完成排版 (芯片首次出现后复用)
+    void typing_data() {
+        QTest::addColumn<QString>("query");
+        QTest::newRow("broad (1/5 match)") << QString("project");
+        QTest::newRow("narrow") << QString("design-42");
+        QTest::newRow("no match") << QString("zzz");
+    }
+
+    void typing() {
+        QFETCH(QString, query);
+        QBENCHMARK {
+            for (int i = 1; i <= query.size(); ++i) typeText(query.left(i));
+            typeText(QString());
+        }
+    }
+
+private:
+    static constexpr int kTagCount = 5000;
+
+    void typeText(const QString& text) {
+        m_search->setText(text);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    }
+
+    QPointer<AdvancedTagSelector> m_selector;
+    QLineEdit* m_search = nullptr;
+};
+
+RAPIDNOTES_TEST(BenchTagSelector)
+#include "bench_tagselector.moc"
@@ -0,0 +1,104 @@
+#include "TestRegistry.h"
+#include "core/TesseractWorkerPool.h"
+#include <QElapsedTimer>
+#include <QPainter>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace {
+// 白底黑字的文本行图片 (类截图)，尺寸接近分块识别的单块
+QList<QImage> makePages(int count) {
+    QList<QImage> pages;
+    for (int i = 0; i < count; ++i) {
+        QImage page(1200, 400, QImage::Format_Grayscale8);
+        page.fill(Qt::white);
+        QPainter p(&page);
+        QFont font("Arial");
+        font.setPixelSize(36);
+        p.setFont(font);
+        p.setPen(Qt::black);
+        for (int line = 0; line < 4; ++line) {
+            p.drawText(40, 80 + line * 80, QString("RapidNotes batch page %1 line %2").arg(i).arg(line));
+        }
+        pages << page;
+    }
+    return pages;
+}
+}
+
+class BenchTesseractBatch : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        m_pool = std::make_unique<TesseractWorkerPool>(1);
+        if (!m_pool->isAvailable()) QSKIP("未找到 Tesseract，跳过识别延迟测量");
+        m_language = m_pool->resolveLanguage("eng");
+        m_pages = makePages(kPageCount);
+    }
+
+    // 每张图新建工作者池：旧版每次识别启动 tesseract 进程 / 重新加载语言模型的代价
+    void freshEnginePerImage() {
+        const std::atomic<bool> cancelled{false};
+        QList<qint64> latencies;
+        for (const QImage& page : std::as_const(m_pages)) {
+            QElapsedTimer timer;
+            timer.start();
+            TesseractWorkerPool fresh(1);
+            bool ok = false;
+            fresh.recognize(page, m_language, cancelled, &ok);
+            latencies << timer.nsecsElapsed();
+            QVERIFY(ok);
+        }
+        reportPerImage(latencies);
+    }
+
+    // 常驻工作者池逐张识别 (OCRManager 的单图路径)；libtesseract 构建下语言模型只加载一次
+    void persistentPoolPerImage() {
+        const std::atomic<bool> cancelled{false};
+        QList<qint64> latencies;
+        for (const QImage& page : std::as_const(m_pages)) {
+            QElapsedTimer timer;
+            timer.start();
+            bool ok = false;
+            m_pool->recognize(page, m_language, cancelled, &ok);
+            latencies << timer.nsecsElapsed();
+            QVERIFY(ok);
+        }
+        reportPerImage(latencies);
+    }
+
+    // 批量识别：命令行模式下整批只启动一个进程；按整批耗时 / 张数折算单张延迟
+    void batchRecognize() {
+        const std::atomic<bool> cancelled{false};
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = false;
+        const QStringList texts = m_pool->recognizeBatch(m_pages, m_language, cancelled, &ok);
+        const qint64 elapsed = timer.nsecsElapsed();
+        QVERIFY(ok);
+        QCOMPARE(texts.size(), m_pages.size());
+        for (int i = 0; i < texts.size(); ++i) QVERIFY2(texts[i].contains(QString("page %1").arg(i)), qPrintable(texts[i]));
+        QTest::setBenchmarkResult(elapsed / 1e6 / m_pages.size(), QTest::WalltimeMilliseconds);
+    }
+
+private:
+    static constexpr int kPageCount = 100;
+
+    // 结果为单张平均延迟 (ms)；另输出中位数与 P95，便于看出首张加载模型的长尾
+    static void reportPerImage(QList<qint64> latencies) {
+        std::sort(latencies.begin(), latencies.end());
+        const double total = std::accumulate(latencies.cbegin(), latencies.cend(), 0.0);
+        qInfo().nospace() << QTest::currentTestFunction() << ": " << latencies.size() << " 张，单张平均 "
+                          << total / 1e6 / latencies.size() << " ms，中位数 " << latencies[latencies.size() / 2] / 1e6
+                          << " ms，P95 " << latencies[latencies.size() * 95 / 100] / 1e6 << " ms";
+        QTest::setBenchmarkResult(total / 1e6 / latencies.size(), QTest::WalltimeMilliseconds);
+    }
+
+    std::unique_ptr<TesseractWorkerPool> m_pool;
+    QString m_language;
+    QList<QImage> m_pages;
+};
+
+RAPIDNOTES_TEST(BenchTesseractBatch)
+#include "bench_tesseractbatch.moc"
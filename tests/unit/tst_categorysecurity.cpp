@@ -0,0 +1,107 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include <QSet>
+#include <QUuid>
+
+// 分类快照缓存后，锁定分类的可见性语义必须与逐次查表时一致，且每次上锁/解锁/改密都立即生效
+class TestCategorySecurity : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+    }
+
+    void init() {
+        DatabaseManager& db = DatabaseManager::instance();
+        const QString tag = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        m_keyword = tag;
+        m_catId = db.addCategory("Secret " + tag);
+        QVERIFY(m_catId > 0);
+        m_lockedNote = db.addNote("locked " + tag, "locked body " + tag, {}, "", m_catId);
+        m_plainNote = db.addNote("plain " + tag, "plain body " + tag, {}, "", -1);
+        QVERIFY(m_lockedNote > 0 && m_plainNote > 0);
+        QVERIFY(db.setCategoryPassword(m_catId, "pw", "hint"));
+    }
+
+    void cleanup() {
+        DatabaseManager::instance().lockAllCategories();
+    }
+
+    void lockedCategoryIsHiddenFromAllViews() {
+        DatabaseManager& db = DatabaseManager::instance();
+        QVERIFY(db.isCategoryLocked(m_catId));
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+        QCOMPARE(db.getNotesCount(m_keyword, "all"), 1);
+        // 直接打开分类本身由界面层负责密码校验，查询层不再额外过滤
+        QCOMPARE(visibleIds("category", m_catId), QSet<int>{m_lockedNote});
+    }
+
+    void unlockAndRelockTakeEffectImmediately() {
+        DatabaseManager& db = DatabaseManager::instance();
+        QVERIFY(!db.verifyCategoryPassword(m_catId, "wrong"));
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+
+        QVERIFY(db.verifyCategoryPassword(m_catId, "pw"));
+        QVERIFY(!db.isCategoryLocked(m_catId));
+        QCOMPARE(visibleIds("all"), (QSet<int>{m_plainNote, m_lockedNote}));
+
+        db.lockCategory(m_catId);
+        QVERIFY(db.isCategoryLocked(m_catId));
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+
+        db.unlockCategory(m_catId);
+        db.lockAllCategories();
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+    }
+
+    void removingPasswordUnhides() {
+        DatabaseManager& db = DatabaseManager::instance();
+        QVERIFY(db.removeCategoryPassword(m_catId));
+        QVERIFY(!db.isCategoryLocked(m_catId));
+        QCOMPARE(visibleIds("all"), (QSet<int>{m_plainNote, m_lockedNote}));
+
+        QVERIFY(db.setCategoryPassword(m_catId, "pw2", ""));
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+    }
+
+    // 分类进了回收站仍受保护：单独恢复出来的笔记不能借此绕过密码
+    void deletedCategoryStaysProtected() {
+        DatabaseManager& db = DatabaseManager::instance();
+        QVERIFY(db.softDeleteCategories({m_catId}));
+        QVERIFY(db.isCategoryLocked(m_catId));
+        QVERIFY(db.updateNoteState(m_lockedNote, "is_deleted", 0));
+        QCOMPARE(visibleIds("all"), QSet<int>{m_plainNote});
+
+        QVERIFY(db.verifyCategoryPassword(m_catId, "pw"));
+        QCOMPARE(visibleIds("all"), (QSet<int>{m_plainNote, m_lockedNote}));
+    }
+
+    // 按名查找只命中未删除分类，删除后同名请求创建新分类
+    void nameLookupIgnoresDeletedCategories() {
+        DatabaseManager& db = DatabaseManager::instance();
+        const QString name = "Secret " + m_keyword;
+        QCOMPARE(db.getOrCreateCategoryByName(name), m_catId);
+        QVERIFY(db.softDeleteCategories({m_catId}));
+        const int recreated = db.getOrCreateCategoryByName(name);
+        QVERIFY(recreated > 0);
+        QVERIFY(recreated != m_catId);
+        QVERIFY(!db.isCategoryLocked(recreated));
+        QCOMPARE(db.getOrCreateCategoryByName(name), recreated);
+    }
+
+private:
+    QSet<int> visibleIds(const QString& filterType, const QVariant& filterValue = -1) {
+        QSet<int> ids;
+        const QList<QVariantMap> notes = DatabaseManager::instance().searchNotes(m_keyword, filterType, filterValue);
+        for (const QVariantMap& note : notes) ids.insert(note.value("id").toInt());
+        return ids;
+    }
+
+    QString m_keyword;
+    int m_catId = -1;
+    int m_lockedNote = 0;
+    int m_plainNote = 0;
+};
+
+RAPIDNOTES_TEST(TestCategorySecurity)
+#include "tst_categorysecurity.moc"
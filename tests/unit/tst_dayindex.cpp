@@ -0,0 +1,135 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <algorithm>
+#include <functional>
+
+namespace {
+struct TracedSql {
+    QString sql;
+    QVariantList params;
+};
+
+// 截获一次调用中 DatabaseManager 实际 prepare 的 SQL 与参数
+QList<TracedSql> capture(const std::function<void()>& call) {
+    QList<TracedSql> traced;
+    auto& db = DatabaseManager::instance();
+    db.setSqlTraceHook([&traced](const QString& sql, const QVariantList& params) { traced.append({sql, params}); });
+    call();
+    db.setSqlTraceHook({});
+    return traced;
+}
+
+QString queryPlan(const TracedSql& traced, QString* error) {
+    QSqlQuery query(TestDatabase::connection());
+    query.prepare("EXPLAIN QUERY PLAN " + traced.sql);
+    for (int i = 0; i < traced.params.size(); ++i) query.bindValue(i, traced.params[i]);
+    if (!query.exec()) {
+        *error = query.lastError().text();
+        return QString();
+    }
+    QStringList plan;
+    while (query.next()) plan << query.value(3).toString();
+    return plan.join(" | ");
+}
+
+QVariantMap dayCriteria(const QString& key) {
+    return {{key, QStringList{"2026-03-01", "2026-03-02"}}};
+}
+}
+
+// 按天过滤/统计的谓词必须命中 (is_deleted, X_day) 索引；写成 date(col) = ? 会退化为全表扫描。
+// 检查对象是各接口实际生成的 SQL (经 setSqlTraceHook 截获)，而不是手写的等价语句
+class TestDayIndex : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+    }
+
+    void generatedSqlUsesDayIndexes_data() {
+        QTest::addColumn<QString>("call");
+        QTest::addColumn<int>("expectedStatements"); // 该调用中带按天条件的语句数
+
+        QTest::newRow("list today") << "count:today" << 1;
+        QTest::newRow("list yesterday") << "count:yesterday" << 1;
+        QTest::newRow("list recently_visited") << "count:recently_visited" << 1;
+        QTest::newRow("search today") << "search:today" << 1;
+        QTest::newRow("list date_create") << "count:date_create" << 1;
+        QTest::newRow("list date_update") << "count:date_update" << 1;
+        QTest::newRow("filter stats all") << "stats:all" << 2;        // 创建 / 修改日期分组
+        QTest::newRow("filter stats today") << "stats:today" << 7;    // 全部统计语句都带 created_day 条件
+        QTest::newRow("sidebar counts") << "counts" << 3;             // today / yesterday / recently_visited
+        QTest::newRow("todos by date") << "todos" << 1;
+    }
+
+    void generatedSqlUsesDayIndexes() {
+        QFETCH(QString, call);
+        QFETCH(int, expectedStatements);
+
+        auto& db = DatabaseManager::instance();
+        const QString kind = call.section(':', 0, 0);
+        const QString arg = call.section(':', 1);
+        const QList<TracedSql> traced = capture([&]() {
+            if (kind == "count") {
+                if (arg.startsWith("date_")) db.getNotesCount("", "all", -1, dayCriteria(arg));
+                else db.getNotesCount("", arg);
+            } else if (kind == "search") {
+                db.searchNotes("", arg, -1, 1, 20);
+            } else if (kind == "stats") {
+                db.getFilterStats("", arg);
+            } else if (kind == "counts") {
+                db.getCounts();
+            } else {
+                db.getTodosByDate(QDate::currentDate());
+            }
+        });
+        QVERIFY(!traced.isEmpty());
+
+        static const QRegularExpression legacyDate("date\\((created_at|updated_at|last_accessed_at|start_time)\\)");
+        static const QRegularExpression wherePredicate("\\b(\\w+_day) (=|IN) ");
+        static const QRegularExpression groupBy("GROUP BY (\\w+_day)");
+
+        int dayStatements = 0;
+        for (const TracedSql& t : traced) {
+            QVERIFY2(!legacyDate.match(t.sql).hasMatch(), qPrintable("按天条件退回了 date(...): " + t.sql));
+
+            QStringList expected;
+            QString table = "notes";
+            if (t.sql.contains("FROM todos")) {
+                // start_day = ? OR (... created_day = ?)：两个索引都要用上 (MULTI-INDEX OR)
+                table = "todos";
+                expected = {"start_day", "created_day"};
+            } else {
+                for (auto it = wherePredicate.globalMatch(t.sql); it.hasNext();) expected << it.next().captured(1);
+                if (expected.isEmpty()) {
+                    const QRegularExpressionMatch m = groupBy.match(t.sql);
+                    if (m.hasMatch()) expected << m.captured(1);
+                }
+            }
+            if (expected.isEmpty()) continue;
+            ++dayStatements;
+
+            QString error;
+            const QString plan = queryPlan(t, &error);
+            QVERIFY2(error.isEmpty(), qPrintable(error + " SQL: " + t.sql));
+            const QString context = plan + "\nSQL: " + t.sql;
+            if (table == "todos") {
+                for (const QString& column : std::as_const(expected)) {
+                    QVERIFY2(plan.contains("idx_todos_" + column), qPrintable(context));
+                }
+            } else {
+                const bool usesDayIndex = std::any_of(expected.cbegin(), expected.cend(),
+                    [&plan](const QString& column) { return plan.contains("idx_notes_" + column); });
+                QVERIFY2(usesDayIndex, qPrintable(context));
+            }
+            QVERIFY2(!plan.contains(QRegularExpression("SCAN (TABLE )?(notes|todos)(?! USING)")), qPrintable(context));
+        }
+        QCOMPARE(dayStatements, expectedStatements);
+    }
+};
+
+RAPIDNOTES_TEST(TestDayIndex)
+#include "tst_dayindex.moc"
@@ -0,0 +1,105 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include "ui/FloatingBall.h"
+#include <QEnterEvent>
+#include <QTimer>
+
+namespace {
+// 统计被观察对象收到的某类事件 (定时器唤醒 / 重绘)
+class EventCounter : public QObject {
+public:
+    explicit EventCounter(QEvent::Type type) : m_type(type) {}
+    int count = 0;
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (event->type() == m_type) ++count;
+        return QObject::eventFilter(watched, event);
+    }
+private:
+    QEvent::Type m_type;
+};
+
+int eventsDuring(QObject* object, QEvent::Type type, int ms) {
+    EventCounter counter(type);
+    object->installEventFilter(&counter);
+    QTest::qWait(ms);
+    object->removeEventFilter(&counter);
+    return counter.count;
+}
+}
+
+// 静止的悬浮球不持有运行中的定时器：悬停时以 60 帧驱动，离开并回到静止姿态后停表
+class TestFloatingBall : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+    }
+
+    void idleBallHasNoTimerWakeups() {
+        FloatingBall ball;
+        ball.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&ball));
+        QTimer* timer = animationTimer(&ball);
+        QVERIFY(timer);
+        QVERIFY(!timer->isActive());
+
+        // 同一观察窗口内同时统计定时器唤醒与重绘
+        const int windowMs = 2000;
+        EventCounter paints(QEvent::Paint);
+        ball.installEventFilter(&paints);
+        const int wakeups = eventsDuring(timer, QEvent::Timer, windowMs);
+        ball.removeEventFilter(&paints);
+        qInfo().noquote() << QString("静止悬浮球：定时器唤醒 %1 次/分钟，重绘 %2 次/分钟")
+                                 .arg(wakeups * 60000 / windowMs).arg(paints.count * 60000 / windowMs);
+        QVERIFY(!timer->isActive());
+        QCOMPARE(wakeups, 0);
+    }
+
+    void hoverAnimatesThenStops() {
+        FloatingBall ball;
+        ball.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&ball));
+        QTimer* timer = animationTimer(&ball);
+        QVERIFY(timer);
+
+        const QPointF center = QRectF(ball.rect()).center();
+        QEnterEvent enter(center, center, ball.mapToGlobal(center));
+        QCoreApplication::sendEvent(&ball, &enter);
+        QVERIFY(timer->isActive());
+        QCOMPARE(timer->interval(), FloatingBall::kAnimationIntervalMs);
+        const int activeWakeups = eventsDuring(timer, QEvent::Timer, 500);
+        QVERIFY2(activeWakeups > 500 / FloatingBall::kAnimationIntervalMs / 2, qPrintable(QString::number(activeWakeups)));
+
+        QEvent leave(QEvent::Leave);
+        QCoreApplication::sendEvent(&ball, &leave);
+        // 粒子消散、姿态缓动回静止后停表
+        QTRY_VERIFY_WITH_TIMEOUT(!timer->isActive(), 10000);
+        QCOMPARE(eventsDuring(timer, QEvent::Timer, 500), 0);
+    }
+
+    void hideStopsTimer() {
+        FloatingBall ball;
+        ball.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&ball));
+        QTimer* timer = animationTimer(&ball);
+        QVERIFY(timer);
+
+        const QPointF center = QRectF(ball.rect()).center();
+        QEnterEvent enter(center, center, ball.mapToGlobal(center));
+        QCoreApplication::sendEvent(&ball, &enter);
+        QVERIFY(timer->isActive());
+        ball.hide();
+        QVERIFY(!timer->isActive());
+    }
+
+private:
+    // 悬浮球只有一个子定时器，即动画节拍
+    static QTimer* animationTimer(FloatingBall* ball) {
+        const QList<QTimer*> timers = ball->findChildren<QTimer*>(Qt::FindDirectChildrenOnly);
+        return timers.size() == 1 ? timers.first() : nullptr;
+    }
+};
+
+RAPIDNOTES_TEST(TestFloatingBall)
+#include "tst_floatingball.moc"
@@ -0,0 +1,98 @@
+#include "TestRegistry.h"
+#include "TestDatabase.h"
+#include "models/NoteModel.h"
+#include <QAbstractItemModelTester>
+#include <QPersistentModelIndex>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <algorithm>
+
+namespace {
+QVariantMap makeNote(int id, int revision) {
+    QVariantMap note;
+    note["id"] = id;
+    note["title"] = QString("note %1 r%2").arg(id).arg(revision);
+    note["content"] = QString("body %1").arg(id);
+    note["item_type"] = "text";
+    return note;
+}
+
+// 从 1..pool 中随机抽取、乱序，并按概率给部分笔记换一个新修订号 (模拟内容被编辑)
+QList<QVariantMap> randomPage(QRandomGenerator& rng, int pool, int revision) {
+    QList<int> ids;
+    for (int id = 1; id <= pool; ++id) {
+        if (rng.bounded(3) != 0) ids << id;
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    QList<QVariantMap> page;
+    for (int id : ids) page << makeNote(id, rng.bounded(4) == 0 ? revision : 0);
+    return page;
+}
+
+QList<int> modelIds(const NoteModel& model) {
+    QList<int> ids;
+    for (int row = 0; row < model.rowCount(); ++row) ids << model.data(model.index(row, 0), NoteModel::IdRole).toInt();
+    return ids;
+}
+}
+
+// 增量比对必须与全量重置得到相同的结果，并且发出的插入/删除/移动信号让视图的持久索引跟着正确的笔记走
+class TestNoteModelDiff : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase() {
+        QVERIFY(TestDatabase::ensureInitialized());
+    }
+
+    void randomRefreshesMatchTarget() {
+        QRandomGenerator rng(20260340);
+        NoteModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        QSignalSpy resets(&model, &QAbstractItemModel::modelReset);
+
+        for (int round = 1; round <= 300; ++round) {
+            const QList<QVariantMap> page = randomPage(rng, 1 + rng.bounded(60), round);
+
+            QList<QPersistentModelIndex> tracked;
+            QList<int> trackedIds;
+            for (int row = 0; row < model.rowCount(); ++row) {
+                tracked << QPersistentModelIndex(model.index(row, 0));
+                trackedIds << model.data(tracked.last(), NoteModel::IdRole).toInt();
+            }
+
+            model.setNotes(page);
+            if (QTest::currentTestFailed()) return;
+
+            QList<int> expectedIds;
+            for (const QVariantMap& note : page) expectedIds << note.value("id").toInt();
+            QCOMPARE(modelIds(model), expectedIds);
+            for (int row = 0; row < page.size(); ++row) {
+                QCOMPARE(model.data(model.index(row, 0), NoteModel::TitleRole).toString(), page.at(row).value("title").toString());
+            }
+
+            // 仍在新列表中的笔记：持久索引指向同一 id；已移除的笔记：持久索引失效
+            for (int k = 0; k < tracked.size(); ++k) {
+                if (expectedIds.contains(trackedIds.at(k))) {
+                    QVERIFY(tracked.at(k).isValid());
+                    QCOMPARE(model.data(tracked.at(k), NoteModel::IdRole).toInt(), trackedIds.at(k));
+                } else {
+                    QVERIFY(!tracked.at(k).isValid());
+                }
+            }
+        }
+        QCOMPARE(resets.count(), 0);
+    }
+
+    // 重复 id 无法按 id 对齐，退回全量重置
+    void duplicateIdsFallBackToReset() {
+        NoteModel model;
+        model.setNotes({makeNote(1, 0), makeNote(2, 0)});
+        QSignalSpy resets(&model, &QAbstractItemModel::modelReset);
+        model.setNotes({makeNote(1, 0), makeNote(1, 1), makeNote(3, 0)});
+        QCOMPARE(resets.count(), 1);
+        QCOMPARE(modelIds(model), (QList<int>{1, 1, 3}));
+    }
+};
+
+RAPIDNOTES_TEST(TestNoteModelDiff)
+#include "tst_notemodeldiff.moc"
@@ -0,0 +1,62 @@
+#include "TestRegistry.h"
+#include "OcrPreprocessReference.h"
+#include "core/OCRManager.h"
+#include <cstring>
+
+class TestOcrPreprocess : public QObject {
+    Q_OBJECT
+private slots:
+    // 覆盖三档自动缩放 (3x / 2x / 1x)、4000 像素上限、深浅背景与常见输入格式
+    void matchesReferencePipeline_data() {
+        QTest::addColumn<QSize>("size");
+        QTest::addColumn<int>("format");
+        QTest::addColumn<bool>("dark");
+        QTest::addColumn<int>("fixedScale");
+
+        QTest::newRow("3x light rgb32") << QSize(420, 180) << int(QImage::Format_RGB32) << false << 0;
+        QTest::newRow("3x dark argb32") << QSize(640, 240) << int(QImage::Format_ARGB32) << true << 0;
+        QTest::newRow("3x light gray8") << QSize(333, 97) << int(QImage::Format_Grayscale8) << false << 0;
+        QTest::newRow("2x light rgb32") << QSize(1280, 720) << int(QImage::Format_RGB32) << false << 0;
+        QTest::newRow("2x dark rgb32") << QSize(1100, 640) << int(QImage::Format_RGB32) << true << 0;
+        QTest::newRow("1x light rgb32") << QSize(2400, 600) << int(QImage::Format_RGB32) << false << 0;
+        QTest::newRow("1x dark argb32") << QSize(800, 2200) << int(QImage::Format_ARGB32) << true << 0;
+        QTest::newRow("capped tile") << QSize(1500, 500) << int(QImage::Format_Grayscale8) << false << 3;
+        QTest::newRow("tiny") << QSize(3, 3) << int(QImage::Format_RGB32) << true << 0;
+    }
+
+    void matchesReferencePipeline() {
+        QFETCH(QSize, size);
+        QFETCH(int, format);
+        QFETCH(bool, dark);
+        QFETCH(int, fixedScale);
+
+        const QImage input = OcrPreprocessReference::sampleImage(size, QImage::Format(format), dark, 20260331);
+        const QImage expected = OcrPreprocessReference::run(input, fixedScale);
+        const QImage actual = OCRManager::preprocessImage(input, false, fixedScale);
+
+        QCOMPARE(actual.format(), QImage::Format_Grayscale8);
+        QCOMPARE(actual.size(), expected.size());
+        for (int y = 0; y < actual.height(); ++y) {
+            const uchar* a = actual.constScanLine(y);
+            const uchar* e = expected.constScanLine(y);
+            if (std::memcmp(a, e, size_t(actual.width())) == 0) continue;
+            int x = 0;
+            while (a[x] == e[x]) ++x;
+            QFAIL(qPrintable(QString("像素不一致 (%1, %2): 实际 %3 期望 %4").arg(x).arg(y).arg(a[x]).arg(e[x])));
+        }
+    }
+
+    // 缩放路径的输出必须仍是 8 位灰度 (平滑缩放会产出 32 位格式)
+    void scaledOutputIsGrayscale8() {
+        const QImage input = OcrPreprocessReference::sampleImage(QSize(200, 80), QImage::Format_Grayscale8, false, 7);
+        for (int scale : {2, 3}) {
+            const QImage out = OCRManager::preprocessImage(input, false, scale);
+            QCOMPARE(out.format(), QImage::Format_Grayscale8);
+            QCOMPARE(out.size(), input.size() * scale);
+        }
+        QCOMPARE(OCRManager::preprocessImage(input, true, 2).format(), QImage::Format_Grayscale8);
+    }
+};
+
+RAPIDNOTES_TEST(TestOcrPreprocess)
+#include "tst_ocrpreprocess.moc"
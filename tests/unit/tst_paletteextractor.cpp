@@ -0,0 +1,65 @@
+#include "TestRegistry.h"
+#include "core/PaletteExtractor.h"
+#include <QColor>
+#include <QRandomGenerator>
+#include <cstdlib>
+
+namespace {
+// 三个色带按 60% / 30% / 10% 面积排列，每个像素在基色上 ±jitter 抖动 (跨越 5 bit 量化格边界)
+QImage shadedImage(const QSize& size, int jitter, quint32 seed) {
+    const QColor bases[] = {QColor(200, 48, 56), QColor(40, 88, 200), QColor(64, 176, 72)};
+    QRandomGenerator rng(seed);
+    QImage image(size, QImage::Format_RGB32);
+    for (int y = 0; y < size.height(); ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        const int band = y < size.height() * 6 / 10 ? 0 : (y < size.height() * 9 / 10 ? 1 : 2);
+        const QColor& base = bases[band];
+        for (int x = 0; x < size.width(); ++x) {
+            auto shade = [&](int v) { return qBound(0, v + int(rng.bounded(2 * jitter + 1)) - jitter, 255); };
+            line[x] = qRgb(shade(base.red()), shade(base.green()), shade(base.blue()));
+        }
+    }
+    return image;
+}
+
+int rgbDiff(const QColor& a, const QColor& b) {
+    return std::abs(a.red() - b.red()) + std::abs(a.green() - b.green()) + std::abs(a.blue() - b.blue());
+}
+}
+
+class TestPaletteExtractor : public QObject {
+    Q_OBJECT
+private slots:
+    // 固定种子：同一张图片重复计算、跨缓存命中结果完全一致
+    void samePaletteForSameImage() {
+        const QImage image = shadedImage(QSize(640, 480), 12, 1);
+        const QStringList first = PaletteExtractor::compute(image, 24);
+        QVERIFY(!first.isEmpty());
+        QCOMPARE(PaletteExtractor::compute(image, 24), first);
+        QCOMPARE(PaletteExtractor::compute(image.copy(), 24), first);
+        QCOMPARE(PaletteExtractor::extract(image, 24), first);
+        QCOMPARE(PaletteExtractor::extract(image, 24), first);
+    }
+
+    // 相近色 (同一基色的抖动) 归入同一簇，只剩三种主色且按面积降序
+    void nearDuplicateShadesMerge() {
+        const QImage image = shadedImage(QSize(800, 600), 3, 2);
+        const QStringList palette = PaletteExtractor::compute(image, 8);
+        QCOMPARE(palette.size(), 3);
+        QVERIFY2(rgbDiff(QColor(palette[0]), QColor(200, 48, 56)) <= 9, qPrintable(palette.join(' ')));
+        QVERIFY2(rgbDiff(QColor(palette[1]), QColor(40, 88, 200)) <= 9, qPrintable(palette.join(' ')));
+        QVERIFY2(rgbDiff(QColor(palette[2]), QColor(64, 176, 72)) <= 9, qPrintable(palette.join(' ')));
+    }
+
+    // 小图 (少于一块) 与单行图片也能正常统计
+    void smallImages() {
+        QImage pixel(1, 1, QImage::Format_ARGB32);
+        pixel.fill(QColor(10, 20, 30));
+        QCOMPARE(PaletteExtractor::compute(pixel, 4), QStringList{"#0A141E"});
+        QCOMPARE(PaletteExtractor::compute(shadedImage(QSize(4096, 1), 3, 3), 8).size(), 1);
+        QVERIFY(PaletteExtractor::compute(QImage(), 8).isEmpty());
+    }
+};
+
+RAPIDNOTES_TEST(TestPaletteExtractor)
+#include "tst_paletteextractor.moc"
@@ -0,0 +1,89 @@
+#include "TestRegistry.h"
+#include "core/PixelRunTable.h"
+#include <QPainter>
+#include <QRandomGenerator>
+
+namespace {
+// 类界面截图：若干纯色块 + 小幅抖动 (容差内) + 少量离群噪点 (容差外)
+QImage sampleImage(const QSize& size, quint32 seed) {
+    QRandomGenerator rng(seed);
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(QColor(240, 240, 240));
+    QPainter p(&image);
+    for (int i = 0; i < 24; ++i) {
+        const QRect r(rng.bounded(size.width()), rng.bounded(size.height()),
+                      1 + rng.bounded(qMax(1, size.width() / 2)), 1 + rng.bounded(qMax(1, size.height() / 2)));
+        p.fillRect(r, QColor(rng.bounded(256), rng.bounded(256), rng.bounded(256)));
+    }
+    p.end();
+
+    for (int i = 0; i < size.width() * size.height() / 20; ++i) {
+        const int x = rng.bounded(size.width());
+        const int y = rng.bounded(size.height());
+        const QRgb c = image.pixel(x, y);
+        const int d = rng.bounded(2) ? 3 : 40;
+        image.setPixel(x, y, qRgb(qBound(0, qRed(c) + d, 255), qBound(0, qGreen(c) - d / 3, 255), qBlue(c)));
+    }
+    return image;
+}
+}
+
+class TestPixelRunTable : public QObject {
+    Q_OBJECT
+private slots:
+    // 游程表跳段查询必须与逐像素扫描逐点一致 (四个方向、多档容差)
+    void distanceMatchesScan_data() {
+        QTest::addColumn<QSize>("size");
+        QTest::addColumn<int>("format");
+        QTest::addColumn<quint32>("seed");
+
+        QTest::newRow("rgb32") << QSize(320, 200) << int(QImage::Format_RGB32) << quint32(1);
+        QTest::newRow("argb32") << QSize(257, 311) << int(QImage::Format_ARGB32) << quint32(2);
+        QTest::newRow("rgb888") << QSize(400, 90) << int(QImage::Format_RGB888) << quint32(3);
+        QTest::newRow("thin") << QSize(1, 64) << int(QImage::Format_RGB32) << quint32(4);
+    }
+
+    void distanceMatchesScan() {
+        QFETCH(QSize, size);
+        QFETCH(int, format);
+        QFETCH(quint32, seed);
+
+        const QImage image = sampleImage(size, seed).convertToFormat(QImage::Format(format));
+        const PixelRunTable rows = PixelRunTable::build(image, Qt::Horizontal);
+        const PixelRunTable columns = PixelRunTable::build(image, Qt::Vertical);
+        QVERIFY(!rows.isNull());
+        QVERIFY(!columns.isNull());
+
+        QRandomGenerator rng(seed * 7919);
+        for (int i = 0; i < 2000; ++i) {
+            const int x = rng.bounded(size.width());
+            const int y = rng.bounded(size.height());
+            for (int tolerance : {0, 10, 60}) {
+                for (int step : {-1, 1}) {
+                    const int horizontal = PixelRunTable::scan(image, x, y, step, 0, tolerance);
+                    const int vertical = PixelRunTable::scan(image, x, y, 0, step, tolerance);
+                    if (rows.distance(x, y, step, tolerance) != horizontal
+                        || columns.distance(x, y, step, tolerance) != vertical) {
+                        QFAIL(qPrintable(QString("(%1, %2) step %3 容差 %4: 行 %5/%6 列 %7/%8")
+                            .arg(x).arg(y).arg(step).arg(tolerance)
+                            .arg(rows.distance(x, y, step, tolerance)).arg(horizontal)
+                            .arg(columns.distance(x, y, step, tolerance)).arg(vertical)));
+                    }
+                }
+            }
+        }
+    }
+
+    // 越界坐标与空表返回 0，与扫描一致
+    void outOfBoundsIsZero() {
+        const QImage image = sampleImage(QSize(32, 32), 5);
+        const PixelRunTable rows = PixelRunTable::build(image, Qt::Horizontal);
+        QCOMPARE(rows.distance(-1, 0, 1, 10), 0);
+        QCOMPARE(rows.distance(32, 5, -1, 10), 0);
+        QCOMPARE(PixelRunTable::scan(image, 0, 32, 0, -1, 10), 0);
+        QCOMPARE(PixelRunTable().distance(0, 0, 1, 10), 0);
+    }
+};
+
+RAPIDNOTES_TEST(TestPixelRunTable)
+#include "tst_pixelruntable.moc"
@@ -0,0 +1,191 @@
+#include "TestRegistry.h"
+#include "core/ReplaceEngine.h"
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QSet>
+#include <QTemporaryDir>
+#include <memory>
+
+namespace {
+void writeFile(const QString& path, const QByteArray& data) {
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(f.write(data), qint64(data.size()));
+}
+
+QByteArray readFile(const QString& path) {
+    QFile f(path);
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
+QList<QJsonObject> readJournal(const QString& backupDir) {
+    QList<QJsonObject> entries;
+    QFile f(ReplaceEngine::journalPath(backupDir));
+    if (!f.open(QIODevice::ReadOnly)) return entries;
+    while (!f.atEnd()) entries << QJsonDocument::fromJson(f.readLine()).object();
+    return entries;
+}
+}
+
+class TestReplaceEngine : public QObject {
+    Q_OBJECT
+private slots:
+    void init() {
+        m_root.reset(new QTemporaryDir);
+        QVERIFY(m_root->isValid());
+    }
+
+    // 内容完全相同的文件哈希相同：整次替换只写一份 blob，且每个文件都能各自撤销
+    void identicalFilesShareOneBlob() {
+        const QByteArray content = QByteArray("prefix foo suffix\n").repeated(16 * 1024);
+        for (int i = 0; i < kFileCount; ++i) writeFile(path(i), content);
+
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{kFileCount, 0}));
+        QCOMPARE(QDir(backupDir + "/blobs").entryList(QDir::Files).size(), 1);
+        for (int i = 0; i < kFileCount; ++i) QVERIFY(!readFile(path(i)).contains("foo"));
+
+        QSet<QString> oldHashes;
+        for (const QJsonObject& e : readJournal(backupDir)) {
+            if (e.value("op").toString() == "write") oldHashes.insert(e.value("old").toString());
+        }
+        QCOMPARE(oldHashes.size(), 1);
+
+        QCOMPARE(runUndo(backupDir), (QList<int>{kFileCount, 0, 0}));
+        for (int i = 0; i < kFileCount; ++i) QCOMPARE(readFile(path(i)), content);
+    }
+
+    // blob 内容与文件名哈希不符 (损坏或碰撞) 时拒绝恢复，目标文件保持替换后的内容
+    void mismatchedBlobIsNotRestored() {
+        writeFile(path(0), "foo one\n");
+        writeFile(path(1), "foo two\n");
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{2, 0}));
+
+        const QStringList blobs = QDir(backupDir + "/blobs").entryList(QDir::Files);
+        QCOMPARE(blobs.size(), 2);
+        for (const QString& name : blobs) writeFile(backupDir + "/blobs/" + name, "not the original\n");
+
+        QCOMPARE(runUndo(backupDir), (QList<int>{0, 0, 2}));
+        QCOMPARE(readFile(path(0)), QByteArray("bar one\n"));
+        QCOMPARE(readFile(path(1)), QByteArray("bar two\n"));
+    }
+
+    // 模拟替换中途崩溃：日志只有 write 记录，没有 commit / end，最后一个文件尚未被改写
+    void interruptedReplaceCanBeUndone() {
+        QList<QByteArray> originals;
+        for (int i = 0; i < 3; ++i) {
+            originals << QByteArray("line foo ") + QByteArray::number(i) + "\n";
+            writeFile(path(i), originals.last());
+        }
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{3, 0}));
+
+        QList<QByteArray> kept;
+        QFile journal(ReplaceEngine::journalPath(backupDir));
+        QVERIFY(journal.open(QIODevice::ReadOnly));
+        while (!journal.atEnd()) {
+            const QByteArray line = journal.readLine();
+            const QString op = QJsonDocument::fromJson(line).object().value("op").toString();
+            if (op != "commit" && op != "end") kept << line;
+        }
+        journal.close();
+        QVERIFY(journal.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        for (const QByteArray& line : kept) journal.write(line);
+        journal.close();
+        writeFile(path(2), originals[2]);
+
+        QCOMPARE(runUndo(backupDir), (QList<int>{2, 1, 0}));
+        for (int i = 0; i < 3; ++i) QCOMPARE(readFile(path(i)), originals[i]);
+    }
+
+    // 撤销中途中断后重跑：已恢复的文件按 old 哈希识别为跳过，其余照常恢复
+    void interruptedUndoCanBeResumed() {
+        writeFile(path(0), "foo a\n");
+        writeFile(path(1), "foo b\n");
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{2, 0}));
+
+        writeFile(path(0), "foo a\n");
+        QCOMPARE(runUndo(backupDir), (QList<int>{1, 1, 0}));
+        QCOMPARE(runUndo(backupDir), (QList<int>{0, 2, 0}));
+        QCOMPARE(readFile(path(0)), QByteArray("foo a\n"));
+        QCOMPARE(readFile(path(1)), QByteArray("foo b\n"));
+    }
+
+    // 替换后又被外部修改的文件不覆盖
+    void externallyModifiedFileIsSkipped() {
+        writeFile(path(0), "foo\n");
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{1, 0}));
+        writeFile(path(0), "edited by user\n");
+
+        QCOMPARE(runUndo(backupDir), (QList<int>{0, 0, 1}));
+        QCOMPARE(readFile(path(0)), QByteArray("edited by user\n"));
+    }
+
+    // 不同子目录下的同名文件各自备份、按完整路径恢复，内容不会互相串用
+    void sameNameInSubfoldersRestoreByPath() {
+        const QString a = m_root->filePath("a/config.json");
+        const QString b = m_root->filePath("b/config.json");
+        const QString nested = m_root->filePath("a/nested/config.json");
+        QVERIFY(QDir().mkpath(m_root->filePath("a/nested")));
+        QVERIFY(QDir().mkpath(m_root->filePath("b")));
+        const QByteArray contentA = "{ \"name\": \"foo-a\", \"port\": 8080 }\n";
+        const QByteArray contentB = "{ \"name\": \"foo-b\", \"debug\": true }\n";
+        const QByteArray contentNested = "{ \"foo\": [1, 2, 3] }\n";
+        writeFile(a, contentA);
+        writeFile(b, contentB);
+        writeFile(nested, contentNested);
+
+        QString backupDir;
+        QCOMPARE(runReplace(&backupDir), (QList<int>{3, 0}));
+        QCOMPARE(readFile(a), QByteArray("{ \"name\": \"bar-a\", \"port\": 8080 }\n"));
+        QCOMPARE(readFile(b), QByteArray("{ \"name\": \"bar-b\", \"debug\": true }\n"));
+        QCOMPARE(QDir(backupDir + "/blobs").entryList(QDir::Files).size(), 3);
+
+        QCOMPARE(runUndo(backupDir), (QList<int>{3, 0, 0}));
+        QCOMPARE(readFile(a), contentA);
+        QCOMPARE(readFile(b), contentB);
+        QCOMPARE(readFile(nested), contentNested);
+    }
+
+private:
+    static constexpr int kFileCount = 24;
+
+    QString path(int i) const { return m_root->filePath(QString("file_%1.txt").arg(i)); }
+
+    // 返回 {modified, failed}；超时返回 {-1, -1}
+    QList<int> runReplace(QString* backupDir) {
+        ReplaceEngine engine;
+        QSignalSpy spy(&engine, &ReplaceEngine::replaceFinished);
+        ReplaceEngine::Options options;
+        options.rootDir = m_root->path();
+        options.keyword = "foo";
+        options.replaceText = "bar";
+        options.caseSensitive = true;
+        engine.start(options);
+        if (!spy.wait(30000)) return {-1, -1};
+        const QList<QVariant> args = spy.takeFirst();
+        *backupDir = args.at(2).toString();
+        return {args.at(0).toInt(), args.at(1).toInt()};
+    }
+
+    // 返回 {restored, skipped, conflicts}；超时返回 {-1, -1, -1}
+    QList<int> runUndo(const QString& backupDir) {
+        ReplaceEngine engine;
+        QSignalSpy spy(&engine, &ReplaceEngine::undoFinished);
+        engine.undo(backupDir);
+        if (!spy.wait(30000)) return {-1, -1, -1};
+        const QList<QVariant> args = spy.takeFirst();
+        return {args.at(0).toInt(), args.at(1).toInt(), args.at(2).toInt()};
+    }
+
+    std::unique_ptr<QTemporaryDir> m_root;
+};
+
+RAPIDNOTES_TEST(TestReplaceEngine)
+#include "tst_replaceengine.moc"